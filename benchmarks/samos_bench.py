@@ -0,0 +1,368 @@
+# ***************************************************************************
+# *
+# *  Copyright (C) 2013-2016 University of Dundee
+# *  All rights reserved.
+# *
+# *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+# *
+# *  SAMoS is free software; you can redistribute it and/or modify
+# *  it under the terms of the GNU General Public License as published by
+# *  the Free Software Foundation; either version 2 of the License, or
+# *  (at your option) any later version.
+# *
+# *  SAMoS is distributed in the hope that it will be useful,
+# *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+# *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# *  GNU General Public License for more details.
+# *
+# *  You should have received a copy of the GNU General Public License
+# *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+# *
+# *****************************************************************************
+
+# Benchmark suite for SAMoS.
+# For each of the shipped example configurations (soft_on_sphere, lj_langevin, vicsek_on_plane,
+# rods_on_plane, cells_fixed, filaments_on_plane and growth) this script generates a system with
+# the same density and the same interactions as the example, but with N particles, runs it for a
+# fixed number of steps and collects the run statistics that SAMoS stores under "run.stats" in the
+# configuration file (time per particle-step broken down by parts of the code, number of neighbour
+# list builds and peak memory use). Results are written in JSON (default) or CSV format.
+# Dumps and logs are switched off, so the numbers measure the simulation itself.
+#
+# Usage: python samos_bench.py --samos /path/to/samos [--sizes 1000,10000] [--cases lj_langevin,growth]
+
+from __future__ import print_function
+
+import os
+import sys
+import json
+import math
+import random
+import platform
+import argparse
+import subprocess
+from datetime import datetime
+
+# Number of steps per case. Tissue cases are more expensive per step (triangulation), so they run shorter.
+STEPS = { 'soft_on_sphere'     : 1000,
+          'lj_langevin'        : 1000,
+          'vicsek_on_plane'    : 1000,
+          'rods_on_plane'      : 1000,
+          'cells_fixed'        : 200,
+          'filaments_on_plane' : 1000,
+          'growth'             : 200 }
+
+CASES = ['soft_on_sphere', 'lj_langevin', 'vicsek_on_plane', 'rods_on_plane', 'cells_fixed', 'filaments_on_plane', 'growth']
+
+def random_direction():
+  phi = random.uniform(0.0, 2.0*math.pi)
+  return math.cos(phi), math.sin(phi)
+
+def planar_lattice(N, density):
+  """Returns box size and N points on a jittered square lattice with given density (points are centred at the origin)."""
+  L = math.sqrt(N/density)
+  n = int(math.ceil(math.sqrt(N)))
+  a = L/n
+  pts = []
+  for i in range(n):
+    for j in range(n):
+      if len(pts) == N:
+        return L, pts
+      x = -0.5*L + (i + 0.5 + random.uniform(-0.1, 0.1))*a
+      y = -0.5*L + (j + 0.5 + random.uniform(-0.1, 0.1))*a
+      pts.append((x, y))
+  return L, pts
+
+def write_conf(name, lines):
+  with open(name, 'w') as out:
+    out.write('\n'.join(lines) + '\n')
+
+def header(f, N, keys=None):
+  f.write('# Total of %d particles\n' % N)
+  f.write('# Generated on : %s by samos_bench.py\n' % str(datetime.now()))
+  if keys != None:
+    f.write('keys: ' + '  '.join(keys) + '\n')
+
+def soft_on_sphere(N, steps):
+  # Same surface density as configurations/soft_on_sphere (316 particles on a sphere of radius 10)
+  R = math.sqrt(N/(4.0*math.pi*316.0/(4.0*math.pi*100.0)))
+  golden = math.pi*(3.0 - math.sqrt(5.0))
+  with open('sphere.dat', 'w') as f:
+    header(f, N, ['id', 'type', 'radius', 'x', 'y', 'z', 'vx', 'vy', 'vz', 'nx', 'ny', 'nz'])
+    for i in range(N):
+      z = 1.0 - 2.0*(i + 0.5)/N
+      r = math.sqrt(1.0 - z*z)
+      x, y = r*math.cos(golden*i), r*math.sin(golden*i)
+      # director tangent to the sphere
+      tx, ty = (-y/r, x/r) if r > 1e-6 else (1.0, 0.0)
+      f.write('%d  1  0.50 %f %f %f 0.0 0.0 0.0 %f %f 0.0\n' % (i, R*x, R*y, R*z, tx, ty))
+  L = 3.0*R
+  write_conf('bench.conf', ['messages messages.msg',
+                            'config bench { type = json }',
+                            'box fixed { lx = %f;  ly = %f;  lz = %f }' % (L, L, L),
+                            'input sphere.dat',
+                            'nlist { rcut = 2.4; pad = 0.5 }',
+                            'constraint sphere { r = %f }' % R,
+                            'pair_potential soft { k = 10.0; a = 1.0 }',
+                            'pair_align polar { J = 1.0 }',
+                            'external self_propulsion { alpha = 1.0 }',
+                            'timestep 0.01',
+                            'integrator brownian_pos { seed = 0; mu = 1.0;  temperature_control = constant; min_val = 0.1 }',
+                            'integrator brownian_align { seed = 0; nu = 0.01;  }',
+                            'run %d' % steps])
+
+def lj_langevin(N, steps):
+  # Same density as configurations/lj_langevin (300 particles in a 100x100 box)
+  L, pts = planar_lattice(N, 300.0/(100.0*100.0))
+  with open('particles.dat', 'w') as f:
+    header(f, N, ['id', 'x', 'y', 'nx', 'ny', 'vx', 'vy'])
+    for i, (x, y) in enumerate(pts):
+      nx, ny = random_direction()
+      vx, vy = random_direction()
+      f.write('%d %f %f %f %f %f %f\n' % (i, x, y, nx, ny, vx, vy))
+  write_conf('bench.conf', ['messages messages.msg',
+                            'config bench { type = json }',
+                            'box periodic { lx = %f;  ly = %f;  lz = 10.0 }' % (L, L),
+                            'input particles.dat',
+                            'nlist { rcut = 3.0; pad = 0.5 }',
+                            'constraint plane {  }',
+                            'pair_potential lj { epsilon = 1.0; sigma = 1.0; rcut = 2.5; shifted }',
+                            'integrator langevin { dt=0.001; seed = 1;  gamma = 1.0; min_val=2.4; temperature_control = constant; group = all }',
+                            'run %d' % steps])
+
+def plane_particles(N, density, length=None):
+  """Writes plane.dat in the format used by vicsek_on_plane and rods_on_plane examples. Returns box size."""
+  L, pts = planar_lattice(N, density)
+  with open('plane.dat', 'w') as f:
+    header(f, N)
+    f.write('# id  type radius  x   y   z   vx   vy   vz   nx   ny   nz  omega' + ('  l' if length != None else '') + '\n')
+    for i, (x, y) in enumerate(pts):
+      nx, ny = random_direction()
+      line = '%d  1  1.000000 %f  %f  0.000000  %f  %f  0.000000  %f  %f  0.000000  0.000000' % (i, x, y, nx, ny, nx, ny)
+      if length != None:
+        line += '  %f' % length
+      f.write(line + '\n')
+  return L
+
+def vicsek_on_plane(N, steps):
+  # Same density as configurations/vicsek_on_plane (3577 particles in a 106x106 box)
+  L = plane_particles(N, 3577.0/(106.0*106.0))
+  write_conf('bench.conf', ['messages messages.msg',
+                            'config bench { type = json }',
+                            'box periodic { lx = %f;  ly = %f;  lz = 10.0 }' % (L, L),
+                            'input plane.dat',
+                            'nlist { rcut = 1.5; pad = 0.5 }',
+                            'constraint plane { lx = %f; ly = %f }' % (L, L),
+                            'pair_align vicsek { rcut = 1.0 }',
+                            'integrator vicsek { dt=0.01; seed = 37;  eta = 1.0; mu = 1.0;  v0 = 0.5 }',
+                            'run %d' % steps])
+
+def rods_on_plane(N, steps):
+  # Same density as configurations/rods_on_plane (3183 rods in a 100x100 box)
+  L = plane_particles(N, 3183.0/(100.0*100.0), 2.0)
+  write_conf('bench.conf', ['messages messages.msg',
+                            'config bench { type = json }',
+                            'box periodic { lx = %f;  ly = %f;  lz = 10.0 }' % (L, L),
+                            'input plane.dat',
+                            'nlist { rcut = 6.0; pad = 0.5 }',
+                            'constraint plane {  }',
+                            'pair_potential rod { k = 1.0 }',
+                            'integrator brownian { dt=0.001; seed = 1;  nu = 0.00; mu = 1.0; mur = 1.0; v0 = 1.0; group = all; tau = 1.0; nematic }',
+                            'run %d' % steps])
+
+def cell_patch(N, input_name, boundary_name, with_radius):
+  """Writes a circular patch of N cells (each with native area pi) surrounded by a ring of boundary particles.
+     Returns the patch radius."""
+  a = math.sqrt(2.0*math.pi/math.sqrt(3.0))    # hexagonal lattice spacing for cell area pi
+  R = math.sqrt(N) + 0.5*a                      # N cells of area pi fit into a disk of radius sqrt(N)
+  n = int(math.ceil(R/a)) + 1
+  pts = []
+  for i in range(-n, n + 1):
+    for j in range(-2*n, 2*n + 1):
+      x = (i + 0.5*(j % 2))*a
+      y = j*a*math.sqrt(3.0)/2.0
+      if x*x + y*y < (R - 0.5*a)**2:
+        pts.append((x, y))
+  # keep N cells closest to the centre
+  pts = sorted(pts, key=lambda p: p[0]*p[0] + p[1]*p[1])[:N]
+  pts = [(x + random.uniform(-0.05, 0.05)*a, y + random.uniform(-0.05, 0.05)*a) for (x, y) in pts]
+  NB = int(2.0*math.pi*R)       # boundary particles at unit spacing
+  keys = ['id', 'type', 'x', 'y', 'z', 'vx', 'vy', 'vz', 'nx', 'ny', 'nz', 'nvx', 'nvy', 'nvz', 'area', 'boundary']
+  if with_radius:
+    keys.insert(2, 'radius')
+  with open(input_name, 'w') as f:
+    f.write('keys: ' + '  '.join(keys) + '\n')
+    idx = 0
+    for (x, y) in pts + [(R*math.cos(2.0*math.pi*k/NB), R*math.sin(2.0*math.pi*k/NB)) for k in range(NB)]:
+      boundary = 1 if idx >= len(pts) else 0
+      nx, ny = random_direction()
+      line = '%d %d ' % (idx, 1 if boundary else 2)
+      if with_radius:
+        line += '1.0 '
+      line += '%f %f 0.0 0.0 0.0 0.0 %f %f 0.0 0.0 0.0 1.0 3.141593 %d' % (x, y, nx, ny, boundary)
+      f.write(line + '\n')
+      idx += 1
+  # Boundary is traversed clockwise, as in the shipped examples
+  first = len(pts)
+  with open(boundary_name, 'w') as f:
+    f.write('#\n')
+    for k in range(NB):
+      f.write('%d %d %d\n' % (k, first + k, first + (k - 1) % NB))
+  return R
+
+def cells_fixed(N, steps):
+  R = cell_patch(N, 'fixed.input', 'fixed.boundary', False)
+  L = 4.0*R
+  write_conf('bench.conf', ['messages messages.msg',
+                            'config bench { type = json }',
+                            'box fixed { lx = %f;  ly = %f;  lz = 10.0 }' % (L, L),
+                            'input fixed.input',
+                            'read_cell_boundary fixed.boundary',
+                            'nlist { rcut = 2.4; pad = 0.5; build_faces; triangulation; static_boundary; }',
+                            'constraint plane { unlimited  }',
+                            'pair_potential vp { K = 1.0; gamma = 1.0; lambda = -5.7; }',
+                            'pair_potential soft { k = 10.0; a = 1.0 }',
+                            'external self_propulsion { alpha = 1.2; exclude_boundary; }',
+                            'timestep 0.01',
+                            'integrator brownian_pos {group= internal; seed = 1; mu = 1.0; }',
+                            'integrator brownian_align { seed = 0; nu = 0.1; }',
+                            'run %d' % steps])
+
+def filaments_on_plane(N, steps):
+  # Filaments of 20 beads at the same bead density as configurations/filaments_on_plane (1000 beads in a 61x61 box)
+  nbeads = 20
+  L = math.sqrt(N/(1000.0/(61.0*61.0)))
+  per_row = max(1, int(L/(nbeads + 1.0)))
+  nfil = max(1, N//nbeads)
+  rows = int(math.ceil(float(nfil)/per_row))
+  dy = L/rows
+  idx = 0
+  with open('filaments.input', 'w') as f, open('filaments.bonds', 'w') as fb, open('filaments.angles', 'w') as fa:
+    f.write('keys: id  molecule type  x  y  nx  ny\n')
+    nb, na = 0, 0
+    for m in range(nfil):
+      row, col = m // per_row, m % per_row
+      x0 = -0.5*L + col*L/per_row + 0.5
+      y = -0.5*L + (row + 0.5)*dy
+      for k in range(nbeads):
+        f.write('%d %d 1 %f %f 1.0 0.0\n' % (idx, m, x0 + k, y))
+        if k > 0:
+          fb.write('%d 1 %d %d\n' % (nb, idx - 1, idx))
+          nb += 1
+        if k > 1:
+          fa.write('%d 1 %d %d %d\n' % (na, idx - 2, idx - 1, idx))
+          na += 1
+        idx += 1
+  write_conf('bench.conf', ['messages messages.msg',
+                            'config bench { type = json }',
+                            'box periodic {lx= %f; ly = %f ; lz = 2.000000 }' % (L, L),
+                            'input filaments.input',
+                            'read_bonds filaments.bonds',
+                            'read_angles filaments.angles',
+                            'nlist { rcut = 3.0; pad = 0.5 }',
+                            'constraint plane {  }',
+                            'external_align tangent { tau = 0.1 }',
+                            'pair_potential lj { epsilon = 1.0; sigma = 1.0; rcut = 2.5; shifted }',
+                            'pair_potential motor { alpha = 2.0; beta = 2.0; a = 1.5 }',
+                            'bond harmonic { k = 330.0; l_eq = 1.0 }',
+                            'angle harmonic { k = 10.0}',
+                            'integrator brownian { dt=0.00025; seed = 1;  nu = 0.0; mu = 1.0; v0 = 0.0; temperature_control=constant; min_val = 0.5; group = all }',
+                            'run %d' % steps])
+
+def growth(N, steps):
+  R = cell_patch(N, 'sfinal.input', 'sfinal.boundary', True)
+  L = max(1000.0, 8.0*R)     # leave room for the tissue to grow
+  write_conf('bench.conf', ['messages messages.msg',
+                            'config bench { type = json }',
+                            'box fixed { lx = %f;  ly = %f;  lz = 10.0 }' % (L, L),
+                            'input sfinal.input',
+                            'read_cell_boundary sfinal.boundary',
+                            'nlist { rcut = 2.4; pad = 0.5; build_faces; triangulation; }',
+                            'constraint plane { unlimited  }',
+                            'pair_potential vp { K = 1.0; gamma = 1.0; lambda = -5.5; phase_in=linear; min_val=0.; max_val=0.5 }',
+                            'pair_potential line_tension { lambda = 0.5; }',
+                            'pair_potential boundary_bending { kappa = 0.3; }',
+                            'pair_potential soft { k = 10.0; a = 1.0; phase_in=linear; min_val=0.; max_val=0.5 }',
+                            'population cell { group = internal; division_rate = 0.01; freq = 25; max_area = 2.8; growth_rate = 0.002; death_rate = 0.0 }',
+                            'timestep 0.005',
+                            'integrator brownian_pos {group= all; seed = 1; mu = 1.0; }',
+                            'run %d' % steps])
+
+def run_case(samos, workdir, case, N, steps):
+  """Generates and runs a single case. Returns dictionary with the results."""
+  directory = os.path.join(workdir, '%s_%d' % (case, N))
+  if not os.path.exists(directory):
+    os.makedirs(directory)
+  cwd = os.getcwd()
+  os.chdir(directory)
+  try:
+    random.seed(N)
+    globals()[case](N, steps)
+    with open('samos.out', 'w') as out:
+      status = subprocess.call([samos, 'bench.conf'], stdout=out, stderr=subprocess.STDOUT)
+    result = {'case' : case, 'N' : N, 'steps' : steps, 'status' : status}
+    if status == 0 and os.path.exists('bench.json'):
+      with open('bench.json') as f:
+        stats = json.load(f)['run']['stats']
+      for key in ['average_size', 'wall_time', 'ns_per_particle_step', 'peak_rss_kb', 'nlist_builds']:
+        result[key] = float(stats[key])
+      result['nlist_builds'] = int(result['nlist_builds'])
+      result['breakdown'] = dict((k, float(v)) for (k, v) in stats['breakdown'].items())
+    return result
+  finally:
+    os.chdir(cwd)
+
+def write_csv(name, results):
+  parts = sorted(set(k for r in results for k in r.get('breakdown', {})))
+  with open(name, 'w') as f:
+    f.write(','.join(['case', 'N', 'steps', 'status', 'average_size', 'wall_time', 'ns_per_particle_step', 'nlist_builds', 'peak_rss_kb'] + parts) + '\n')
+    for r in results:
+      row = [r['case'], r['N'], r['steps'], r['status']] + [r.get(k, '') for k in ['average_size', 'wall_time', 'ns_per_particle_step', 'nlist_builds', 'peak_rss_kb']]
+      row += [r.get('breakdown', {}).get(p, '') for p in parts]
+      f.write(','.join(str(v) for v in row) + '\n')
+
+def main():
+  parser = argparse.ArgumentParser()
+  parser.add_argument("-s", "--samos", type=str, default='samos', help="SAMoS executable")
+  parser.add_argument("-n", "--sizes", type=str, default='1000,10000,100000,1000000', help="comma separated list of system sizes")
+  parser.add_argument("-c", "--cases", type=str, default=','.join(CASES), help="comma separated list of cases")
+  parser.add_argument("-t", "--steps", type=int, default=0, help="number of steps for all cases (default: per case values)")
+  parser.add_argument("-w", "--workdir", type=str, default='samos_bench', help="directory where cases are generated and run")
+  parser.add_argument("-o", "--output", type=str, default='samos_bench.json', help="output file name")
+  parser.add_argument("-f", "--format", type=str, default='json', choices=['json', 'csv'], help="output format")
+  args = parser.parse_args()
+
+  samos = os.path.abspath(args.samos) if os.path.exists(args.samos) else args.samos
+  sizes = [int(float(n)) for n in args.sizes.split(',') if n.strip() != '']
+  cases = [c.strip() for c in args.cases.split(',') if c.strip() != '']
+  for c in cases:
+    if not c in CASES:
+      print("Unknown benchmark case %s. Available cases are : %s" % (c, ', '.join(CASES)))
+      sys.exit(1)
+
+  results = []
+  for case in cases:
+    for N in sizes:
+      steps = args.steps if args.steps > 0 else STEPS[case]
+      print("Running %s with %d particles for %d steps..." % (case, N, steps))
+      sys.stdout.flush()
+      r = run_case(samos, os.path.abspath(args.workdir), case, N, steps)
+      if r['status'] != 0 or not 'ns_per_particle_step' in r:
+        print("  FAILED (see %s)" % os.path.join(args.workdir, '%s_%d' % (case, N), 'samos.out'))
+      else:
+        print("  %.1f ns per particle-step, %d neighbour list builds, peak memory %d kB" % (r['ns_per_particle_step'], r['nlist_builds'], r['peak_rss_kb']))
+        print("  " + ', '.join('%s %.1f' % (k, v) for (k, v) in sorted(r['breakdown'].items())))
+      results.append(r)
+
+  if args.format == 'csv':
+    write_csv(args.output, results)
+  else:
+    with open(args.output, 'w') as f:
+      json.dump({'date' : str(datetime.now()), 'host' : platform.node(), 'platform' : platform.platform(),
+                 'samos' : samos, 'results' : results}, f, indent=2, sort_keys=True)
+  print("Results written to %s" % args.output)
+  if any(r['status'] != 0 for r in results):
+    sys.exit(1)
+
+if __name__ == "__main__":
+  main()
@@ -35,6 +35,7 @@
 void Aligner::compute()
 {
   //m_system->reset_torques();
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
   PairAlignType::iterator it_pair;
   ExternAlignType::iterator it_ext;
   
@@ -42,4 +43,5 @@ void Aligner::compute()
     (*it_pair).second->compute();
   for(it_ext = m_external_align.begin(); it_ext != m_external_align.end(); it_ext++)
     (*it_ext).second->compute();
+  m_compute_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
 }
@@ -32,6 +32,7 @@
 
 #include <map>
 #include <string>
+#include <chrono>
 
 using std::map;
 using std::string;
@@ -58,11 +59,13 @@ public:
   //! Construct Aligner object
   //! \param sys Reference to the System object
   //! \param msg Reference to the system wide messenger
-  Aligner(SystemPtr sys, const MessengerPtr msg) : m_system(sys), m_msg(msg), m_need_nlist(false) { }
+  Aligner(SystemPtr sys, const MessengerPtr msg) : m_system(sys), m_msg(msg), m_need_nlist(false), m_compute_time(0.0) { }
   
   //! Destructor
   ~Aligner()
   {
+    for (PairAlignType::iterator it = m_pair_align.begin(); it != m_pair_align.end(); it++)
+      (*it).second->unregister_cutoff((*it).first);
     m_pair_align.clear();
     m_external_align.clear();
   }
@@ -72,11 +75,16 @@ public:
   //! \param align Pointer to the pairwise alignment object
   void add_pair_align(const string& name, PairAlignPtr align)
   {
+    if (m_pair_align.find(name) != m_pair_align.end())   // Alignment is being replaced
+      m_pair_align[name]->unregister_cutoff(name);
     m_pair_align[name] = align;
     m_need_nlist = m_need_nlist | align->need_nlist();
     m_msg->msg(Messenger::INFO,"Added pairwise alignment : " + name + " to the list of pair alignments.");
     if (align->need_nlist())
+    {
       m_msg->msg(Messenger::INFO,"Pairwise alignment " + name + " has neighbour list. Neighbour list updates will be performed during the simulation.");
+      align->register_cutoff(name);
+    }
   }
   
   //! Add external alignment to the list of all external alignments 
@@ -122,6 +130,12 @@ public:
   //! Compute all alignments
   void compute();
   
+  //! Returns wall clock time (in seconds) spent in computing alignments since the last reset
+  double get_compute_time() { return m_compute_time; }
+  
+  //! Reset alignment computation timer (called at the beginning of each run)
+  void reset_timer() { m_compute_time = 0.0; }
+  
 private:
   
   SystemPtr m_system;            //!< Contains pointer to the System object
@@ -131,6 +145,8 @@ private:
   ExternAlignType m_external_align;  //!< Contains information about all external alignment
   
   bool m_need_nlist;                  //!< If true, there are potentials that need neighbour list
+  
+  double m_compute_time;              //!< Time spent in alignment computes (used for benchmarking)
    
 };
 
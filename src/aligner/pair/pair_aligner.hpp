@@ -77,6 +77,26 @@ public:
   //! Computes alignment torques for all particles
   virtual void compute() = 0;
   
+  //! Returns cutoff distance for the pair of particle types (0 if not known)
+  virtual double get_pair_cutoff(int, int) { return 0.0; }
+  
+  //! Register cutoff distances of this alignment with the neighbour list (used for per type pair neighbour list cutoffs)
+  //! \param name unique name of the alignment
+  //! \note The neighbour list keeps a pointer to this object, so unregister_cutoff has to be called before it is destroyed
+  void register_cutoff(const string& name)
+  {
+    PairAlign* align = this;
+    m_nlist->add_cutoff_provider("pair_align." + name, [align](int type_1, int type_2) { return align->get_pair_cutoff(type_1, type_2); });
+  }
+  
+  //! Remove cutoff distances of this alignment from the neighbour list
+  //! \param name unique name of the alignment
+  void unregister_cutoff(const string& name)
+  {
+    if (m_nlist)
+      m_nlist->remove_cutoff_provider("pair_align." + name);
+  }
+  
 protected:
        
   SystemPtr m_system;              //!< Pointer to the System object
@@ -160,6 +160,9 @@ public:
   //! Returns true since MF alignment needs neighbour list
   bool need_nlist() { return true; }
   
+  //! Returns cutoff distance for the pair of particle types
+  double get_pair_cutoff(int type_1, int type_2) { return m_has_pair_params ? m_pair_params[type_1-1][type_2-1].rcut : m_rcut; }
+  
   //! Computes "torques"
   void compute();
   
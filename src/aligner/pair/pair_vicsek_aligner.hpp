@@ -74,6 +74,9 @@ public:
   //! Returns true since Vicsek potential needs neighbour list
   bool need_nlist() { return true; }
   
+  //! Returns cutoff distance for the pair of particle types (same for all pairs)
+  double get_pair_cutoff(int, int) { return m_rcut; }
+  
   //! Computes "torques"
   void compute();
   
@@ -66,6 +66,10 @@ public:
   void add_constraint(const string& name, ConstraintPtr constraint)
   {
     m_constraints.push_back(constraint);
+    // Normal stored with the particle is unambiguous only if there is a single constraint
+    if (m_constraints.size() > 1)
+      for (vector<ConstraintPtr>::iterator it_c = m_constraints.begin(); it_c != m_constraints.end(); it_c++)
+        (*it_c)->set_cache_normal(false);
     m_msg->msg(Messenger::INFO,"Added  : " + name + " to the list of constraints.");
   }
   
@@ -99,6 +103,42 @@ public:
     return val;
   }
   
+  //! Apply all constraints to a list of particles
+  //! \param particles list of particle ids
+  void enforce(const vector<int>& particles)
+  {
+    for (vector<ConstraintPtr>::iterator it_c = m_constraints.begin(); it_c != m_constraints.end(); it_c++)
+      (*it_c)->enforce(particles);
+  }
+  
+  //! Rotate directors of a list of particles around normal vector to the surface
+  //! \param particles list of particle ids
+  //! \param phi rotation angles (one for each particle in the list)
+  void rotate_director(const vector<int>& particles, const vector<double>& phi)
+  {
+    for (vector<ConstraintPtr>::iterator it_c = m_constraints.begin(); it_c != m_constraints.end(); it_c++)
+      (*it_c)->rotate_director(particles,phi);
+  }
+  
+  //! Rotate velocities of a list of particles around normal vector to the surface
+  //! \param particles list of particle ids
+  //! \param phi rotation angles (one for each particle in the list)
+  void rotate_velocity(const vector<int>& particles, const vector<double>& phi)
+  {
+    for (vector<ConstraintPtr>::iterator it_c = m_constraints.begin(); it_c != m_constraints.end(); it_c++)
+      (*it_c)->rotate_velocity(particles,phi);
+  }
+  
+  //! Project torques of a list of particles onto normal vector
+  //! \param particles list of particle ids
+  //! \param val on return contains rotation angle change for each particle in the list
+  void project_torque(const vector<int>& particles, vector<double>& val)
+  {
+    val.assign(particles.size(),0.0);
+    for (vector<ConstraintPtr>::iterator it_c = m_constraints.begin(); it_c != m_constraints.end(); it_c++)
+      (*it_c)->project_torque(particles,val);
+  }
+  
   //! Computes normal to the surface
   //! \note That way thing are set up know only the normal to last constraint will be applied
   void compute_normal(Particle& p, double& Nx, double& Ny, double& Nz)
@@ -108,7 +148,7 @@ public:
       if (find(p.groups.begin(),p.groups.end(),(*it_c)->get_group()) != p.groups.end())
       {
         double nx = 0.0, ny = 0.0, nz = 0.0;
-        (*it_c)->compute_normal(p,nx,ny,nz);
+        (*it_c)->get_normal(p,nx,ny,nz);
         Nx += nx; Ny += ny;  Nz += nz;
       }
     double len_N = sqrt(Nx*Nx + Ny*Ny + Nz*Nz);
@@ -123,6 +163,14 @@ public:
     return res;
   }
   
+  //! Factor by which the last rescale uniformly scaled all particle positions (0 if it was not a uniform scaling)
+  double get_affine_scale()
+  {
+    if (m_constraints.size() != 1)
+      return 0.0;
+    return m_constraints[0]->get_affine_scale();
+  }
+  
 private:
   
   SystemPtr m_system;            //!< Contains pointer to the System object
@@ -71,6 +71,7 @@ void Constraint::enforce(Particle& p)
       
     double Nx, Ny, Nz;
     this->compute_normal(p,Nx,Ny,Nz);
+    p.set_normal(Nx,Ny,Nz);
     // compute v.N
     double v_dot_N = p.vx*Nx + p.vy*Ny + p.vz*Nz;
     // compute n.N
@@ -103,7 +104,7 @@ void Constraint::rotate_director(Particle& p, double phi)
   if (apply)
   {
     double U, V, W;
-    this->compute_normal(p,U,V,W);
+    this->get_normal(p,U,V,W);
     // Compute angle sins and cosines
     double c = cos(phi), s = sin(phi);
     // Compute new velocity coordinates
@@ -135,7 +136,7 @@ void Constraint::rotate_velocity(Particle& p, double phi)
   if (apply)
   {
     double U, V, W;
-    this->compute_normal(p,U,V,W);
+    this->get_normal(p,U,V,W);
     // Compute angle sins and cosines
     double c = cos(phi), s = sin(phi);
     // Compute new velocity coordinates
@@ -165,9 +166,52 @@ double Constraint::project_torque(Particle& p)
   if (apply)
   {
     double Nx, Ny, Nz;
-    this->compute_normal(p,Nx,Ny,Nz);
+    this->get_normal(p,Nx,Ny,Nz);
     return (p.tau_x*Nx + p.tau_y*Ny + p.tau_z*Nz);  
   }
   else 
     return 0.0;
 }
+
+/*! Enforce constraint on a list of particles. This default version 
+ *  calls the generic (iterative) single particle version directly, i.e. 
+ *  without a virtual function call per particle. Constraints with a closed 
+ *  form projection or that override single particle functions have to 
+ *  override the batch functions as well.
+ *  \param particles list of particle ids
+*/
+void Constraint::enforce(const vector<int>& particles)
+{
+  for (vector<int>::const_iterator it = particles.begin(); it != particles.end(); it++)
+    Constraint::enforce(m_system->get_particle(*it));
+}
+
+/*! Rotate directors of a list of particles around the normal vector
+ *  \param particles list of particle ids
+ *  \param phi rotation angles (one for each particle in the list)
+*/
+void Constraint::rotate_director(const vector<int>& particles, const vector<double>& phi)
+{
+  for (unsigned int i = 0; i < particles.size(); i++)
+    Constraint::rotate_director(m_system->get_particle(particles[i]),phi[i]);
+}
+
+/*! Rotate velocities of a list of particles around the normal vector
+ *  \param particles list of particle ids
+ *  \param phi rotation angles (one for each particle in the list)
+*/
+void Constraint::rotate_velocity(const vector<int>& particles, const vector<double>& phi)
+{
+  for (unsigned int i = 0; i < particles.size(); i++)
+    Constraint::rotate_velocity(m_system->get_particle(particles[i]),phi[i]);
+}
+
+/*! Project torques of a list of particles onto the normal vector
+ *  \param particles list of particle ids
+ *  \param val projected torques are added to this vector (one value per particle in the list)
+*/
+void Constraint::project_torque(const vector<int>& particles, vector<double>& val)
+{
+  for (unsigned int i = 0; i < particles.size(); i++)
+    val[i] += Constraint::project_torque(m_system->get_particle(particles[i]));
+}
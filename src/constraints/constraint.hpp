@@ -58,7 +58,8 @@ public:
                                                                    m_rescale(1.0),
                                                                    m_rescale_steps(1000),
                                                                    m_rescale_freq(10),
-                                                                   m_group("all") 
+                                                                   m_group("all"),
+                                                                   m_cache_normal(true) 
   { 
     if (param.find("maxiter") == param.end())
     {
@@ -131,9 +132,39 @@ public:
   //! Project torque onto normal vector and return rotation angle change
   virtual double project_torque(Particle&);
   
+  //! Enforce constraint on a list of particles
+  virtual void enforce(const vector<int>&);
+  
+  //! Rotate directors of a list of particles around normal vector to the surface
+  virtual void rotate_director(const vector<int>&, const vector<double>&);
+  
+  //! Rotate velocities of a list of particles around normal vector to the surface
+  virtual void rotate_velocity(const vector<int>&, const vector<double>&);
+  
+  //! Project torques of a list of particles onto normal vector and add them to the rotation angle changes
+  virtual void project_torque(const vector<int>&, vector<double>&);
+  
   //! Computes normal to the surface
   virtual void compute_normal(Particle&, double&, double&, double&) = 0;
   
+  //! Returns normal to the surface, computing it only if the particle has moved since it was last computed
+  //! \param p particle
+  //! \param Nx x component of the normal
+  //! \param Ny y component of the normal
+  //! \param Nz z component of the normal
+  void get_normal(Particle& p, double& Nx, double& Ny, double& Nz)
+  {
+    if (m_cache_normal && p.normal_valid())
+    {
+      Nx = p.Nx;  Ny = p.Ny;  Nz = p.Nz;
+    }
+    else
+    {
+      this->compute_normal(p,Nx,Ny,Nz);
+      p.set_normal(Nx,Ny,Nz);
+    }
+  }
+  
   // Computer gradient at a point
   virtual void compute_gradient(Particle&, double&, double&, double&) = 0;
   
@@ -143,9 +174,16 @@ public:
   // Rescale constraint
   virtual bool rescale() { return false;}
   
+  //! Factor by which rescale() scales positions of all particles (0 if rescaling is not a uniform scaling of all positions)
+  virtual double get_affine_scale() { return 0.0; }
+  
   //! Return the constraint group
   string get_group() { return m_group; }
   
+  //! Allow or forbid use of the normals stored with particles
+  //! \param val if false, normal is always recomputed
+  void set_cache_normal(bool val) { m_cache_normal = val; }
+  
 protected:
   
   SystemPtr  m_system;              //!< Pointer to the system object
@@ -157,6 +195,7 @@ protected:
   int m_rescale_freq;               //!< Skip this many steps between rescaling constrain
   double m_scale;                   //!< Rescale the constraint (e.g., sphere radius) by this much in each step (=m_rescale**(m_rescale_freq/m_rescale_steps))
   string m_group;                   //!< Apply constraint only to particles in this group
+  bool m_cache_normal;              //!< If true, reuse normal stored with the particle if it has not moved since the normal was computed
   
 };
 
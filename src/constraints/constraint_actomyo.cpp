@@ -180,3 +180,44 @@ double ConstraintActomyo::project_torque(Particle& p)
   else
     return 0.0;
 }
+
+/*! Project a list of particles onto the plane. 
+ *  \note All batch functions call ConstraintActomyo member functions directly, 
+ *  i.e., there is no virtual function call per particle.
+ *  \param particles list of particle ids
+ */
+void ConstraintActomyo::enforce(const vector<int>& particles)
+{
+  for (vector<int>::const_iterator it = particles.begin(); it != particles.end(); it++)
+    ConstraintActomyo::enforce(m_system->get_particle(*it));
+}
+
+/*! Rotate directors of a list of particles around the z axis
+ *  \param particles list of particle ids
+ *  \param phi rotation angles (one for each particle in the list)
+*/
+void ConstraintActomyo::rotate_director(const vector<int>& particles, const vector<double>& phi)
+{
+  for (unsigned int i = 0; i < particles.size(); i++)
+    ConstraintActomyo::rotate_director(m_system->get_particle(particles[i]),phi[i]);
+}
+
+/*! Rotate velocities of a list of particles around the z axis
+ *  \param particles list of particle ids
+ *  \param phi rotation angles (one for each particle in the list)
+*/
+void ConstraintActomyo::rotate_velocity(const vector<int>& particles, const vector<double>& phi)
+{
+  for (unsigned int i = 0; i < particles.size(); i++)
+    ConstraintActomyo::rotate_velocity(m_system->get_particle(particles[i]),phi[i]);
+}
+
+/*! Project torques of a list of particles onto the z axis
+ *  \param particles list of particle ids
+ *  \param val projected torques are added to this vector (one value per particle in the list)
+*/
+void ConstraintActomyo::project_torque(const vector<int>& particles, vector<double>& val)
+{
+  for (unsigned int i = 0; i < particles.size(); i++)
+    val[i] += ConstraintActomyo::project_torque(m_system->get_particle(particles[i]));
+}
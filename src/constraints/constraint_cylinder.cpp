@@ -69,9 +69,21 @@ void ConstraintCylinder::enforce(Particle& p)
       if (p.z > box->zhi) p.z -= box->Lz;
       else if (p.z < box->zlo) p.z += box->Lz;
     }
+    // Set particle normal (it does not depend on z)
+    p.set_normal(Nx,Ny,0.0);
   }
 }
 
+/*! Project a list of particles onto the cylinder. Calls ConstraintCylinder::enforce 
+ *  directly in order to avoid virtual function call for each particle.
+ *  \param particles list of particle ids
+ */
+void ConstraintCylinder::enforce(const vector<int>& particles)
+{
+  for (vector<int>::const_iterator it = particles.begin(); it != particles.end(); it++)
+    ConstraintCylinder::enforce(m_system->get_particle(*it));
+}
+
 /*! Rescale cylinder radius and make sure that all particles are still on it.
  *  Rescaling is done only at certain steps and only if rescale 
  *  factor is not equal to 1.
@@ -87,6 +99,7 @@ bool ConstraintCylinder::rescale()
       for  (int i = 0; i < m_system->size(); i++)
       {
         Particle& p = m_system->get_particle(i);
+        p.invalidate_normal();  // surface has changed
         this->enforce(p);
       }
       return true;
@@ -72,6 +72,9 @@ public:
   //! Enforce constraint
   void enforce(Particle&);
   
+  //! Enforce constraint on a list of particles
+  void enforce(const vector<int>&);
+  
   //! Computes normal to the surface
   void compute_normal(Particle& p, double& Nx, double& Ny, double& Nz)
   { 
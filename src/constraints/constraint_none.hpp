@@ -70,6 +70,23 @@ public:
   //! Project torque onto normal vector to the plane (z axis) and return rotation angle change
   double project_torque(Particle& p) { return 0.0; }
   
+  //! Enforce constraint on a list of particles
+  void enforce(const vector<int>& particles)
+  {
+    if (m_system->get_periodic())
+      for (vector<int>::const_iterator it = particles.begin(); it != particles.end(); it++)
+        m_system->enforce_periodic(m_system->get_particle(*it));
+  }
+  
+  //! Rotate directors of a list of particles (does nothing)
+  void rotate_director(const vector<int>& particles, const vector<double>& phi) { }
+  
+  //! Rotate velocities of a list of particles (does nothing)
+  void rotate_velocity(const vector<int>& particles, const vector<double>& phi) { }
+  
+  //! Project torques of a list of particles (does nothing)
+  void project_torque(const vector<int>& particles, vector<double>& val) { }
+  
   //! Computes normal to the surface
   void compute_normal(Particle& p, double& Nx, double& Ny, double& Nz) { p.Nx = 0.0; p.Ny = 0.0; p.Nz = 0.0; }
   
@@ -42,50 +42,60 @@ void ConstraintPlane::enforce(Particle& p)
     apply = (find(p.groups.begin(),p.groups.end(),m_group) != p.groups.end());
   if (apply)
   {
-    bool periodic = m_system->get_periodic();
-    double Lx = m_system->get_box()->Lx;
-    double Ly = m_system->get_box()->Ly;
-    double xlo = -0.5*Lx, xhi = 0.5*Lx;
-    double ylo = -0.5*Ly, yhi = 0.5*Ly;
     p.z = m_zpos;
     p.vz = 0.0;
     p.fz = 0.0;
+    p.nz = 0.0;
+    ConstraintPlane::enforce_in_plane(p);
     // Set the particle normal
-    p.Nx = 0.0; p.Ny = 0.0; p.Nz = 1.0;
-    // Check periodic boundary conditions 
-    if (periodic)
-      m_system->enforce_periodic(p);
-    else if (!m_unlimited) // reflective boundary conditions
+    p.set_normal(0.0,0.0,1.0);
+  }
+}
+
+/*! Apply boundary conditions in the xy plane and normalise the in-plane director. 
+ *  This is the part of the constraint that is still needed for particles that already lie 
+ *  in the plane.
+ *  \param p particle 
+ */
+void ConstraintPlane::enforce_in_plane(Particle& p)
+{
+  bool periodic = m_system->get_periodic();
+  double Lx = m_system->get_box()->Lx;
+  double Ly = m_system->get_box()->Ly;
+  double xlo = -0.5*Lx, xhi = 0.5*Lx;
+  double ylo = -0.5*Ly, yhi = 0.5*Ly;
+  // Check periodic boundary conditions 
+  if (periodic)
+    m_system->enforce_periodic(p);
+  else if (!m_unlimited) // reflective boundary conditions
+  {
+    if (p.x < xlo) 
     {
-      if (p.x < xlo) 
-      {
-        p.x = xlo;
-        p.vx = -p.vx;
-      }
-      else if (p.x > xhi)
-      {
-        p.x = xhi;
-        p.vx = -p.vx;
-      }
-      if (p.y < ylo) 
-      {
-        p.y = ylo;
-        p.vy = -p.vy;
-      }
-      else if (p.y > yhi)
-      {
-        p.y = yhi;
-        p.vy = -p.vy;
-      }
+      p.x = xlo;
+      p.vx = -p.vx;
+    }
+    else if (p.x > xhi)
+    {
+      p.x = xhi;
+      p.vx = -p.vx;
+    }
+    if (p.y < ylo) 
+    {
+      p.y = ylo;
+      p.vy = -p.vy;
+    }
+    else if (p.y > yhi)
+    {
+      p.y = yhi;
+      p.vy = -p.vy;
     }
-    // normalize director
-    p.nz = 0.0;
-    double len_n = sqrt(p.nx*p.nx + p.ny*p.ny);
-    double inv_len = 1.0;
-    if (len_n != 0.0) 
-      inv_len = 1.0/sqrt(p.nx*p.nx + p.ny*p.ny);
-    p.nx *= inv_len;  p.ny *= inv_len;  
   }
+  // normalize director
+  double len_n = sqrt(p.nx*p.nx + p.ny*p.ny);
+  double inv_len = 1.0;
+  if (len_n != 0.0) 
+    inv_len = 1.0/sqrt(p.nx*p.nx + p.ny*p.ny);
+  p.nx *= inv_len;  p.ny *= inv_len;  
 }
 
 /*! Rotate director of a particle around the normal vector (z axis)
@@ -161,6 +171,65 @@ double ConstraintPlane::project_torque(Particle& p)
     return 0.0;
 }
 
+/*! Project a list of particles onto the plane. 
+ *  In planar boxes integrators do not change z, vz or nz, so the projection is exact 
+ *  for all particles that are already in the plane and have their normal set. For those 
+ *  only the z component of the force is removed and the in-plane part (boundary conditions 
+ *  and director normalisation) is applied. 
+ *  Particles that are not in the plane yet (e.g., in the initial configuration) are fully projected.
+ *  \note All batch functions of the plane constraint call ConstraintPlane 
+ *  member functions directly, i.e., there is no virtual function call per particle.
+ *  \param particles list of particle ids
+ */
+void ConstraintPlane::enforce(const vector<int>& particles)
+{
+  bool planar = m_system->get_box()->planar;
+  for (vector<int>::const_iterator it = particles.begin(); it != particles.end(); it++)
+  {
+    Particle& p = m_system->get_particle(*it);
+    if (planar && p.z == m_zpos && p.vz == 0.0 && p.nz == 0.0 && p.Nz == 1.0)
+    {
+      if (m_group == "all" || find(p.groups.begin(),p.groups.end(),m_group) != p.groups.end())
+      {
+        p.fz = 0.0;
+        ConstraintPlane::enforce_in_plane(p);
+      }
+    }
+    else
+      ConstraintPlane::enforce(p);
+  }
+}
+
+/*! Rotate directors of a list of particles around the z axis
+ *  \param particles list of particle ids
+ *  \param phi rotation angles (one for each particle in the list)
+*/
+void ConstraintPlane::rotate_director(const vector<int>& particles, const vector<double>& phi)
+{
+  for (unsigned int i = 0; i < particles.size(); i++)
+    ConstraintPlane::rotate_director(m_system->get_particle(particles[i]),phi[i]);
+}
+
+/*! Rotate velocities of a list of particles around the z axis
+ *  \param particles list of particle ids
+ *  \param phi rotation angles (one for each particle in the list)
+*/
+void ConstraintPlane::rotate_velocity(const vector<int>& particles, const vector<double>& phi)
+{
+  for (unsigned int i = 0; i < particles.size(); i++)
+    ConstraintPlane::rotate_velocity(m_system->get_particle(particles[i]),phi[i]);
+}
+
+/*! Project torques of a list of particles onto the z axis
+ *  \param particles list of particle ids
+ *  \param val projected torques are added to this vector (one value per particle in the list)
+*/
+void ConstraintPlane::project_torque(const vector<int>& particles, vector<double>& val)
+{
+  for (unsigned int i = 0; i < particles.size(); i++)
+    val[i] += ConstraintPlane::project_torque(m_system->get_particle(particles[i]));
+}
+
 /*! Rescale box size and make sure that all particles fit in it.
  *  Rescaling is done only at certain steps and only if rescale 
  *  factor is not equal to 1.
@@ -179,6 +248,7 @@ bool ConstraintPlane::rescale()
         p.x *= m_scale; 
         p.y *= m_scale; 
         p.z *= m_scale;
+        p.invalidate_normal();  // surface has changed
         this->enforce(p);
       }
       return true;
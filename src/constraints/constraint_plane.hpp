@@ -92,6 +92,18 @@ public:
   //! Project torque onto normal vector to the plane (z axis) and return rotation angle change
   double project_torque(Particle&);
   
+  //! Enforce constraint on a list of particles
+  void enforce(const vector<int>&);
+  
+  //! Rotate directors of a list of particles around the z axis
+  void rotate_director(const vector<int>&, const vector<double>&);
+  
+  //! Rotate velocities of a list of particles around the z axis
+  void rotate_velocity(const vector<int>&, const vector<double>&);
+  
+  //! Project torques of a list of particles onto the z axis
+  void project_torque(const vector<int>&, vector<double>&);
+  
   //! Computes normal to the surface
   void compute_normal(Particle& p, double& Nx, double& Ny, double& Nz) { Nx = 0.0; Ny = 0.0; Nz = 1.0; p.Nx = Nx; p.Ny = Ny; p.Nz = Nz; }
   
@@ -103,9 +115,15 @@ public:
   
   // Rescale constraint
   bool rescale();
+  
+  //! Rescaling the plane uniformly scales positions of all particles (and the box)
+  double get_affine_scale() { return m_scale; }
    
 private:
   
+  //! Apply in-plane part of the constraint (boundary conditions and director normalisation)
+  void enforce_in_plane(Particle&);
+  
   bool m_unlimited;       //!< If true, ignore box boundary and low system to exapand freely
   double m_zpos;            //!< Position (along z axis) of the constraint plane
   
@@ -86,6 +86,18 @@ public:
   //! Project torque onto normal vector to the plane (z axis) and return rotation angle change
   double project_torque(Particle&);
   
+  //! Enforce constraint on a list of particles
+  void enforce(const vector<int>&);
+  
+  //! Rotate directors of a list of particles around the z axis
+  void rotate_director(const vector<int>&, const vector<double>&);
+  
+  //! Rotate velocities of a list of particles around the z axis
+  void rotate_velocity(const vector<int>&, const vector<double>&);
+  
+  //! Project torques of a list of particles onto the z axis
+  void project_torque(const vector<int>&, vector<double>&);
+  
   //! Computes normal to the surface
   void compute_normal(Particle& p, double& Nx, double& Ny, double& Nz) { Nx = 0.0; Ny = 0.0; Nz = 1.0; p.Nx = Nx; p.Ny = Ny; p.Nz = Nz; }
   
@@ -90,6 +90,22 @@ public:
   //! Project torque onto normal vector to the slab (z axis) and return rotation angle change
   double project_torque(Particle& p) { return 0.0; }// Does not do anything as this is not really a surface constraint.
   
+  //! Enforce constraint on a list of particles
+  void enforce(const vector<int>& particles)
+  {
+    for (vector<int>::const_iterator it = particles.begin(); it != particles.end(); it++)
+      ConstraintSlab::enforce(m_system->get_particle(*it));
+  }
+  
+  //! Rotate directors of a list of particles (does nothing)
+  void rotate_director(const vector<int>& particles, const vector<double>& phi) { }
+  
+  //! Rotate velocities of a list of particles (does nothing)
+  void rotate_velocity(const vector<int>& particles, const vector<double>& phi) { }
+  
+  //! Project torques of a list of particles (does nothing)
+  void project_torque(const vector<int>& particles, vector<double>& val) { }
+  
   //! Computes normal to the surface
   void compute_normal(Particle& p, double& Nx, double& Ny, double& Nz) { Nx = 0.0; Ny = 0.0; Nz = 0.0; p.Nx = Nx; p.Ny = Ny; p.Nz = Nz;  } // Does not do anything as this is not really a surface constraint.
   
@@ -63,7 +63,7 @@ void ConstraintSphere::enforce(Particle& p)
     double inv_len = 1.0/sqrt(p.nx*p.nx + p.ny*p.ny + p.nz*p.nz);
     p.nx *= inv_len;  p.ny *= inv_len;  p.nz *= inv_len;
     // Set particle normal
-    p.Nx = Nx; p.Ny = Ny; p.Nz = Nz;
+    p.set_normal(Nx,Ny,Nz);
     // Project all forces onto tangent plane
     if (m_system->record_force_type())
     {
@@ -80,6 +80,16 @@ void ConstraintSphere::enforce(Particle& p)
   }
 }
 
+/*! Project a list of particles onto the sphere. Calls ConstraintSphere::enforce 
+ *  directly in order to avoid virtual function call for each particle.
+ *  \param particles list of particle ids
+ */
+void ConstraintSphere::enforce(const vector<int>& particles)
+{
+  for (vector<int>::const_iterator it = particles.begin(); it != particles.end(); it++)
+    ConstraintSphere::enforce(m_system->get_particle(*it));
+}
+
 /*! Rescale sphere size and make sure that all particles are still on it.
  *  Rescaling is done only at certain steps and only if rescale 
  *  factor is not equal to 1.
@@ -95,6 +105,7 @@ bool ConstraintSphere::rescale()
       for  (int i = 0; i < m_system->size(); i++)
       {
         Particle& p = m_system->get_particle(i);
+        p.invalidate_normal();  // surface has changed
         this->enforce(p);
       }
       return true;
@@ -72,6 +72,9 @@ public:
   //! Enforce constraint
   void enforce(Particle&);
   
+  //! Enforce constraint on a list of particles
+  void enforce(const vector<int>&);
+  
   //! Computes normal to the surface
   void compute_normal(Particle& p, double& Nx, double& Ny, double& Nz) { Nx = p.x/m_r; Ny = p.y/m_r; Nz = p.z/m_r; p.Nx = Nx; p.Ny = Ny; p.Nz = Nz; }
   
@@ -83,6 +86,9 @@ public:
   
   // Rescale constraint
   bool rescale();
+  
+  //! Rescaling the sphere radius uniformly scales positions of all particles if all of them are constrained 
+  double get_affine_scale() { return (m_group == "all") ? m_scale : 0.0; }
       
 private:
   
@@ -100,6 +100,7 @@ bool ConstraintTetrahedron::rescale()
       for  (int i = 0; i < m_system->size(); i++)
       {
         Particle& p = m_system->get_particle(i);
+        p.invalidate_normal();  // surface has changed
         this->enforce(p);
       }
       return true;
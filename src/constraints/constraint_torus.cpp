@@ -30,6 +30,72 @@
 #include "constraint_torus.hpp"
 
 
+/*! Force particle to be confined to the surface of the torus and
+ *  its velocity to be tangent to it. Particle is projected onto the closest 
+ *  point on the surface. This point is found by first projecting the particle 
+ *  onto the central ring of the torus (radius \f$ c \f$ in the xy plane) and 
+ *  then moving it from the ring by \f$ a \f$ along the line that connects it 
+ *  to the projection. This direction is also the normal to the surface,
+ *  so no iterations are needed. Particles on the z axis or on the central ring 
+ *  have no unique closest point, so an arbitrary one is chosen.
+ *  \param p Particle which is to be projected onto the torus
+ */
+void ConstraintTorus::enforce(Particle& p)
+{
+  bool apply = false;
+  if (m_group == "all")
+    apply = true;
+  else
+    apply = (find(p.groups.begin(),p.groups.end(),m_group) != p.groups.end());
+  if (apply)
+  {
+    double x = p.x, y = p.y, z = p.z;
+    double sqr_xy = sqrt(x*x + y*y);
+    // Radial direction in the xy plane (on the z axis all points of the ring are equally close, so pick x axis)
+    double ux = 1.0, uy = 0.0;
+    if (sqr_xy > 1e-12)
+    {
+      ux = x/sqr_xy;  uy = y/sqr_xy;
+    }
+    // Closest point on the central ring
+    double rx = m_c*ux, ry = m_c*uy;
+    // Unit normal points from the ring towards the particle
+    double dx = x - rx, dy = y - ry, dz = z;
+    double len_d = sqrt(dx*dx + dy*dy + dz*dz);
+    double Nx = ux, Ny = uy, Nz = 0.0;     // On the central ring itself, move particle radially outwards
+    if (len_d > 1e-12)
+    {
+      Nx = dx/len_d;  Ny = dy/len_d;  Nz = dz/len_d;
+    }
+    // Place particle onto the surface
+    p.x = rx + m_a*Nx;  p.y = ry + m_a*Ny;  p.z = m_a*Nz;
+    // compute v.N
+    double v_dot_N = p.vx*Nx + p.vy*Ny + p.vz*Nz;
+    // compute n.N
+    double n_dot_N = p.nx*Nx + p.ny*Ny + p.nz*Nz;
+    // Project velocity onto tangent plane
+    p.vx -= v_dot_N*Nx; p.vy -= v_dot_N*Ny; p.vz -= v_dot_N*Nz;
+    // Project director onto tangent plane
+    p.nx -= n_dot_N*Nx; p.ny -= n_dot_N*Ny; p.nz -= n_dot_N*Nz;
+    // normalize director
+    double inv_len = 1.0/sqrt(p.nx*p.nx + p.ny*p.ny + p.nz*p.nz);
+    p.nx *= inv_len;  p.ny *= inv_len;  p.nz *= inv_len;
+    // Set particle normal
+    p.set_normal(Nx,Ny,Nz);
+    m_system->enforce_periodic(p);
+  }
+}
+
+/*! Project a list of particles onto the torus. Calls ConstraintTorus::enforce 
+ *  directly in order to avoid virtual function call for each particle.
+ *  \param particles list of particle ids
+ */
+void ConstraintTorus::enforce(const vector<int>& particles)
+{
+  for (vector<int>::const_iterator it = particles.begin(); it != particles.end(); it++)
+    ConstraintTorus::enforce(m_system->get_particle(*it));
+}
+
 /*! Compute normal to the surface at p
  *  
  *  Normal vector is computed as the normalized gradient vector at point p.
@@ -490,7 +490,7 @@ void Dump::dump_dcd()
 void Dump::dump_xyz()
 {
   int N = m_system->get_group(m_group)->get_size();
-  vector<int> particles = m_system->get_group(m_group)->get_particles();
+  vector<int>& particles = m_system->get_group(m_group)->get_particles();
   m_out << N << endl;
   m_out << "Generated by SAMoS code." << endl;
   for (int i = 0; i < N; i++)
@@ -507,7 +507,7 @@ void Dump::dump_data()
   double Ly = m_system->get_box()->Ly;
   double Lz = m_system->get_box()->Lz;
   int N = m_system->get_group(m_group)->get_size();
-  vector<int> particles = m_system->get_group(m_group)->get_particles();
+  vector<int>& particles = m_system->get_group(m_group)->get_particles();
   Mesh& mesh = m_system->get_mesh();
   if (m_print_header)
   {
@@ -676,7 +676,7 @@ void Dump::dump_data()
 void Dump::dump_input()
 {
   int N = m_system->get_group(m_group)->get_size();
-  vector<int> particles = m_system->get_group(m_group)->get_particles();
+  vector<int>& particles = m_system->get_group(m_group)->get_particles();
   if (m_print_header)
   {
     m_out << "# " << format(" Lx = %10.6f, Ly = %10.6f, Lz = %10.6f") % m_system->get_box()->Lx % m_system->get_box()->Ly % m_system->get_box()->Lz << endl;
@@ -697,7 +697,7 @@ void Dump::dump_velocity()
 {
   double scale = 1.0;
   int N = m_system->get_group(m_group)->get_size();
-  vector<int> particles = m_system->get_group(m_group)->get_particles();
+  vector<int>& particles = m_system->get_group(m_group)->get_particles();
   if (m_params.find("scale") != m_params.end())
   {
     m_msg->msg(Messenger::INFO,"Scaling all velocities by "+m_params["scale"]+".");
@@ -721,7 +721,7 @@ void Dump::dump_director()
 {
   double scale = 1.0;
   int N = m_system->get_group(m_group)->get_size();
-  vector<int> particles = m_system->get_group(m_group)->get_particles();
+  vector<int>& particles = m_system->get_group(m_group)->get_particles();
   if (m_params.find("scale") != m_params.end())
   {
     m_msg->msg(Messenger::INFO,"Scaling all director vectors by "+m_params["scale"]+".");
@@ -745,7 +745,7 @@ void Dump::dump_xyzv()
 {
   double scale = 1.0;
   int N = m_system->get_group(m_group)->get_size();
-  vector<int> particles = m_system->get_group(m_group)->get_particles();
+  vector<int>& particles = m_system->get_group(m_group)->get_particles();
   if (m_params.find("scale") != m_params.end())
   {
 #ifndef NDEBUG
@@ -773,7 +773,7 @@ void Dump::dump_xyzv()
 void Dump::dump_xyzc()
 {
   int N = m_system->get_group(m_group)->get_size();
-  vector<int> particles = m_system->get_group(m_group)->get_particles();
+  vector<int>& particles = m_system->get_group(m_group)->get_particles();
   m_system->enable_per_particle_eng();
   m_msg->msg(Messenger::WARNING,"XYZC file format output enabled per particle energy tracking. There fill be a substantial performance penalty (using slow STL maps).");
   m_out << N << endl;
@@ -862,7 +862,7 @@ void Dump::dump_contact()
     }
     bool periodic = m_system->get_periodic();
     int N = m_system->get_group(m_group)->get_size();
-    vector<int> particles = m_system->get_group(m_group)->get_particles();
+    vector<int>& particles = m_system->get_group(m_group)->get_particles();
     int contact = 0;
     double rcut2 = rcut*rcut;
     for (int i = 0; i < N; i++)
@@ -1091,7 +1091,7 @@ void Dump::dump_vtp(int step)
   if (!m_output_dual)
   {
     int N = m_system->get_group(m_group)->get_size();
-    vector<int> particles = m_system->get_group(m_group)->get_particles();
+    vector<int>& particles = m_system->get_group(m_group)->get_particles();
     
     vtkSmartPointer<vtkIntArray> ids =  vtkSmartPointer<vtkIntArray>::New();
     vtkSmartPointer<vtkIntArray> types =  vtkSmartPointer<vtkIntArray>::New();
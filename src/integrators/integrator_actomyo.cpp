@@ -48,6 +48,7 @@ void IntegratorActomyo::integrate()
   int N = m_system->size();
   double T = m_temp->get_val(m_system->get_run_step()); // current temperature 
   m_stoch_coeff = sqrt(2.0*T*m_dt/m_zeta);  
+  bool planar = m_system->get_box()->planar;
   // reset forces and torques
   m_system->reset_forces();
   m_system->reset_torques();
@@ -103,11 +104,14 @@ void IntegratorActomyo::integrate()
     // Update velocity     
     p.vx = p.fx/m_zeta; 
     p.vy = p.fy/m_zeta; 
-    p.vz = p.fz/m_zeta; 
     // Update particle position 
     p.x += m_dt*p.vx + m_stoch_coeff*m_rng->gauss_rng(1.0);
     p.y += m_dt*p.vy + m_stoch_coeff*m_rng->gauss_rng(1.0);
-    p.z += m_dt*p.vz + m_stoch_coeff*m_rng->gauss_rng(1.0);
+    if (!planar)   // in planar systems there is no motion and no noise in the z direction
+    {
+      p.vz = p.fz/m_zeta; 
+      p.z += m_dt*p.vz + m_stoch_coeff*m_rng->gauss_rng(1.0);
+    }
     // Project everything back to the manifold
     m_constrainer->enforce(p);
     p.age += m_dt;
@@ -45,9 +45,10 @@ void IntegratorBrownian::integrate()
   double T = m_temp->get_val(m_system->get_run_step());
   double B = sqrt(2.0*m_mu*T);
   double sqrt_dt = sqrt(m_dt);
+  bool planar = m_system->get_box()->planar;
   double fd_x, fd_y, fd_z;                    // Deterministic part of the force
   double fr_x = 0.0, fr_y = 0.0, fr_z = 0.0;  // Random part of the force
-  vector<int> particles = m_system->get_group(m_group_name)->get_particles();
+  vector<int>& particles = m_system->get_group(m_group_name)->get_particles();
   
   // reset forces and torques
   m_system->reset_forces();
@@ -75,6 +76,7 @@ void IntegratorBrownian::integrate()
   // compute torques in the current configuration
   if (m_align)
     m_align->compute();
+  m_dtheta_rnd.resize(N);
   // iterate over all particles 
   for (int i = 0; i < N; i++)
   {
@@ -87,38 +89,48 @@ void IntegratorBrownian::integrate()
     // Update velocity
     p.vx = fd_x; 
     p.vy = fd_y;
-    p.vz = fd_z;
     // Update particle position according to the eq. (1a)
     p.x += m_dt*fd_x;
     p.y += m_dt*fd_y;
-    p.z += m_dt*fd_z;
+    if (!planar)   // in planar systems the z direction is not integrated
+    {
+      p.vz = fd_z;
+      p.z += m_dt*fd_z;
+    }
     // Check is non-zero T
     if (T > 0.0)
     {
       fr_x = B*m_rng->gauss_rng(1.0);
       fr_y = B*m_rng->gauss_rng(1.0);
-      fr_z = B*m_rng->gauss_rng(1.0);
       p.vx += fr_x; 
       p.vy += fr_y;
-      p.vz += fr_z;  
       p.x += sqrt_dt*fr_x;
       p.y += sqrt_dt*fr_y;
-      p.z += sqrt_dt*fr_z;
+      if (!planar)   // in planar systems there is no noise in the z direction
+      {
+        fr_z = B*m_rng->gauss_rng(1.0);
+        p.vz += fr_z;  
+        p.z += sqrt_dt*fr_z;
+      }
     }
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
-    // Update angular velocity
-    p.omega = m_mur*m_constrainer->project_torque(p);
-    //p.omega = m_dt*m_constraint->project_torque(p);
+    // Draw the director noise here to keep the order of random numbers
+    m_dtheta_rnd[i] = m_stoch_coeff*m_rng->gauss_rng(1.0);
+  }
+  // Project everything back to the manifold
+  m_constrainer->enforce(particles);
+  // Update angular velocity
+  m_constrainer->project_torque(particles,m_dtheta);
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(particles[i]);
+    p.omega = m_mur*m_dtheta[i];
     // Change orientation of the director (in the tangent plane) according to eq. (1b)
-    double dtheta = m_dt*p.omega + m_stoch_coeff*m_rng->gauss_rng(1.0);
-    //double dtheta = m_dt*m_constraint->project_torque(p) + m_stoch_coeff*m_rng->gauss_rng(1.0);
-    m_constrainer->rotate_director(p,dtheta);
-    if (m_velocity)
-      m_constrainer->rotate_velocity(p,dtheta);  
-    //p.omega = dtheta*m_dt;
+    m_dtheta[i] = m_dt*p.omega + m_dtheta_rnd[i];
     p.age += m_dt;
   }
+  m_constrainer->rotate_director(particles,m_dtheta);
+  if (m_velocity)
+    m_constrainer->rotate_velocity(particles,m_dtheta);
   // Update vertex mesh
   m_system->update_mesh();
 }
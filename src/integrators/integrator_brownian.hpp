@@ -174,6 +174,8 @@ private:
   bool    m_nematic;      //!< If true; assume that the system is nematic, and the velocity will switch direction randomly
   double  m_tau;          //!< Time scale for the direction flip for nematic systems (flip with probability dt/tau)
   bool    m_velocity;     //!< If true, apply torque to velocity (this is used in simulations with velocity alignmant)
+  vector<double> m_dtheta;      //!< Per particle angle changes (kept between steps to avoid reallocation)
+  vector<double> m_dtheta_rnd;  //!< Stochastic part of the per particle angle changes
   
 };
 
@@ -41,7 +41,7 @@
 void IntegratorBrownianAlign::integrate()
 {
   int N = m_system->get_group(m_group_name)->get_size();
-  vector<int> particles = m_system->get_group(m_group_name)->get_particles();
+  vector<int>& particles = m_system->get_group(m_group_name)->get_particles();
   
   // reset torques
   m_system->reset_torques();
@@ -61,16 +61,17 @@ void IntegratorBrownianAlign::integrate()
   // compute torques in the current configuration
   if (m_align)
     m_align->compute();
+  // project all torques onto surface normals
+  m_constrainer->project_torque(particles,m_dtheta);
   // iterate over all particles 
   for (int i = 0; i < N; i++)
   {
     int pi = particles[i];
     Particle& p = m_system->get_particle(pi);
     // Update angular velocity
-    p.omega = m_mur*m_constrainer->project_torque(p);
+    p.omega = m_mur*m_dtheta[i];
     // Change orientation of the director (in the tangent plane) according to eq. (1b)
-    double dtheta = m_dt*p.omega + m_stoch_coeff*m_rng->gauss_rng(1.0);
-    //double dtheta = m_dt*m_constraint->project_torque(p) + m_stoch_coeff*m_rng->gauss_rng(1.0);
-    m_constrainer->rotate_director(p,dtheta);
+    m_dtheta[i] = m_dt*p.omega + m_stoch_coeff*m_rng->gauss_rng(1.0);
   }
+  m_constrainer->rotate_director(particles,m_dtheta);
 }
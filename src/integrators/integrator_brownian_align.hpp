@@ -136,6 +136,7 @@ private:
   double  m_stoch_coeff;  //!< Factor for the stochastic part of the equation of motion (\f$ = \nu \sqrt{dt} \f$)
   bool    m_nematic;      //!< If true; assume that the system is nematic, and the velocity will switch direction randomly
   double  m_tau;          //!< Time scale for the direction flip for nematic systems (flip with probability dt/tau)
+  vector<double> m_dtheta;  //!< Director rotation angle for each particle (kept between steps to avoid reallocation)
   
 };
 
@@ -40,8 +40,9 @@ void IntegratorBrownianPos::integrate()
   double T = m_temp->get_val(m_system->get_run_step());
   double B = sqrt(2.0*m_mu*T);
   double sqrt_dt = sqrt(m_dt);
+  bool planar = m_system->get_box()->planar;
   double fr_x = 0.0, fr_y = 0.0, fr_z = 0.0;  // Random part of the force
-  vector<int> particles = m_system->get_group(m_group_name)->get_particles();
+  vector<int>& particles = m_system->get_group(m_group_name)->get_particles();
   
   // reset forces 
   m_system->reset_forces();
@@ -57,28 +58,34 @@ void IntegratorBrownianPos::integrate()
     // Update velocity
     p.vx = m_mu*p.fx;
     p.vy = m_mu*p.fy;
-    p.vz = m_mu*p.fz;
     // Update particle position 
     p.x += m_dt*p.vx;
     p.y += m_dt*p.vy;
-    p.z += m_dt*p.vz;
+    if (!planar)   // in planar systems the z direction is not integrated
+    {
+      p.vz = m_mu*p.fz;
+      p.z += m_dt*p.vz;
+    }
     // Check is non-zero T and if non-zero add stochastic part
     if (T > 0.0)
     {
       fr_x = B*m_rng->gauss_rng(1.0);
       fr_y = B*m_rng->gauss_rng(1.0);
-      fr_z = B*m_rng->gauss_rng(1.0);
       p.vx += fr_x; 
       p.vy += fr_y;
-      p.vz += fr_z;  
       p.x += sqrt_dt*fr_x;
       p.y += sqrt_dt*fr_y;
-      p.z += sqrt_dt*fr_z;
+      if (!planar)   // in planar systems there is no noise in the z direction
+      {
+        fr_z = B*m_rng->gauss_rng(1.0);
+        p.vz += fr_z;  
+        p.z += sqrt_dt*fr_z;
+      }
     }
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
     p.age += m_dt;
   }
+  // Project everything back to the manifold
+  m_constrainer->enforce(particles);
   // Update vertex mesh
   m_system->update_mesh();
 }
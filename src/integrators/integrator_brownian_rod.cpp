@@ -38,7 +38,8 @@ void IntegratorBrownianRod::integrate()
   int N = m_system->get_group(m_group_name)->get_size();
   //double T = m_temp->get_val(m_system->get_run_step());
   double fd_x, fd_y, fd_z;                    // Deterministic part of the force
-  vector<int> particles = m_system->get_group(m_group_name)->get_particles();
+  vector<int>& particles = m_system->get_group(m_group_name)->get_particles();
+  bool planar = m_system->get_box()->planar;   // in planar systems the z direction is not integrated
   double R1, R2;
   
   // reset forces and torques
@@ -85,11 +86,13 @@ void IntegratorBrownianRod::integrate()
     // Update velocity
     p.vx = fd_x; 
     p.vy = fd_y;
-    p.vz = fd_z;
+    if (!planar)
+      p.vz = fd_z;
     // Update particle position according to the eq. (1a)
     p.x += m_dt*fd_x;
     p.y += m_dt*fd_y;
-    p.z += m_dt*fd_z;
+    if (!planar)
+      p.z += m_dt*fd_z;
     
     // Normal to the manifold
     double w1_x, w1_y, w1_z;
@@ -110,7 +113,8 @@ void IntegratorBrownianRod::integrate()
       
       p.x += stoch_par*m_rng->gauss_rng(1.0)*nx + stoch_perp*(R1*w1_x + R2*w2_x);
       p.y += stoch_par*m_rng->gauss_rng(1.0)*ny + stoch_perp*(R1*w1_y + R2*w2_y);
-      p.z += stoch_par*m_rng->gauss_rng(1.0)*nz + stoch_perp*(R1*w1_z + R2*w2_z);
+      if (!planar)
+        p.z += stoch_par*m_rng->gauss_rng(1.0)*nz + stoch_perp*(R1*w1_z + R2*w2_z);
     }
     
     double stoch = sqrt(2.0*D_rot*m_dt);
@@ -123,13 +127,18 @@ void IntegratorBrownianRod::integrate()
     
     p.nx += D_rot*dnx*m_dt + stoch*(R1*w1_x + R2*w2_x);
     p.ny += D_rot*dny*m_dt + stoch*(R1*w1_y + R2*w2_y);
-    p.nz += D_rot*dnz*m_dt + stoch*(R1*w1_z + R2*w2_z);
-   
+    if (!planar)
+      p.nz += D_rot*dnz*m_dt + stoch*(R1*w1_z + R2*w2_z);
+  }
     
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
-    // Compute angular velocity
-    p.omega += m_dt*m_constrainer->project_torque(p);
+  // Project everything back to the manifold
+  m_constrainer->enforce(particles);
+  // Compute angular velocity
+  m_constrainer->project_torque(particles,m_dtheta);
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(particles[i]);
+    p.omega += m_dt*m_dtheta[i];
     // Update rod age   
     p.age += m_dt;
   }
@@ -131,6 +131,7 @@ private:
   bool    m_nematic;      //!< If true; assume that the system is nematic, and the velocity will switch direction randomly
   bool    m_pos_noise;    //!< If true, add noise to the rod's position
   double  m_tau;          //!< Time scale for the direction flip for nematic systems (flip with probability dt/tau)
+  vector<double> m_dtheta;  //!< Per particle angle changes (kept between steps to avoid reallocation)
   
 };
 
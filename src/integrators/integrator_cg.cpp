@@ -0,0 +1,54 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file integrator_cg.cpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Implementation of the nonlinear conjugate gradient minimiser.
+ */ 
+
+#include "integrator_cg.hpp"
+
+/*! Compute new search direction as \f$ \mathbf{d} = \mathbf{f} + \beta \mathbf{d}_{old} \f$, 
+ *  where \f$ \beta = \max\left(0, \mathbf{f}\cdot(\mathbf{f}-\mathbf{f}_{old})/\mathbf{f}_{old}\cdot\mathbf{f}_{old}\right) \f$
+ *  is the Polak-Ribiere coefficient.
+**/
+void IntegratorCG::search_direction()
+{
+  int n = m_f.size();
+  if (m_restart || static_cast<int>(m_d.size()) != n)
+  {
+    m_d = m_f;
+    m_restart = false;
+    return;
+  }
+  double num = 0.0, den = 0.0;
+  for (int i = 0; i < n; i++)
+  {
+    num += m_f[i]*(m_f[i] - m_f_old[i]);
+    den += m_f_old[i]*m_f_old[i];
+  }
+  double beta = (den > 0.0) ? max(0.0, num/den) : 0.0;
+  for (int i = 0; i < n; i++)
+    m_d[i] = m_f[i] + beta*m_d[i];
+}
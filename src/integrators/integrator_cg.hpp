@@ -0,0 +1,81 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file integrator_cg.hpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Declaration of IntegratorCG class
+ */ 
+
+#ifndef __INTEGRATOR_CG_H__
+#define __INTEGRATOR_CG_H__
+
+#include "integrator_minimiser.hpp"
+
+using std::max;
+
+/*! IntegratorCG class handles nonlinear conjugate gradient minimisation 
+ *  with the Polak-Ribiere formula. Negative values of the Polak-Ribiere 
+ *  coefficient are set to zero (PR+), which automatically restarts the method 
+ *  along the steepest descent direction.
+ *  \note No activity. Just minimisation. 
+*/
+class IntegratorCG : public IntegratorMinimiser
+{
+public:
+  
+  //! Constructor
+  //! \param sys Pointer to a System object containing all particles
+  //! \param msg Internal message handler
+  //! \param pot Pairwise and external interaction handler
+  //! \param align Pairwise and external alignment handler
+  //! \param nlist Neighbour list object
+  //! \param cons Enforces constraints to the manifold surface
+  //! \param temp Temperature control object
+  //! \param param Contains information about all parameters 
+  IntegratorCG(SystemPtr sys, MessengerPtr msg, PotentialPtr pot, AlignerPtr align, NeighbourListPtr nlist,  ConstrainerPtr cons, ValuePtr temp, pairs_type& param) : IntegratorMinimiser(sys, msg, pot, align, nlist, cons, temp, param, "CG"),
+                                                                                                                                                                      m_restart(true)
+  { 
+    m_msg->write_config("integrator.cg","");
+  }
+  
+protected:
+  
+  //! Compute conjugate search direction
+  void search_direction();
+  
+  //! Adjust initial step length for the next line search
+  void accept_step(double alpha) { m_alpha = 2.0*alpha; }
+  
+  //! Restart along the steepest descent direction
+  void reset() { m_restart = true; m_alpha = m_dt; }
+  
+private:
+  
+  bool m_restart;      //!< If true, next search direction is along the force
+  
+};
+
+typedef shared_ptr<IntegratorCG> IntegratorCGPtr;
+
+#endif
@@ -42,7 +42,8 @@ void IntegratorFIRE::integrate()
 
   int N = m_system->get_group(m_group_name)->get_size();
   double sqrt_ndof = sqrt(3*N);
-  vector<int> particles = m_system->get_group(m_group_name)->get_particles();
+  vector<int>& particles = m_system->get_group(m_group_name)->get_particles();
+  bool planar = m_system->get_box()->planar;   // in planar systems the z direction is not integrated
   double dt_2 = 0.5*m_dt;
   
   // Perform first half step for velocity
@@ -52,18 +53,25 @@ void IntegratorFIRE::integrate()
     Particle& p = m_system->get_particle(pi);
     p.vx += dt_2*p.fx;
     p.vy += dt_2*p.fy;
-    p.vz += dt_2*p.fz;
+    if (!planar)
+      p.vz += dt_2*p.fz;
     // Update position
     p.x += m_dt*p.vx;
     p.y += m_dt*p.vy;
-    p.z += m_dt*p.vz;
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
-    // Update angular velocity
-    p.omega += dt_2*m_constrainer->project_torque(p);
-    double dtheta = m_dt*p.omega; //m_constraint->project_torque(p);
-    m_constrainer->rotate_director(p,dtheta);
+    if (!planar)
+      p.z += m_dt*p.vz;
   }
+  // Project everything back to the manifold
+  m_constrainer->enforce(particles);
+  // Update angular velocity
+  m_constrainer->project_torque(particles,m_dtheta);
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(particles[i]);
+    p.omega += dt_2*m_dtheta[i];
+    m_dtheta[i] = m_dt*p.omega;
+  }
+  m_constrainer->rotate_director(particles,m_dtheta);
 
   // reset forces and torques
   m_system->reset_forces();
@@ -82,16 +90,19 @@ void IntegratorFIRE::integrate()
     Particle& p = m_system->get_particle(pi);
     p.vx += dt_2*p.fx;
     p.vy += dt_2*p.fy;
-    p.vz += dt_2*p.fz;
+    if (!planar)
+      p.vz += dt_2*p.fz;
     // Compute FIRE related quantities
     P += p.vx*p.fx + p.vy*p.fy + p.vz*p.fz;
     Fnorm += p.fx*p.fx + p.fy*p.fy + p.fz*p.fz;
     Vnorm += p.vx*p.vx + p.vy*p.vy + p.vz*p.vz;
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
-    // Update angular velocity
-    p.omega += dt_2*m_constrainer->project_torque(p);
   }
+  // Project everything back to the manifold
+  m_constrainer->enforce(particles);
+  // Update angular velocity
+  m_constrainer->project_torque(particles,m_dtheta);
+  for (int i = 0; i < N; i++)
+    m_system->get_particle(particles[i]).omega += dt_2*m_dtheta[i];
   // Update vertex mesh
   m_system->update_mesh();
 
@@ -117,7 +128,8 @@ void IntegratorFIRE::integrate()
     Particle& p = m_system->get_particle(pi);
     p.vx = fact_1*p.vx + fact_2 * p.fx;
     p.vy = fact_1*p.vy + fact_2 * p.fy;
-    p.vz = fact_1*p.vz + fact_2 * p.fz;
+    if (!planar)
+      p.vz = fact_1*p.vz + fact_2 * p.fz;
   }
   
   if (P > 0.0)
@@ -170,6 +170,7 @@ private:
   double m_old_energy;                              //!< Old value of energy
   bool   m_converged;                               //!< Flag which tests if the method has converged
   double m_dt_max;                                  //!< Maximum time step
+  vector<double> m_dtheta;                          //!< Per particle angle changes (kept between steps to avoid reallocation)
 
   
 };
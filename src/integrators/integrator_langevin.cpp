@@ -58,9 +58,10 @@ void IntegratorLangevin::integrate_baoab()
   double B = sqrt(T*(1.0-exp(-2.0*m_gamma*m_dt)));
   double exp_dt = exp(-m_gamma*m_dt);
   double dt2 = 0.5*m_dt;
-  vector<int> particles = m_system->get_group(m_group_name)->get_particles();
+  vector<int>& particles = m_system->get_group(m_group_name)->get_particles();
+  bool planar = m_system->get_box()->planar;   // in planar systems the z direction is not integrated
 
-  // BAOA steps
+  // BA steps
   for (int i = 0; i < N; i++)
   {
     int pi = particles[i];
@@ -69,31 +70,43 @@ void IntegratorLangevin::integrate_baoab()
     // B step
     p.vx += fact*p.fx;
     p.vy += fact*p.fy;
-    p.vz += fact*p.fz;
+    if (!planar)
+      p.vz += fact*p.fz;
     // A step
     p.x += dt2*p.vx;
     p.y += dt2*p.vy;
-    p.z += dt2*p.vz;
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
+    if (!planar)
+      p.z += dt2*p.vz;
+  }
+  // Project everything back to the manifold
+  m_constrainer->enforce(particles);
+  
+  // OA steps
+  for (int i = 0; i < N; i++)
+  {
+    int pi = particles[i];
+    Particle& p = m_system->get_particle(pi);
     // O step
     p.vx *= exp_dt;
     p.vy *= exp_dt;
-    p.vz *= exp_dt;
+    if (!planar)
+      p.vz *= exp_dt;
     if (B != 0.0)
     {
       double stoch_fact = B/sqrt(p.mass);
       p.vx += stoch_fact*m_rng->gauss_rng(1.0);
       p.vy += stoch_fact*m_rng->gauss_rng(1.0);
-      p.vz += stoch_fact*m_rng->gauss_rng(1.0);
+      if (!planar)
+        p.vz += stoch_fact*m_rng->gauss_rng(1.0);
     }
     // A step
     p.x += dt2*p.vx;
     p.y += dt2*p.vy;
-    p.z += dt2*p.vz;
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
+    if (!planar)
+      p.z += dt2*p.vz;
   }
+  // Project everything back to the manifold
+  m_constrainer->enforce(particles);
   
   // reset forces 
   m_system->reset_forces();
@@ -110,7 +123,8 @@ void IntegratorLangevin::integrate_baoab()
     double fact = dt2/p.mass;
     p.vx += fact*p.fx;
     p.vy += fact*p.fy;
-    p.vz += fact*p.fz;
+    if (!planar)
+      p.vz += fact*p.fz;
     p.age += m_dt;
   }
   // Update vertex mesh
@@ -135,7 +149,8 @@ void IntegratorLangevin::integrate_spv()
   else eta = (1.0-exp(-m_dt*m_gamma))/m_gamma;
   double exp_dt = exp(-m_dt*m_gamma);
   double dt2 = 0.5*m_dt;
-  vector<int> particles = m_system->get_group(m_group_name)->get_particles();
+  vector<int>& particles = m_system->get_group(m_group_name)->get_particles();
+  bool planar = m_system->get_box()->planar;   // in planar systems the z direction is not integrated
   
   // Step 1
   for (int i = 0; i < N; i++)
@@ -144,10 +159,11 @@ void IntegratorLangevin::integrate_spv()
     Particle& p = m_system->get_particle(pi);
     p.x += dt2*p.vx;
     p.y += dt2*p.vy;
-    p.z += dt2*p.vz;
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
+    if (!planar)
+      p.z += dt2*p.vz;
   }
+  // Project everything back to the manifold
+  m_constrainer->enforce(particles);
 
   // reset forces 
   m_system->reset_forces();
@@ -164,22 +180,25 @@ void IntegratorLangevin::integrate_spv()
     double fact = eta/p.mass;
     p.vx = exp_dt*p.vx + fact*p.fx;
     p.vy = exp_dt*p.vy + fact*p.fy;
-    p.vz = exp_dt*p.vz + fact*p.fz;
+    if (!planar)
+      p.vz = exp_dt*p.vz + fact*p.fz;
     if (zeta != 0.0)
     {
       double stoch_fact = zeta/sqrt(p.mass);
       p.vx += stoch_fact*m_rng->gauss_rng(1.0);
       p.vy += stoch_fact*m_rng->gauss_rng(1.0);
-      p.vz += stoch_fact*m_rng->gauss_rng(1.0);
+      if (!planar)
+        p.vz += stoch_fact*m_rng->gauss_rng(1.0);
     }
     // Step 3
     p.x += dt2*p.vx;
     p.y += dt2*p.vy;
-    p.z += dt2*p.vz;
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
+    if (!planar)
+      p.z += dt2*p.vz;
     p.age += m_dt;
   }
+  // Project everything back to the manifold
+  m_constrainer->enforce(particles);
 }
 
 /*! Integrates stochastic equations of motion using Langevin dynamics.
@@ -198,7 +217,8 @@ void IntegratorLangevin::integrate_bbk()
   double dt2 = 0.5*m_dt;
   double one_m_dt2 = 1.0 - m_gamma*dt2;
   double one_div_one_p_dt2 = 1.0/(1.0 + m_gamma*dt2);
-  vector<int> particles = m_system->get_group(m_group_name)->get_particles();
+  vector<int>& particles = m_system->get_group(m_group_name)->get_particles();
+  bool planar = m_system->get_box()->planar;   // in planar systems the z direction is not integrated
   
   // Steps 1 and 2
   for (int i = 0; i < N; i++)
@@ -208,20 +228,23 @@ void IntegratorLangevin::integrate_bbk()
     double dt2_over_mass = dt2/p.mass;
     p.vx = one_m_dt2*p.vx + dt2_over_mass*p.fx;
     p.vy = one_m_dt2*p.vy + dt2_over_mass*p.fy;
-    p.vz = one_m_dt2*p.vz + dt2_over_mass*p.fz;
+    if (!planar)
+      p.vz = one_m_dt2*p.vz + dt2_over_mass*p.fz;
     if (B != 0.0)
     {
       double stoch_fact = 0.5*B/sqrt(p.mass);
       p.vx += stoch_fact*m_Rx[i];
       p.vy += stoch_fact*m_Ry[i];
-      p.vz += stoch_fact*m_Rz[i];
+      if (!planar)
+        p.vz += stoch_fact*m_Rz[i];
     }
     p.x += m_dt*p.vx;
     p.y += m_dt*p.vy;
-    p.z += m_dt*p.vz;
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
+    if (!planar)
+      p.z += m_dt*p.vz;
   }
+  // Project everything back to the manifold
+  m_constrainer->enforce(particles);
 
   // reset forces 
   m_system->reset_forces();
@@ -237,16 +260,19 @@ void IntegratorLangevin::integrate_bbk()
     double dt2_over_mass = dt2/p.mass;
     p.vx = one_div_one_p_dt2*(p.vx + dt2_over_mass*p.fx);
     p.vy = one_div_one_p_dt2*(p.vy + dt2_over_mass*p.fy);
-    p.vz = one_div_one_p_dt2*(p.vz + dt2_over_mass*p.fz);
+    if (!planar)
+      p.vz = one_div_one_p_dt2*(p.vz + dt2_over_mass*p.fz);
     if (B != 0.0)
     {
       double stoch_fact = 0.5*B*one_div_one_p_dt2/sqrt(p.mass);
       m_Rx[i] = m_rng->gauss_rng(1.0);
       m_Ry[i] = m_rng->gauss_rng(1.0);
-      m_Rz[i] = m_rng->gauss_rng(1.0);
+      if (!planar)
+        m_Rz[i] = m_rng->gauss_rng(1.0);
       p.vx += stoch_fact*m_Rx[i];
       p.vy += stoch_fact*m_Ry[i];
-      p.vz += stoch_fact*m_Rz[i];
+      if (!planar)
+        p.vz += stoch_fact*m_Rz[i];
       p.age += m_dt;
     }
   }
@@ -0,0 +1,111 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file integrator_lbfgs.cpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Implementation of the L-BFGS minimiser.
+ */ 
+
+#include "integrator_lbfgs.hpp"
+
+/*! Compute search direction using the L-BFGS two-loop recursion. 
+ *  Since we work with forces (negative gradients), the recursion directly 
+ *  produces the descent direction. If there are no stored corrections,
+ *  the search direction is along the force.
+**/
+void IntegratorLBFGS::search_direction()
+{
+  int n = m_f.size();
+  m_d = m_f;
+  if (m_hist == 0)
+  {
+    m_alpha = m_dt;
+    return;
+  }
+  // First loop, from the newest to the oldest correction
+  for (int k = 0; k < m_hist; k++)
+  {
+    int j = (m_head - 1 - k + m_memory) % m_memory;
+    const vector<double>& s = m_s_hist[j];
+    const vector<double>& y = m_y_hist[j];
+    double a = 0.0;
+    for (int i = 0; i < n; i++)
+      a += s[i]*m_d[i];
+    a *= m_rho[j];
+    m_a[j] = a;
+    for (int i = 0; i < n; i++)
+      m_d[i] -= a*y[i];
+  }
+  // Scale with the estimate of the inverse Hessian based on the newest correction
+  int newest = (m_head - 1 + m_memory) % m_memory;
+  double yy = 0.0;
+  for (int i = 0; i < n; i++)
+    yy += m_y_hist[newest][i]*m_y_hist[newest][i];
+  double gamma = 1.0/(m_rho[newest]*yy);
+  for (int i = 0; i < n; i++)
+    m_d[i] *= gamma;
+  // Second loop, from the oldest to the newest correction
+  for (int k = m_hist - 1; k >= 0; k--)
+  {
+    int j = (m_head - 1 - k + m_memory) % m_memory;
+    const vector<double>& s = m_s_hist[j];
+    const vector<double>& y = m_y_hist[j];
+    double b = 0.0;
+    for (int i = 0; i < n; i++)
+      b += y[i]*m_d[i];
+    b *= m_rho[j];
+    for (int i = 0; i < n; i++)
+      m_d[i] += s[i]*(m_a[j] - b);
+  }
+  // Quasi-Newton step has natural length 1
+  m_alpha = 1.0;
+}
+
+/*! Store displacement and gradient change of the accepted step. 
+ *  Pairs that do not satisfy curvature condition (s.y > 0) are 
+ *  discarded in order to keep inverse Hessian approximation positive definite.
+ *  \param alpha accepted step length (not used)
+**/
+void IntegratorLBFGS::accept_step(double alpha)
+{
+  int n = m_f.size();
+  vector<double>& s = m_s_hist[m_head];
+  vector<double>& y = m_y_hist[m_head];
+  s = m_s;
+  y.resize(n);
+  double sy = 0.0, ss = 0.0, yy = 0.0;
+  for (int i = 0; i < n; i++)
+  {
+    y[i] = m_f_old[i] - m_f[i];    // change of gradient (gradient is -f)
+    sy += s[i]*y[i];
+    ss += s[i]*s[i];
+    yy += y[i]*y[i];
+  }
+  if (sy > 1e-10*sqrt(ss*yy))
+  {
+    m_rho[m_head] = 1.0/sy;
+    m_head = (m_head + 1) % m_memory;
+    m_hist = min(m_hist + 1, m_memory);
+  }
+}
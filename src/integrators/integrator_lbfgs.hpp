@@ -0,0 +1,105 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file integrator_lbfgs.hpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Declaration of IntegratorLBFGS class
+ */ 
+
+#ifndef __INTEGRATOR_LBFGS_H__
+#define __INTEGRATOR_LBFGS_H__
+
+#include "integrator_minimiser.hpp"
+
+/*! IntegratorLBFGS class handles limited memory BFGS (quasi-Newton) minimisation. 
+ *  Inverse Hessian is approximated from the last few (parameter memory) displacements 
+ *  and force changes using the standard two-loop recursion.
+ *  \note No activity. Just minimisation. 
+*/
+class IntegratorLBFGS : public IntegratorMinimiser
+{
+public:
+  
+  //! Constructor
+  //! \param sys Pointer to a System object containing all particles
+  //! \param msg Internal message handler
+  //! \param pot Pairwise and external interaction handler
+  //! \param align Pairwise and external alignment handler
+  //! \param nlist Neighbour list object
+  //! \param cons Enforces constraints to the manifold surface
+  //! \param temp Temperature control object
+  //! \param param Contains information about all parameters 
+  IntegratorLBFGS(SystemPtr sys, MessengerPtr msg, PotentialPtr pot, AlignerPtr align, NeighbourListPtr nlist,  ConstrainerPtr cons, ValuePtr temp, pairs_type& param) : IntegratorMinimiser(sys, msg, pot, align, nlist, cons, temp, param, "LBFGS"),
+                                                                                                                                                                         m_hist(0),
+                                                                                                                                                                         m_head(0)
+  { 
+    m_msg->write_config("integrator.lbfgs","");
+    if (param.find("memory") != param.end())
+    {
+      m_msg->msg(Messenger::INFO,"LBFGS minimiser number of stored corrections set to "+param["memory"]+".");
+      m_memory = lexical_cast<int>(param["memory"]);
+    }
+    else
+    {
+      m_msg->msg(Messenger::WARNING,"LBFGS minimiser number of stored corrections (memory) not set. Using default value of 5.");
+      m_memory = 5;
+    }
+    if (m_memory < 1)
+    {
+      m_msg->msg(Messenger::ERROR,"LBFGS minimiser needs to store at least one correction.");
+      throw runtime_error("LBFGS minimiser. Illegal memory size.");
+    }
+    m_msg->write_config("integrator.LBFGS.memory",lexical_cast<string>(m_memory));
+    m_s_hist.resize(m_memory);
+    m_y_hist.resize(m_memory);
+    m_rho.resize(m_memory);
+    m_a.resize(m_memory);
+  }
+  
+protected:
+  
+  //! Compute L-BFGS search direction
+  void search_direction();
+  
+  //! Store the latest correction pair
+  void accept_step(double);
+  
+  //! Clear all stored corrections
+  void reset() { m_hist = 0; m_head = 0; }
+  
+private:
+  
+  int m_memory;                       //!< Maximum number of stored correction pairs
+  int m_hist;                         //!< Number of currently stored correction pairs
+  int m_head;                         //!< Slot where the next correction pair will be stored
+  vector<vector<double> > m_s_hist;   //!< Stored displacements
+  vector<vector<double> > m_y_hist;   //!< Stored gradient changes
+  vector<double> m_rho;               //!< 1/(y.s) for each stored pair
+  vector<double> m_a;                 //!< Auxiliary coefficients of the two-loop recursion
+  
+};
+
+typedef shared_ptr<IntegratorLBFGS> IntegratorLBFGSPtr;
+
+#endif
@@ -0,0 +1,202 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file integrator_minimiser.cpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Implementation of the line search part of the energy minimisers.
+ */ 
+
+#include "integrator_minimiser.hpp"
+
+/*! Performs one iteration of the minimiser. Search direction is provided by the 
+ *  child class. Step length is determined by the backtracking line search with the 
+ *  Armijo (sufficient decrease) condition. The step is limited such that no particle 
+ *  moves by more than max_step. Minimisation is converged when the RMS tangential 
+ *  force is below f_tolerance and the energy change between two iterations is 
+ *  below e_tolerance.
+**/
+void IntegratorMinimiser::integrate()
+{
+  if (!m_potential) return;
+  
+  vector<int>& particles = m_system->get_group(m_group_name)->get_particles();
+  int N = particles.size();
+  double sqrt_ndof = sqrt(3*N);
+  
+  // First call or group changed size; make sure particles sit on the manifold, 
+  // compute forces at that position (new particles have none yet) and start from scratch
+  if (static_cast<int>(m_x0.size()) != 3*N)
+  {
+    m_constrainer->enforce(particles);
+    this->compute_forces();
+    this->reset();
+  }
+  
+  double E0 = m_potential->compute_potential_energy();
+  this->collect(particles,m_x0,m_f);
+  m_image.resize(3*N);
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(particles[i]);
+    m_image[3*i] = p.ix;  m_image[3*i+1] = p.iy;  m_image[3*i+2] = p.iz;
+  }
+  
+  double Fnorm = 0.0;
+  for (int i = 0; i < 3*N; i++)
+    Fnorm += m_f[i]*m_f[i];
+  Fnorm = sqrt(Fnorm);
+  
+  if (Fnorm/sqrt_ndof < m_F_tol && fabs(E0 - m_old_energy) < m_E_tol)
+  {
+    if (!m_converged)
+      m_msg->msg(Messenger::INFO,m_name+" minimisation converged.");
+    m_converged = true;
+    return;
+  }
+  m_converged = false;
+  m_old_energy = E0;
+  
+  this->search_direction();
+  
+  // Directional derivative of the energy along the search direction
+  double slope = 0.0;
+  for (int i = 0; i < 3*N; i++)
+    slope -= m_f[i]*m_d[i];
+  if (slope >= 0.0)   // not a descent direction; fall back to steepest descent
+  {
+    this->reset();
+    m_d = m_f;
+    m_alpha = m_dt;
+    slope = -Fnorm*Fnorm;
+  }
+  
+  // Limit the step so that no particle moves too far
+  double d_max = 0.0;
+  for (int i = 0; i < N; i++)
+  {
+    double d2 = m_d[3*i]*m_d[3*i] + m_d[3*i+1]*m_d[3*i+1] + m_d[3*i+2]*m_d[3*i+2];
+    if (d2 > d_max) d_max = d2;
+  }
+  d_max = sqrt(d_max);
+  double alpha = m_alpha;
+  if (alpha*d_max > m_max_step)
+    alpha = m_max_step/d_max;
+  
+  // Backtracking line search
+  bool accepted = false;
+  for (int ls = 0; ls < m_max_ls; ls++)
+  {
+    double E = this->trial_move(particles,alpha);
+    if (E <= E0 + m_c1*alpha*slope)
+    {
+      accepted = true;
+      break;
+    }
+    alpha *= 0.5;
+  }
+  
+  if (!accepted)
+  {
+    m_msg->msg(Messenger::WARNING,m_name+" minimiser. Line search failed. Restoring configuration and resetting search direction.");
+    this->trial_move(particles,0.0);
+    this->reset();
+    return;
+  }
+  
+  // Actual displacements (after projection onto the constraint) and new forces
+  m_f_old.swap(m_f);
+  this->collect(particles,m_s,m_f);
+  for (int i = 0; i < N; i++)
+  {
+    double dx = m_s[3*i] - m_x0[3*i], dy = m_s[3*i+1] - m_x0[3*i+1], dz = m_s[3*i+2] - m_x0[3*i+2];
+    m_system->apply_periodic(dx,dy,dz);
+    m_s[3*i] = dx;  m_s[3*i+1] = dy;  m_s[3*i+2] = dz;
+  }
+  
+  this->accept_step(alpha);
+}
+
+/*! Collect positions and forces of all particles in the group. Forces are projected 
+ *  onto the tangent plane using the normal stored with each particle when the 
+ *  constraint was enforced.
+ *  \param particles list of particle ids
+ *  \param x on return contains particle positions
+ *  \param f on return contains tangential components of the forces
+*/
+void IntegratorMinimiser::collect(const vector<int>& particles, vector<double>& x, vector<double>& f)
+{
+  int N = particles.size();
+  x.resize(3*N);
+  f.resize(3*N);
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(particles[i]);
+    double f_dot_N = p.fx*p.Nx + p.fy*p.Ny + p.fz*p.Nz;
+    x[3*i] = p.x;  x[3*i+1] = p.y;  x[3*i+2] = p.z;
+    f[3*i] = p.fx - f_dot_N*p.Nx;  f[3*i+1] = p.fy - f_dot_N*p.Ny;  f[3*i+2] = p.fz - f_dot_N*p.Nz;
+  }
+}
+
+/*! Move all particles from their positions at the beginning of the iteration by 
+ *  alpha along the search direction, project them onto the constraint and recompute 
+ *  forces. Neighbour list is rebuilt if any particle moved too far.
+ *  \param particles list of particle ids
+ *  \param alpha step length
+ *  \return potential energy at the new position
+*/
+double IntegratorMinimiser::trial_move(const vector<int>& particles, double alpha)
+{
+  int N = particles.size();
+  bool planar = m_system->get_box()->planar;
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(particles[i]);
+    p.x = m_x0[3*i] + alpha*m_d[3*i];
+    p.y = m_x0[3*i+1] + alpha*m_d[3*i+1];
+    if (!planar)   // in planar systems particles do not move in the z direction
+      p.z = m_x0[3*i+2] + alpha*m_d[3*i+2];
+    p.ix = m_image[3*i];  p.iy = m_image[3*i+1];  p.iz = m_image[3*i+2];
+  }
+  m_constrainer->enforce(particles);
+  return this->compute_forces();
+}
+
+/*! Update the mesh, rebuild the neighbour list if any particle moved too far 
+ *  and recompute all forces at the current particle positions.
+ *  \return potential energy at the current position
+*/
+double IntegratorMinimiser::compute_forces()
+{
+  m_system->update_mesh();
+  if (m_nlist && m_potential->need_nlist())
+    for (int i = 0; i < m_system->size(); i++)
+      if (m_nlist->need_update(m_system->get_particle(i)))
+      {
+        m_nlist->build();
+        break;
+      }
+  m_system->reset_forces();
+  m_potential->compute(m_dt);
+  return m_potential->compute_potential_energy();
+}
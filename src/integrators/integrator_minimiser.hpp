@@ -0,0 +1,172 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file integrator_minimiser.hpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Declaration of IntegratorMinimiser class
+ */ 
+
+#ifndef __INTEGRATOR_MINIMISER_H__
+#define __INTEGRATOR_MINIMISER_H__
+
+#include <cmath>
+#include <vector>
+
+#include "integrator.hpp"
+
+using std::sqrt;
+using std::fabs;
+using std::min;
+using std::vector;
+
+/*! IntegratorMinimiser is the base class for line search energy minimisers
+ *  (conjugate gradient and L-BFGS). Each call to integrate() performs one 
+ *  iteration of the minimiser, i.e., it computes the search direction and 
+ *  performs backtracking line search along it. Trial positions are projected 
+ *  back onto the constraint after every move and all forces are projected onto
+ *  the tangent plane, so the minimisation is done on the constraint manifold.
+ *  \note No activity. Just minimisation. 
+*/
+class IntegratorMinimiser : public Integrator
+{
+public:
+  
+  //! Constructor
+  //! \param sys Pointer to a System object containing all particles
+  //! \param msg Internal message handler
+  //! \param pot Pairwise and external interaction handler
+  //! \param align Pairwise and external alignment handler
+  //! \param nlist Neighbour list object
+  //! \param cons Enforces constraints to the manifold surface
+  //! \param temp Temperature control object
+  //! \param param Contains information about all parameters 
+  //! \param name Name of the minimiser (used in messages and config)
+  IntegratorMinimiser(SystemPtr sys, MessengerPtr msg, PotentialPtr pot, AlignerPtr align, NeighbourListPtr nlist,  ConstrainerPtr cons, ValuePtr temp, pairs_type& param, const string& name) : Integrator(sys, msg, pot, align, nlist, cons, temp, param),
+                                                                                                                                                                                                m_name(name),
+                                                                                                                                                                                                m_converged(false),
+                                                                                                                                                                                                m_old_energy(1e15)
+  { 
+    if (param.find("f_tolerance") != param.end())
+    {
+      m_msg->msg(Messenger::INFO,m_name+" minimiser f_tolerance set to "+param["f_tolerance"]+".");
+      m_F_tol = lexical_cast<double>(param["f_tolerance"]);
+    }
+    else
+    {
+      m_msg->msg(Messenger::WARNING,m_name+" minimiser f_tolerance not set. Using default value of 1e-4.");
+      m_F_tol = 1e-4;
+    }
+    m_msg->write_config("integrator."+m_name+".F_tol",lexical_cast<string>(m_F_tol));
+    if (param.find("e_tolerance") != param.end())
+    {
+      m_msg->msg(Messenger::INFO,m_name+" minimiser e_tolerance set to "+param["e_tolerance"]+".");
+      m_E_tol = lexical_cast<double>(param["e_tolerance"]);
+    }
+    else
+    {
+      m_msg->msg(Messenger::WARNING,m_name+" minimiser e_tolerance not set. Using default value of 1e-6.");
+      m_E_tol = 1e-6;
+    }
+    m_msg->write_config("integrator."+m_name+".E_tol",lexical_cast<string>(m_E_tol));
+    if (param.find("max_step") != param.end())
+    {
+      m_msg->msg(Messenger::INFO,m_name+" minimiser maximum particle displacement per iteration set to "+param["max_step"]+".");
+      m_max_step = lexical_cast<double>(param["max_step"]);
+    }
+    else
+    {
+      m_msg->msg(Messenger::WARNING,m_name+" minimiser maximum particle displacement per iteration not set. Using default value of 0.1.");
+      m_max_step = 0.1;
+    }
+    m_msg->write_config("integrator."+m_name+".max_step",lexical_cast<string>(m_max_step));
+    if (param.find("max_line_search") != param.end())
+    {
+      m_msg->msg(Messenger::INFO,m_name+" minimiser maximum number of line search steps set to "+param["max_line_search"]+".");
+      m_max_ls = lexical_cast<int>(param["max_line_search"]);
+    }
+    else
+    {
+      m_msg->msg(Messenger::WARNING,m_name+" minimiser maximum number of line search steps not set. Using default value of 20.");
+      m_max_ls = 20;
+    }
+    m_msg->write_config("integrator."+m_name+".max_line_search",lexical_cast<string>(m_max_ls));
+    if (param.find("armijo") != param.end())
+    {
+      m_msg->msg(Messenger::INFO,m_name+" minimiser sufficient decrease (Armijo) parameter set to "+param["armijo"]+".");
+      m_c1 = lexical_cast<double>(param["armijo"]);
+    }
+    else
+    {
+      m_msg->msg(Messenger::WARNING,m_name+" minimiser sufficient decrease (Armijo) parameter not set. Using default value of 1e-4.");
+      m_c1 = 1e-4;
+    }
+    m_msg->write_config("integrator."+m_name+".armijo",lexical_cast<string>(m_c1));
+    m_alpha = m_dt;
+  }
+  
+  //! Perform one iteration of the minimiser
+  void integrate();
+  
+protected:
+  
+  string m_name;                  //!< Name of the minimiser (for messages)
+  vector<double> m_x0;            //!< Positions at the beginning of the iteration
+  vector<double> m_f;             //!< Forces (projected onto tangent planes) at the current positions
+  vector<double> m_f_old;         //!< Forces (projected onto tangent planes) at the beginning of the iteration
+  vector<double> m_s;             //!< Actual displacement of all particles in the last iteration
+  vector<double> m_d;             //!< Search direction
+  double m_alpha;                 //!< Initial step length for the line search
+  
+  //! Compute search direction m_d from the current forces m_f
+  virtual void search_direction() = 0;
+  
+  //! Update internal state of the minimiser after an accepted step (m_s, m_f and m_f_old are set) 
+  virtual void accept_step(double) = 0;
+  
+  //! Forget all information accumulated in previous iterations
+  virtual void reset() = 0;
+  
+private:
+  
+  double m_F_tol;                 //!< Force tolerance for checking convergence 
+  double m_E_tol;                 //!< Energy tolerance for checking convergence 
+  double m_max_step;              //!< Maximum displacement of a particle in one iteration 
+  int    m_max_ls;                //!< Maximum number of backtracking steps in the line search
+  double m_c1;                    //!< Sufficient decrease parameter in the Armijo condition
+  bool   m_converged;             //!< Flag which tests if the method has converged
+  double m_old_energy;            //!< Energy at the beginning of the previous iteration
+  vector<int> m_image;            //!< Periodic image flags at the beginning of the iteration
+  
+  //! Collect positions and tangential forces of all particles in the group
+  void collect(const vector<int>&, vector<double>&, vector<double>&);
+  
+  //! Move particles along the search direction and compute energy and forces at the new position
+  double trial_move(const vector<int>&, double);
+  
+  //! Update mesh and neighbour list and compute energy and forces at the current position
+  double compute_forces();
+  
+};
+
+#endif
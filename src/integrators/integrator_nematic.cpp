@@ -45,7 +45,8 @@
 void IntegratorNematic::integrate()
 {
   int N = m_system->get_group(m_group_name)->get_size();
-  vector<int> particles = m_system->get_group(m_group_name)->get_particles();
+  vector<int>& particles = m_system->get_group(m_group_name)->get_particles();
+  bool planar = m_system->get_box()->planar;
   // reset forces and torques
   m_system->reset_forces();
   m_system->reset_torques();
@@ -53,6 +54,7 @@ void IntegratorNematic::integrate()
   // No need to compute potential, only compute torques in the current configuration
   if (m_align)
     m_align->compute();
+  m_dtheta_rnd.resize(N);
   // iterate over all particles 
   for (int i = 0; i < N; i++)
   {
@@ -67,17 +69,22 @@ void IntegratorNematic::integrate()
     kappa *= m_d0;
     p.x += kappa*p.nx;
     p.y += kappa*p.ny;
-    p.z += kappa*p.nz;
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
-    // Update angular velocity
-    p.omega = m_mu*m_constrainer->project_torque(p);
-    //p.omega = m_dt*m_constraint->project_torque(p);
+    if (!planar)   // in planar systems the z direction is not integrated
+      p.z += kappa*p.nz;
+    // Draw the director noise here to keep the order of random numbers
+    m_dtheta_rnd[i] = m_stoch_coeff*m_rng->gauss_rng(1.0);
+  }
+  // Project everything back to the manifold
+  m_constrainer->enforce(particles);
+  // Update angular velocity
+  m_constrainer->project_torque(particles,m_dtheta);
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(particles[i]);
+    p.omega = m_mu*m_dtheta[i];
     // Change orientation of the director (in the tangent plane) according to eq. (1b)
-    double dtheta = m_dt*p.omega + m_stoch_coeff*m_rng->gauss_rng(1.0);
-    //double dtheta = m_dt*m_constraint->project_torque(p) + m_stoch_coeff*m_rng->gauss_rng(1.0);
-    m_constrainer->rotate_director(p,dtheta);
-    //p.omega = dtheta*m_dt;
+    m_dtheta[i] = m_dt*p.omega + m_dtheta_rnd[i];
     p.age += m_dt;
   }
+  m_constrainer->rotate_director(particles,m_dtheta);
 }
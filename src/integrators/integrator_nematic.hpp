@@ -114,6 +114,8 @@ private:
   double  m_nu;           //!< Rotational diffusion
   double  m_mu;           //!< Mobility
   double  m_stoch_coeff;  //!< Factor for the stochastic part of the equation of motion (\f$ = \nu \sqrt{dt} \f$)
+  vector<double> m_dtheta;      //!< Per particle angle changes (kept between steps to avoid reallocation)
+  vector<double> m_dtheta_rnd;  //!< Stochastic part of the per particle angle changes
   
 };
 
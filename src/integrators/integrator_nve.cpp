@@ -37,7 +37,8 @@
 void IntegratorNVE::integrate()
 {
   int N = m_system->get_group(m_group_name)->get_size();
-  vector<int> particles = m_system->get_group(m_group_name)->get_particles();
+  vector<int>& particles = m_system->get_group(m_group_name)->get_particles();
+  bool planar = m_system->get_box()->planar;   // in planar systems the z direction is not integrated
   double dt_2 = 0.5*m_dt;
   
   
@@ -49,12 +50,15 @@ void IntegratorNVE::integrate()
     //Particle& p = m_system->get_particle(i);
     p.vx += dt_2*p.fx;
     p.vy += dt_2*p.fy;
-    p.vz += dt_2*p.fz;
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
-    // Update angular velocity
-    p.omega += dt_2*m_constrainer->project_torque(p);
+    if (!planar)
+      p.vz += dt_2*p.fz;
   }
+  // Project everything back to the manifold
+  m_constrainer->enforce(particles);
+  m_constrainer->project_torque(particles,m_dtheta);
+  // Update angular velocity
+  for (int i = 0; i < N; i++)
+    m_system->get_particle(particles[i]).omega += dt_2*m_dtheta[i];
   // update position
   for (int i = 0; i < N; i++)
   {
@@ -76,10 +80,11 @@ void IntegratorNVE::integrate()
     }
     p.x += dx;
     p.y += dy; 
-    p.z += dz;
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
+    if (!planar)
+      p.z += dz;
   }
+  // Project everything back to the manifold
+  m_constrainer->enforce(particles);
 
   // Enforce constraints and update alignment
   for (int i = 0; i < N; i++)
@@ -92,9 +97,10 @@ void IntegratorNVE::integrate()
     if (m_has_theta_limit)
       if (fabs(dtheta) > m_theta_limit)
         dtheta = SIGN(dtheta)*m_theta_limit;
-    m_constrainer->rotate_director(p,dtheta);
+    m_dtheta[i] = dtheta;
     //p.omega = dtheta*m_dt;
   }
+  m_constrainer->rotate_director(particles,m_dtheta);
 
   // reset forces and torques
   m_system->reset_forces();
@@ -115,7 +121,8 @@ void IntegratorNVE::integrate()
     //Particle& p = m_system->get_particle(i);
     p.vx += dt_2*p.fx;
     p.vy += dt_2*p.fy;
-    p.vz += dt_2*p.fz;
+    if (!planar)
+      p.vz += dt_2*p.fz;
     // we also need to limit velocity to it does not go crazy
     if (m_has_limit)
     {
@@ -127,10 +134,15 @@ void IntegratorNVE::integrate()
         p.vz = p.vz/v*m_limit/m_dt;
       }
     }
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
-    // Update angular velocity
-    p.omega += dt_2*m_constrainer->project_torque(p);
+  }
+  // Project everything back to the manifold
+  m_constrainer->enforce(particles);
+  // Update angular velocity
+  m_constrainer->project_torque(particles,m_dtheta);
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(particles[i]);
+    p.omega += dt_2*m_dtheta[i];
     if (m_has_limit)
       if (fabs(p.omega)*m_dt > m_theta_limit)
         p.omega = SIGN(p.omega)*m_theta_limit/m_dt;
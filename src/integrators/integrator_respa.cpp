@@ -0,0 +1,163 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file integrator_respa.cpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Implementation of the multiple time step (RESPA) integrator.
+ */ 
+
+#include "integrator_respa.hpp"
+
+/*! This is the reversible RESPA integrator (Tuckerman, Berne and Martyna, J. Chem. Phys. 97, 1990 (1992)).
+ *  Time step \f$ \Delta t \f$ consists of a half kick with the slow forces, \f$ n \f$ velocity 
+ *  Verlet steps of size \f$ \Delta t/n \f$ with fast forces only, and another half kick with the slow
+ *  forces computed in the new configuration.
+ *  Force on each particle (p.fx, p.fy, p.fz) always holds the total force, while slow 
+ *  forces are kept separately in m_f_slow, so fast forces are the difference of the two.
+**/
+void IntegratorRESPA::integrate()
+{
+  int N = m_system->get_group(m_group_name)->get_size();
+  vector<int>& particles = m_system->get_group(m_group_name)->get_particles();
+  double dt_2 = 0.5*m_dt;
+  double h = m_dt/m_inner_steps;
+  double h_2 = 0.5*h;
+  bool planar = m_system->get_box()->planar;
+  
+  // On the first step (or if the system size changed) we need to split the forces
+  if (static_cast<int>(m_f_slow.size()) != 3*m_system->size())
+    this->compute_forces();
+  
+  // First half step with slow forces
+  this->slow_kick(particles,dt_2);
+  
+  // Inner loop with fast forces
+  for (int k = 0; k < m_inner_steps; k++)
+  {
+    for (int i = 0; i < N; i++)
+    {
+      int pi = particles[i];
+      Particle& p = m_system->get_particle(pi);
+      p.vx += h_2*(p.fx - m_f_slow[3*pi]);
+      p.vy += h_2*(p.fy - m_f_slow[3*pi+1]);
+      p.x += h*p.vx;
+      p.y += h*p.vy;
+      if (!planar)   // in planar systems the z direction is not integrated
+      {
+        p.vz += h_2*(p.fz - m_f_slow[3*pi+2]);
+        p.z += h*p.vz;
+      }
+    }
+    // Project everything back to the manifold
+    m_constrainer->enforce(particles);
+    // Recompute fast forces on top of the slow ones
+    if (m_potential)
+    {
+      for (int i = 0; i < m_system->size(); i++)
+      {
+        Particle& p = m_system->get_particle(i);
+        p.fx = m_f_slow[3*i];  p.fy = m_f_slow[3*i+1];  p.fz = m_f_slow[3*i+2];
+      }
+      m_potential->compute_bonded();
+    }
+    for (int i = 0; i < N; i++)
+    {
+      int pi = particles[i];
+      Particle& p = m_system->get_particle(pi);
+      p.vx += h_2*(p.fx - m_f_slow[3*pi]);
+      p.vy += h_2*(p.fy - m_f_slow[3*pi+1]);
+      if (!planar)
+        p.vz += h_2*(p.fz - m_f_slow[3*pi+2]);
+    }
+  }
+  
+  // Rotate directors
+  for (int i = 0; i < N; i++)
+    m_omega[i] = m_dt*m_system->get_particle(particles[i]).omega;
+  m_constrainer->rotate_director(particles,m_omega);
+  
+  // Compute all forces and torques in the new configuration
+  this->compute_forces();
+  
+  // Second half step with slow forces
+  this->slow_kick(particles,dt_2);
+  for (int i = 0; i < N; i++)
+    m_system->get_particle(particles[i]).age += m_dt;
+  
+  // Update vertex mesh
+  m_system->update_mesh();
+}
+
+/*! Compute all forces and torques. Slow forces are stored 
+ *  in m_f_slow before fast forces are added on top of them.
+ *  Slow forces are projected onto the constraint before they are stored, 
+ *  so that later projections of the total force (e.g. in slow_kick) do not 
+ *  leave a spurious component in the difference between total and slow force.
+**/
+void IntegratorRESPA::compute_forces()
+{
+  int N = m_system->size();
+  m_f_slow.resize(3*N);
+  
+  m_system->reset_forces();
+  m_system->reset_torques();
+  if (m_potential)
+    m_potential->compute_nonbonded(m_dt);
+  m_constrainer->enforce(m_system->get_group(m_group_name)->get_particles());
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(i);
+    m_f_slow[3*i] = p.fx;  m_f_slow[3*i+1] = p.fy;  m_f_slow[3*i+2] = p.fz;
+  }
+  if (m_potential)
+    m_potential->compute_bonded();
+  if (m_align)
+    m_align->compute();
+}
+
+/*! Update velocities with the slow forces and angular velocities with 
+ *  torques over a given time interval. 
+ *  \param particles list of particles to update
+ *  \param dt time interval
+**/
+void IntegratorRESPA::slow_kick(const vector<int>& particles, double dt)
+{
+  int N = particles.size();
+  bool planar = m_system->get_box()->planar;
+  for (int i = 0; i < N; i++)
+  {
+    int pi = particles[i];
+    Particle& p = m_system->get_particle(pi);
+    p.vx += dt*m_f_slow[3*pi];
+    p.vy += dt*m_f_slow[3*pi+1];
+    if (!planar)   // in planar systems the z direction is not integrated
+      p.vz += dt*m_f_slow[3*pi+2];
+  }
+  // Project everything back to the manifold
+  m_constrainer->enforce(particles);
+  // Update angular velocity
+  m_constrainer->project_torque(particles,m_omega);
+  for (int i = 0; i < N; i++)
+    m_system->get_particle(particles[i]).omega += dt*m_omega[i];
+}
@@ -0,0 +1,103 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file integrator_respa.hpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Declaration of IntegratorRESPA class
+ */ 
+
+#ifndef __INTEGRATOR_RESPA_H__
+#define __INTEGRATOR_RESPA_H__
+
+#include <cmath>
+#include <vector>
+
+#include "integrator.hpp"
+
+using std::sqrt;
+using std::vector;
+
+/*! IntegratorRESPA class handles NVE dynamics with multiple time steps (reversible RESPA).
+ *  Forces are split into fast (bonds and angles) and slow (pair and external potentials).
+ *  Slow forces and torques are computed once per time step, while fast forces are integrated 
+ *  with the velocity Verlet scheme on an inner loop with step size dt/inner_steps. 
+ *  Pair potentials and neighbour list checks are thus done once every inner_steps inner steps.
+ *  \note No activity. Pure MD.
+*/
+class IntegratorRESPA : public Integrator
+{
+public:
+  
+  //! Constructor
+  //! \param sys Pointer to a System object containing all particles
+  //! \param msg Internal message handler
+  //! \param pot Pairwise and external interaction handler
+  //! \param align Pairwise and external alignment handler
+  //! \param nlist Neighbour list object
+  //! \param cons Enforces constraints to the manifold surface
+  //! \param temp Temperature control object
+  //! \param param Contains information about all parameters 
+  IntegratorRESPA(SystemPtr sys, MessengerPtr msg, PotentialPtr pot, AlignerPtr align, NeighbourListPtr nlist,  ConstrainerPtr cons, ValuePtr temp, pairs_type& param) : Integrator(sys, msg, pot, align, nlist, cons, temp, param)
+  { 
+    m_msg->write_config("integrator.respa","");
+    if (param.find("inner_steps") != param.end())
+    {
+      m_msg->msg(Messenger::INFO,"RESPA integrator. Number of inner steps (for bond and angle forces) per time step set to "+param["inner_steps"]+".");
+      m_inner_steps = lexical_cast<int>(param["inner_steps"]);
+    }
+    else
+    {
+      m_msg->msg(Messenger::WARNING,"RESPA integrator. Number of inner steps (for bond and angle forces) per time step not set. Using default value of 5.");
+      m_inner_steps = 5;
+    }
+    if (m_inner_steps < 1)
+    {
+      m_msg->msg(Messenger::ERROR,"RESPA integrator. Number of inner steps has to be at least 1.");
+      throw runtime_error("RESPA integrator. Illegal number of inner steps.");
+    }
+    m_msg->write_config("integrator.respa.inner_steps",lexical_cast<string>(m_inner_steps));
+    if (m_potential && !m_potential->has_bonded())
+      m_msg->msg(Messenger::WARNING,"RESPA integrator. There are no bond or angle potentials. This is equivalent to the NVE integrator with additional overhead.");
+  }
+  
+  //! Propagate system for a time step
+  void integrate();
+  
+private:
+  
+  int m_inner_steps;              //!< Number of inner (fast force) steps per time step
+  vector<double> m_f_slow;        //!< Slow (pair and external) forces on all particles in the system
+  vector<double> m_omega;         //!< Projected torques (used to update angular velocities)
+  
+  //! Compute slow and fast forces in the current configuration
+  void compute_forces();
+  
+  //! Update velocities and angular velocities using slow forces and torques
+  void slow_kick(const vector<int>&, double);
+  
+};
+
+typedef shared_ptr<IntegratorRESPA> IntegratorRESPAPtr;
+
+#endif
@@ -37,7 +37,8 @@
 void IntegratorSepulveda::integrate()
 {
   int N = m_system->get_group(m_group_name)->get_size();
-  vector<int> particles = m_system->get_group(m_group_name)->get_particles();
+  vector<int>& particles = m_system->get_group(m_group_name)->get_particles();
+  bool planar = m_system->get_box()->planar;   // in planar systems the z direction is not integrated
   double dt_2 = 0.5*m_dt;
   double B = sqrt(m_tau*m_dt);
   double theta = 1.0 - m_dt;
@@ -51,12 +52,15 @@ void IntegratorSepulveda::integrate()
     //Particle& p = m_system->get_particle(i);
     p.vx += dt_2*(p.fx + m_eta_x[i])/p.mass;
     p.vy += dt_2*(p.fy + m_eta_y[i])/p.mass;
-    p.vz += dt_2*(p.fz + m_eta_z[i])/p.mass;
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
-    // Update angular velocity
-    p.omega += dt_2*m_constrainer->project_torque(p);
+    if (!planar)
+      p.vz += dt_2*(p.fz + m_eta_z[i])/p.mass;
   }
+  // Project everything back to the manifold
+  m_constrainer->enforce(particles);
+  // Update angular velocity
+  m_constrainer->project_torque(particles,m_dtheta);
+  for (int i = 0; i < N; i++)
+    m_system->get_particle(particles[i]).omega += dt_2*m_dtheta[i];
   // Generalized Langevin Dynamics, pg. 377 step 2 
   // update position
   for (int i = 0; i < N; i++)
@@ -66,10 +70,11 @@ void IntegratorSepulveda::integrate()
     //Particle& p = m_system->get_particle(i);
     p.x += m_dt*p.vx;
     p.y += m_dt*p.vy;
-    p.z += m_dt*p.vz;
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
+    if (!planar)
+      p.z += m_dt*p.vz;
   }
+  // Project everything back to the manifold
+  m_constrainer->enforce(particles);
   // Generalized Langevin Dynamics, pg. 377 step 3
   // Orstein-Uhlenbeck for etas
   // Note: in the book what we call m_alpha is called c_k
@@ -92,7 +97,8 @@ void IntegratorSepulveda::integrate()
     // ------------------------------
     m_eta_x[i] = theta*m_eta_x[i] + (1-theta)*(-m_alpha*p.vx + dvx) + B*m_rng->gauss_rng(1.0);
     m_eta_y[i] = theta*m_eta_y[i] + (1-theta)*(-m_alpha*p.vy + dvy) + B*m_rng->gauss_rng(1.0);
-    m_eta_z[i] = theta*m_eta_z[i] + (1-theta)*(-m_alpha*p.vz + dvz) + B*m_rng->gauss_rng(1.0);
+    if (!planar)
+      m_eta_z[i] = theta*m_eta_z[i] + (1-theta)*(-m_alpha*p.vz + dvz) + B*m_rng->gauss_rng(1.0);
   }
 
   // Enforce constraints and update alignment
@@ -102,10 +108,10 @@ void IntegratorSepulveda::integrate()
     Particle& p = m_system->get_particle(pi);
     //Particle& p = m_system->get_particle(i);
     // Change orientation of the velocity (in the tangent plane) according to eq. (1b)
-    double dtheta = m_dt*p.omega; //m_constraint->project_torque(p);
-    m_constrainer->rotate_director(p,dtheta);
+    m_dtheta[i] = m_dt*p.omega; //m_constraint->project_torque(p);
     //p.omega = dtheta*m_dt;
   }
+  m_constrainer->rotate_director(particles,m_dtheta);
 
   // reset forces and torques
   m_system->reset_forces();
@@ -128,14 +134,16 @@ void IntegratorSepulveda::integrate()
     //Particle& p = m_system->get_particle(i);
     p.vx += dt_2*(p.fx + m_eta_x[i])/p.mass;
     p.vy += dt_2*(p.fy + m_eta_y[i])/p.mass;
-    p.vz += dt_2*(p.fz + m_eta_z[i])/p.mass;
-    
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
-    // Update angular velocity
-    p.omega += dt_2*m_constrainer->project_torque(p);
+    if (!planar)
+      p.vz += dt_2*(p.fz + m_eta_z[i])/p.mass;
     p.age += m_dt;
   }
+  // Project everything back to the manifold
+  m_constrainer->enforce(particles);
+  // Update angular velocity
+  m_constrainer->project_torque(particles,m_dtheta);
+  for (int i = 0; i < N; i++)
+    m_system->get_particle(particles[i]).omega += dt_2*m_dtheta[i];
   // Update vertex mesh
   m_system->update_mesh();
 }
@@ -148,6 +148,7 @@ private:
   vector<double>  m_eta_x;      //!< Normally distributed random numbers for BBK integrator
   vector<double>  m_eta_y;      //!< Normally distributed random numbers for BBK integrator
   vector<double>  m_eta_z;      //!< Normally distributed random numbers for BBK integrator
+  vector<double>  m_dtheta;     //!< Per particle angle changes (kept between steps to avoid reallocation)
 
 
 };
@@ -45,7 +45,8 @@ void IntegratorVicsek::integrate()
 {
   double noise = m_eta*sqrt(m_dt);
   int N = m_system->get_group(m_group_name)->get_size();
-  vector<int> particles = m_system->get_group(m_group_name)->get_particles();
+  vector<int>& particles = m_system->get_group(m_group_name)->get_particles();
+  bool planar = m_system->get_box()->planar;
   
   // reset forces and torques
   m_system->reset_forces();
@@ -57,6 +58,7 @@ void IntegratorVicsek::integrate()
   // compute torques in the current configuration
   if (m_align)
     m_align->compute();
+  m_dtheta.resize(N);
   // iterate over all particles 
   for (int i = 0; i < N; i++)
   {
@@ -65,18 +67,26 @@ void IntegratorVicsek::integrate()
     // Update particle velocity 
     p.vx = m_v0*p.tau_x + m_mu*p.fx;
     p.vy = m_v0*p.tau_y + m_mu*p.fy;
-    p.vz = m_v0*p.tau_z + m_mu*p.fz;
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
-    // Change orientation of the velocity (in the tangent plane) 
-    double theta = 2.0*noise*M_PI*(m_rng->drnd() - 0.5);
-    m_constrainer->rotate_velocity(p,theta);
+    if (!planar)   // in planar systems the z direction is not integrated
+      p.vz = m_v0*p.tau_z + m_mu*p.fz;
+    // Random rotation angle of the velocity (in the tangent plane) 
+    m_dtheta[i] = 2.0*noise*M_PI*(m_rng->drnd() - 0.5);
+  }
+  // Project everything back to the manifold
+  m_constrainer->enforce(particles);
+  // Change orientation of the velocity (in the tangent plane) 
+  m_constrainer->rotate_velocity(particles,m_dtheta);
+  for (int i = 0; i < N; i++)
+  {
+    int pi = particles[i];
+    Particle& p = m_system->get_particle(pi);
     // Update particle position 
     p.x += m_dt*p.vx;
     p.y += m_dt*p.vy;
-    p.z += m_dt*p.vz;
-    // Project everything back to the manifold
-    m_constrainer->enforce(p);
+    if (!planar)
+      p.z += m_dt*p.vz;
     p.age += m_dt;
   }
+  // Project everything back to the manifold
+  m_constrainer->enforce(particles);
 }
@@ -112,6 +112,7 @@ private:
   double  m_eta;          //!< Random noise distribution width
   double  m_mu;           //!< Mobility 
   double  m_v0;       //!< velocity magnitude
+  vector<double> m_dtheta;  //!< Per particle velocity rotation angles (kept between steps to avoid reallocation)
   
 };
 
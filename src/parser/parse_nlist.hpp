@@ -0,0 +1,72 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file parse_nlist.hpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Grammar for the parsing neighbour list command lines
+ */ 
+
+#ifndef __PARSE_NLIST_HPP__
+#define __PARSE_NLIST_HPP__
+
+#include <string>
+
+#include "parse_aux.hpp"
+
+/*! Control data structure for passing around parsed information. */
+struct NlistData
+{
+  std::string name;     //!< contains name of the neighbour list (empty for the global list)
+  std::string params;   //!< parameters of the neighbour list, such as cutoff and padding distance
+};
+
+/*! This is a parser for parsing command that contain neighbour list directives.
+ *
+ *  For example:
+ * 
+ *  nlist { rcut = 1.5; pad = 0.5 }
+ *  nlist long { rcut = 4.0; pad = 1.0 }
+ *  nlist short { rcut = 1.5; pad = 0.5; parent = long }
+ * 
+ * This parser will extract the (optional) list name (in this case "long" and "short")
+ * and return the rest of the line for post-processing. List without name is the 
+ * global neighbour list.
+ */
+class nlist_grammar : public qi::grammar<std::string::iterator, qi::space_type>
+{
+public:
+  nlist_grammar(NlistData& nlist_data) : nlist_grammar::base_type(nlist)
+  {
+    nlist = -(qi::as_string[+qi::char_("a-zA-Z_0-9.")][phx::bind(&NlistData::name, phx::ref(nlist_data)) = qi::_1 ])
+                >> qi::as_string[qi::no_skip[+qi::char_]][phx::bind(&NlistData::params, phx::ref(nlist_data)) = qi::_1 ]
+                >> (qi::eol || qi::eoi);
+  }
+  
+private:
+  
+  qi::rule<std::string::iterator, qi::space_type> nlist;  //!< Rule for parsing neighbour list lines
+  
+};
+
+#endif
@@ -85,7 +85,7 @@ public:
   //! Set neighbour list. 
   //! \note Neighbour list is not set in the contructor because some models do not require it. 
   //! This is a bit clumsy but gives us more flexibility
-  void set_nlist(NeighbourListPtr nlist) 
+  virtual void set_nlist(NeighbourListPtr nlist) 
   {
     m_nlist = nlist;
     m_has_nlist = true;
@@ -119,6 +119,8 @@ protected:
   int m_l_rescale_steps;         //!< Rescale particle length over this many steps
   double m_l_scale;              //!< Rescale particle length by this much in each step (=m_l_rescale**(m_grow_l_freq/m_l_rescale_steps))
   bool m_has_nlist;              //!< If true, population has neighbour list set
+  vector<int> m_particles;       //!< Copy of the group particle list used while dividing (storage reused between steps)
+  vector<int> m_to_remove;       //!< Particles to remove in the current step (storage reused between steps)
    
 };
 
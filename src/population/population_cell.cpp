@@ -85,8 +85,12 @@ void PopulationCell::divide(int t)
     }
     double fact = m_freq*m_div_rate*m_system->get_integrator_step();
     Mesh& mesh = m_system->get_mesh();
+    // Cells can be inserted locally only if the mesh is up to date 
+    bool force_mesh_rebuild = m_system->get_force_mesh_rebuild();
+    bool local = m_local_remesh && !force_mesh_rebuild && mesh.size() == m_system->size();
     int N = m_system->get_group(m_group_name)->get_size();
-    vector<int> particles = m_system->get_group(m_group_name)->get_particles();
+    m_particles = m_system->get_group(m_group_name)->get_particles();   // copy, since division adds particles to the group
+    vector<int>& particles = m_particles;
     for (int i = 0; i < N; i++)
     {
       int pi = particles[i];
@@ -125,7 +129,20 @@ void PopulationCell::divide(int t)
           p_new.in_tissue = true;
           for(list<string>::iterator it_g = p.groups.begin(); it_g != p.groups.end(); it_g++)
             p_new.add_group(*it_g);
+          int f_new = (local) ? mesh.find_face(pi, Vector3d(p_new.x,p_new.y,p_new.z)) : -1;
           m_system->add_particle(p_new);
+          if (local)
+          {
+            // Insert daughter into the face that contains it and move the mother. The move is accepted 
+            // only if no triangle in mother's star gets inverted. Otherwise fall back to rebuilding the entire mesh.
+            // Delaunay property is restored only once, after all divisions (in update_mesh below).
+            Particle& pm = m_system->get_particle(pi);
+            local = mesh.insert_vertex(m_system->get_particle(p_new.get_id()), f_new);
+            if (local)
+              local = mesh.keeps_orientation(pi, Vector3d(pm.x,pm.y,pm.z));
+            if (local)
+              mesh.update(pm);
+          }
         }
       }
     }
@@ -135,6 +152,12 @@ void PopulationCell::divide(int t)
       throw runtime_error("Group mismatch.");
     }
     m_system->set_force_nlist_rebuild(true);
+    if (local)
+    {
+      // Restore Delaunay property by edge flips around the new cells
+      m_system->set_force_mesh_rebuild(force_mesh_rebuild);
+      m_system->update_mesh();
+    }
   }
 }
 
@@ -157,8 +180,9 @@ void PopulationCell::remove(int t)
       throw runtime_error("Group mismatch.");
     }
     int N = m_system->get_group(m_group_name)->get_size();
-    vector<int> particles = m_system->get_group(m_group_name)->get_particles();
-    vector<int> to_remove;
+    vector<int>& particles = m_system->get_group(m_group_name)->get_particles();
+    vector<int>& to_remove = m_to_remove;
+    to_remove.clear();
     for (int i = 0; i < N; i++)
     {
       int pi = particles[i];
@@ -173,12 +197,7 @@ void PopulationCell::remove(int t)
       if (p.in_tissue && !p.boundary && m_rng->drnd() < prob_death)
           to_remove.push_back(p.get_id());
     }
-    int offset = 0;
-    for (vector<int>::iterator it = to_remove.begin(); it != to_remove.end(); it++)
-    {
-      m_system->remove_particle((*it)-offset);
-      offset++;      
-    }
+    m_system->remove_particles(to_remove);
     if (m_system->size() == 0)
     {
       m_msg->msg(Messenger::ERROR,"Cell population control. No cells left in the system. Please reduce that death rate.");
@@ -204,7 +223,7 @@ void PopulationCell::grow(int t)
   { 
     double fact = m_freq*m_system->get_integrator_step()*m_growth_rate;
     int N = m_system->get_group(m_group_name)->get_size();
-    vector<int> particles = m_system->get_group(m_group_name)->get_particles();
+    vector<int>& particles = m_system->get_group(m_group_name)->get_particles();
     for (int i = 0; i < N; i++)
     {
 	  // Growth probability stays dimensionless, between 0 and 1. Instead, the actual growth rate is no an inverse time
@@ -216,7 +235,11 @@ void PopulationCell::grow(int t)
           p.A0 *= (1.0+fact);
       }
     }
+    // Change of the native area does not change the mesh
+    bool force_mesh_rebuild = m_system->get_force_mesh_rebuild();
     m_system->set_force_nlist_rebuild(true);
+    if (m_local_remesh)
+      m_system->set_force_mesh_rebuild(force_mesh_rebuild);
     if (m_rescale_contacts)
       m_system->set_nlist_rescale(sqrt(1.0+fact));
   }
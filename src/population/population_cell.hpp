@@ -48,6 +48,12 @@ using std::runtime_error;
  *  Particles are always divided along the direction of the orientation vector 
  *  n.
  *
+ *  With local_remesh flag, daughter cells are inserted directly into the mesh 
+ *  and the mesh is only fixed locally by edge flips, i.e. there is no global 
+ *  retriangulation after each division step.
+ *  \note local_remesh only has effect if the neighbour list is built with the 
+ *  incremental_mesh flag. Otherwise the neighbour list rebuilds the mesh every time it is updated.
+ *
 */
 class PopulationCell : public Population
 {
@@ -176,9 +182,29 @@ public:
       m_rescale_contacts = true;
       m_msg->write_config("population.cell.rescale_contacts","true");
     }
+    if (param.find("local_remesh") == param.end())
+    {
+      m_msg->msg(Messenger::INFO,"Cell population control. Mesh will be rebuilt after each division step.");
+      m_local_remesh = false;
+      m_msg->write_config("population.cell.local_remesh","false");
+    }
+    else
+    {
+      m_msg->msg(Messenger::INFO,"Cell population control. New cells will be inserted into the existing mesh. Mesh will only be rebuilt if local insertion fails.");
+      m_local_remesh = true;
+      m_msg->write_config("population.cell.local_remesh","true");
+    }
     
   }
   
+  //! Set neighbour list and check that it supports local remeshing
+  void set_nlist(NeighbourListPtr nlist) 
+  {
+    Population::set_nlist(nlist);
+    if (m_local_remesh && !nlist->has_incremental_mesh())
+      m_msg->msg(Messenger::WARNING,"Cell population control. Neighbour list does not have incremental_mesh flag set. Mesh will be rebuilt after each division step and local_remesh has no effect.");
+  }
+  
   //! Particle division (emulates cell division)
   void divide(int);
   
@@ -207,6 +233,7 @@ private:
   double m_growth_rate;          //!< growth (scaling) factor for the cell native area in each time step
   double m_growth_prob;          //!< probability that a cell grows in a given time step
   bool m_rescale_contacts;       //!< If true, resacle neigbour list contacnt distance as well as contact distance
+  bool m_local_remesh;           //!< If true, divided cells are inserted into the existing mesh instead of rebuilding it
   
 };
 
@@ -40,7 +40,7 @@ void PopulationElongation::elongate(int t)
   if (m_freq > 0 && t % m_freq == 0 && t < m_rescale_steps && m_rescale != 1.0) 
   { 
     int N = m_system->get_group(m_group_name)->get_size();
-    vector<int> particles = m_system->get_group(m_group_name)->get_particles();
+    vector<int>& particles = m_system->get_group(m_group_name)->get_particles();
     for (int i = 0; i < N; i++)
     {
       int pi = particles[i];
@@ -50,7 +50,8 @@ void PopulationRandom::divide(int t)
     int new_type;   // type of new particle
     double new_r;   // radius of newly formed particle
     int N = m_system->get_group(m_group_name)->get_size();
-    vector<int> particles = m_system->get_group(m_group_name)->get_particles();
+    m_particles = m_system->get_group(m_group_name)->get_particles();   // copy, since division adds particles to the group
+    vector<int>& particles = m_particles;
     bool periodic = m_system->get_periodic();
     BoxPtr box = m_system->get_box();
     double prob_div = m_div_rate*m_freq*m_system->get_integrator_step(); // actual probability of dividing now: rate * (attempt_freq * dt)
@@ -146,8 +147,9 @@ void PopulationRandom::remove(int t)
   if (m_freq > 0 && t % m_freq == 0)  // Attempt removal only at certain time steps
   { 
     int N = m_system->get_group(m_group_name)->get_size();
-    vector<int> particles = m_system->get_group(m_group_name)->get_particles();
-    vector<int> to_remove;
+    vector<int>& particles = m_system->get_group(m_group_name)->get_particles();
+    vector<int>& to_remove = m_to_remove;
+    to_remove.clear();
     double prob_death = m_death_rate*m_freq*m_system->get_integrator_step(); // actual probability of dividing now: rate * (attempt_freq * dt)
     if (prob_death>1.0)
     {
@@ -161,12 +163,7 @@ void PopulationRandom::remove(int t)
       if (m_rng->drnd() < p.age*prob_death)
         to_remove.push_back(p.get_id());
     }
-    int offset = 0;
-    for (vector<int>::iterator it = to_remove.begin(); it != to_remove.end(); it++)
-    {
-      m_system->remove_particle((*it)-offset);
-      offset++;      
-    }
+    m_system->remove_particles(to_remove);
     if (m_system->size() == 0)
     {
       m_msg->msg(Messenger::ERROR,"Random population control. No particles left in the system. Please reduce that death rate.");
@@ -50,8 +50,9 @@ void PopulationRegion::remove(int t)
       throw runtime_error("Group mismatch.");
     }
     int N = m_system->get_group(m_group_name)->get_size();
-    vector<int> particles = m_system->get_group(m_group_name)->get_particles();
-    vector<int> to_remove;
+    vector<int>& particles = m_system->get_group(m_group_name)->get_particles();
+    vector<int>& to_remove = m_to_remove;
+    to_remove.clear();
     for (int i = 0; i < N; i++)
     {
       int pi = particles[i];
@@ -71,12 +72,7 @@ void PopulationRegion::remove(int t)
           to_remove.push_back(p.get_id());
       }
     }
-    int offset = 0;
-    for (vector<int>::iterator it = to_remove.begin(); it != to_remove.end(); it++)
-    {
-      m_system->remove_particle((*it)-offset);
-      offset++;      
-    }
+    m_system->remove_particles(to_remove);
     if (m_system->size() == 0)
     {
       m_msg->msg(Messenger::ERROR,"Region population control. No cells left in the system. Please make sure that the allowed region is large enough.");
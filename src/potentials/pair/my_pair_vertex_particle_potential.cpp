@@ -88,7 +88,7 @@ void MyPairVertexParticlePotential::compute(double dt)
     double H_Ls = 6.73 / 6.0;
     /*--------------------------   ----------- PARAMETERS SETTING DONE--------------------------------------------------*/
 
-    if (m_mesh_update_steps > 0) if (m_system->get_step() % m_mesh_update_steps == 0) m_nlist->build_mesh();
+    if (m_mesh_update_steps > 0) if (m_system->get_step() % m_mesh_update_steps == 0) m_nlist->refresh_mesh();
 
     Mesh& mesh = m_system->get_mesh();
 
@@ -29,6 +29,8 @@
 
 #include "pair_boundary_attraction_potential.hpp"
 
+//! Name under which per particle energy is stored (kept as a string object to avoid building it on every call)
+static const string pot_energy_name("boundary_attraction");
 
 //! \param dt time step sent by the integrator 
 void PairBoundaryAttractionPotential::compute(double dt)
@@ -44,49 +46,49 @@ void PairBoundaryAttractionPotential::compute(double dt)
     for  (int i = 0; i < N; i++)
     {
       Particle& p = m_system->get_particle(i);
-      p.set_pot_energy("boundary_attraction",0.0);
+      p.set_pot_energy(pot_energy_name,0.0);
     }
   }
   
   m_potential_energy = 0.0;
-  for (int v = 0; v < mesh.size(); v++)
+  vector<int>& boundary_vertices = mesh.get_boundary_vertices();
+  BoundaryGeometry& geom = m_system->get_boundary_geometry();
+  for (unsigned int v = 0; v < boundary_vertices.size(); v++)
   {
-    Vertex& Vi = mesh.get_vertices()[v];
-    if (Vi.boundary)
+    Vertex& Vi = mesh.get_vertices()[boundary_vertices[v]];
+    Particle& pi = m_system->get_particle(Vi.id);
+    for (int j = 0; j < Vi.n_edges; j++)
     {
-      Particle& pi = m_system->get_particle(Vi.id);
-      for (int j = 0; j < Vi.n_edges; j++)
+      Vertex& Vj = mesh.get_vertices()[Vi.neigh[j]];
+      if (!(Vj.boundary && m_exclude_boundary))
       {
-        Vertex& Vj = mesh.get_vertices()[Vi.neigh[j]];
-        if (!(Vj.boundary && m_exclude_boundary))
+        Particle& pj = m_system->get_particle(Vj.id);
+        if (m_has_pair_params)
         {
-          Particle& pj = m_system->get_particle(Vj.id);
-          if (m_has_pair_params)
-          {
-            epsilon = m_pair_params[pi.get_type()-1][pj.get_type()-1].epsilon;
-            rc = m_pair_params[pi.get_type()-1][pj.get_type()-1].rc;
-            wc = m_pair_params[pi.get_type()-1][pj.get_type()-1].wc;
-          }
-          double dx = pi.x - pj.x, dy = pi.y - pj.y, dz = pi.z - pj.z;
-          m_system->apply_periodic(dx,dy,dz);
-          double r = sqrt(dx*dx + dy*dy + dz*dz);
-          if (r >= rc && r <= (rc+wc))
+          epsilon = m_pair_params[pi.get_type()-1][pj.get_type()-1].epsilon;
+          rc = m_pair_params[pi.get_type()-1][pj.get_type()-1].rc;
+          wc = m_pair_params[pi.get_type()-1][pj.get_type()-1].wc;
+        }
+        // Star vectors point from pi to pj
+        Vector3d& r_ij = geom.star_vec[geom.star_start[v] + j];
+        double dx = -r_ij.x, dy = -r_ij.y, dz = -r_ij.z;
+        double r = geom.star_len[geom.star_start[v] + j];
+        if (r >= rc && r <= (rc+wc))
+        {
+          double cos_fac = cos(0.5*M_PI*(r-rc)/wc);
+          double potential_energy = -epsilon*cos_fac*cos_fac;
+          m_potential_energy += potential_energy;
+          double fact = -0.5*M_PI*epsilon/wc*sin(M_PI*(r-rc)/wc)/r;
+          pi.fx += fact*dx;
+          pi.fy += fact*dy;
+          pi.fz += fact*dz;
+          pj.fx -= fact*dx;
+          pj.fy -= fact*dy;
+          pj.fz -= fact*dz;
+          if (m_system->compute_per_particle_energy())
           {
-            double cos_fac = cos(0.5*M_PI*(r-rc)/wc);
-            double potential_energy = -epsilon*cos_fac*cos_fac;
-            m_potential_energy += potential_energy;
-            double fact = -0.5*M_PI*epsilon/wc*sin(M_PI*(r-rc)/wc)/r;
-            pi.fx += fact*dx;
-            pi.fy += fact*dy;
-            pi.fz += fact*dz;
-            pj.fx -= fact*dx;
-            pj.fy -= fact*dy;
-            pj.fz -= fact*dz;
-            if (m_system->compute_per_particle_energy())
-            {
-              pi.add_pot_energy("boundary_attraction",potential_energy);
-              pj.add_pot_energy("boundary_attraction",potential_energy);
-            }
+            pi.add_pot_energy(pot_energy_name,potential_energy);
+            pj.add_pot_energy(pot_energy_name,potential_energy);
           }
         }
       }
@@ -29,6 +29,8 @@
 
 #include "pair_boundary_bending_potential.hpp"
 
+//! Name under which per particle energy is stored (kept as a string object to avoid building it on every call)
+static const string pot_energy_name("boundary_bending");
 
 //! \param dt time step sent by the integrator 
 void PairBoundaryBendingPotential::compute(double dt)
@@ -43,30 +45,32 @@ void PairBoundaryBendingPotential::compute(double dt)
     for  (int i = 0; i < N; i++)
     {
       Particle& p = m_system->get_particle(i);
-      p.set_pot_energy("boundary_bending",0.0);
+      p.set_pot_energy(pot_energy_name,0.0);
     }
   }
   
   m_potential_energy = 0.0;
-  for (int v = 0; v < mesh.size(); v++)
+  vector<int>& boundary_vertices = mesh.get_boundary_vertices();
+  BoundaryGeometry& geom = m_system->get_boundary_geometry();
+  for (unsigned int v = 0; v < boundary_vertices.size(); v++)
   {
-    Vertex& V = mesh.get_vertices()[v];
-    if (V.boundary && V.attached)
+    Vertex& V = mesh.get_vertices()[boundary_vertices[v]];
+    if (V.attached)
     {
-      Vertex& Vm = mesh.get_vertices()[V.neigh[0]];
-      Vertex& Vp = mesh.get_vertices()[V.neigh[V.n_edges-1]];
+      // Star of a boundary vertex starts and ends with its two boundary neighbours
+      int sm = geom.star_start[v], sp = geom.star_start[v] + V.n_edges - 1;
       Particle& p  = m_system->get_particle(V.id);
-      Particle& pm = m_system->get_particle(Vm.id);
-      Particle& pp = m_system->get_particle(Vp.id);
+      Particle& pm = m_system->get_particle(V.neigh[0]);
+      Particle& pp = m_system->get_particle(V.neigh[V.n_edges-1]);
       if (m_has_part_params)
       {
         kappa = m_particle_params[p.get_type() - 1].kappa;
         theta0 = m_particle_params[p.get_type() - 1].theta0;
       }
-      Vector3d r_pm_p = Vm.r - V.r;
-      Vector3d r_pp_p = Vp.r - V.r;
-      double r_pm_p_len = r_pm_p.len();
-      double r_pp_p_len = r_pp_p.len();
+      Vector3d& r_pm_p = geom.star_vec[sm];
+      Vector3d& r_pp_p = geom.star_vec[sp];
+      double r_pm_p_len = geom.star_len[sm];
+      double r_pp_p_len = geom.star_len[sp];
       double denom = 1.0/(r_pm_p_len*r_pp_p_len);
       double denom_2 = denom*denom;
       double vec_dot = dot(r_pm_p,r_pp_p);
@@ -0,0 +1,436 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file pair_ewald_potential.cpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Implementation of PairEwaldPotential class
+ */ 
+
+#include "pair_ewald_potential.hpp"
+
+//! Returns the smallest number not smaller than n which has only 2, 3 and 5 as prime factors (FFT friendly size)
+static int next_fft_size(int n)
+{
+  for (int k = n; ; k++)
+  {
+    int m = k;
+    while (m % 2 == 0) m /= 2;
+    while (m % 3 == 0) m /= 3;
+    while (m % 5 == 0) m /= 5;
+    if (m == 1) return k;
+  }
+}
+
+void PairEwaldPotential::compute(double)
+{
+  BoxPtr box = m_system->get_box();
+  if (box->Lx != m_Lx || box->Ly != m_Ly || box->Lz != m_Lz)
+    this->setup();
+  
+  int N = m_system->size();
+  if (m_system->compute_per_particle_energy())
+  {
+    for  (int i = 0; i < N; i++)
+    {
+      Particle& p = m_system->get_particle(i);
+      p.set_pot_energy("ewald",0.0);
+    }
+  }
+  
+  m_potential_energy = 0.0;
+  this->compute_real();
+  this->compute_reciprocal();
+}
+
+/*! Pick the splitting parameter \f$ \beta \f$ such that \f$ {\rm erfc}\left(\beta r_{cut}\right) \f$ 
+ *  is equal to the tolerance and the number of mesh points in each direction such that all wave vectors 
+ *  with \f$ \exp\left(-\pi^2 m^2/\beta^2\right) \f$ larger than the tolerance are resolved.
+ *  Also precompute the influence function, i.e. the Ewald Green's function divided by the 
+ *  squared moduli of the B-spline Euler exponential factors.
+**/
+void PairEwaldPotential::setup()
+{
+  if (!m_system->get_periodic())
+  {
+    m_msg->msg(Messenger::ERROR,"Ewald pair potential requires periodic boundary conditions.");
+    throw runtime_error("Ewald potential used without periodic boundary conditions.");
+  }
+  BoxPtr box = m_system->get_box();
+  m_Lx = box->Lx;  m_Ly = box->Ly;  m_Lz = box->Lz;
+  double L[3] = {m_Lx, m_Ly, m_Lz};
+  double V = m_Lx*m_Ly*m_Lz;
+  
+  // Bisection for the splitting parameter 
+  double beta_lo = 0.0, beta_hi = 1.0/m_rcut;
+  while (erfc(beta_hi*m_rcut) > m_tolerance)
+    beta_hi *= 2.0;
+  for (int iter = 0; iter < 100; iter++)
+  {
+    double beta = 0.5*(beta_lo + beta_hi);
+    if (erfc(beta*m_rcut) > m_tolerance)
+      beta_lo = beta;
+    else
+      beta_hi = beta;
+  }
+  m_beta = beta_hi;
+  
+  double m_max = m_beta*sqrt(-log(m_tolerance))/M_PI;
+  this->free_fft();
+  for (int d = 0; d < 3; d++)
+  {
+    if (m_fixed_mesh > 0)
+      m_K[d] = m_fixed_mesh;
+    else
+      m_K[d] = next_fft_size(std::max(2*m_order, static_cast<int>(ceil(2.0*m_max*L[d]))));
+    m_wavetable[d] = gsl_fft_complex_wavetable_alloc(m_K[d]);
+    m_workspace[d] = gsl_fft_complex_workspace_alloc(m_K[d]);
+  }
+  int Kx = m_K[0], Ky = m_K[1], Kz = m_K[2];
+  m_grid.assign(2*Kx*Ky*Kz, 0.0);
+  m_influence.assign(Kx*Ky*Kz, 0.0);
+  
+  // Squared moduli of the B-spline interpolation factors
+  vector<double> bsp(m_order), dbsp(m_order);
+  this->fill_bspline(0.0, &bsp[0], &dbsp[0]);
+  vector<double> bsp_mod[3];
+  for (int d = 0; d < 3; d++)
+  {
+    int K = m_K[d];
+    bsp_mod[d].resize(K);
+    for (int k = 0; k < K; k++)
+    {
+      double sc = 0.0, ss = 0.0;
+      for (int j = 0; j < m_order; j++)
+      {
+        double arg = 2.0*M_PI*k*j/K;
+        sc += bsp[j]*cos(arg);
+        ss += bsp[j]*sin(arg);
+      }
+      bsp_mod[d][k] = sc*sc + ss*ss;
+    }
+    // For odd orders the modulus vanishes at the Nyquist frequency; interpolate from the neighbours
+    for (int k = 0; k < K; k++)
+      if (bsp_mod[d][k] < 1e-7)
+        bsp_mod[d][k] = 0.5*(bsp_mod[d][(k-1+K)%K] + bsp_mod[d][(k+1)%K]);
+  }
+  
+  double pi_sq_beta_sq = M_PI*M_PI/(m_beta*m_beta);
+  for (int kx = 0; kx < Kx; kx++)
+  {
+    double mx = ((kx <= Kx/2) ? kx : kx - Kx)/m_Lx;
+    for (int ky = 0; ky < Ky; ky++)
+    {
+      double my = ((ky <= Ky/2) ? ky : ky - Ky)/m_Ly;
+      for (int kz = 0; kz < Kz; kz++)
+      {
+        double mz = ((kz <= Kz/2) ? kz : kz - Kz)/m_Lz;
+        double m_sq = mx*mx + my*my + mz*mz;
+        if (m_sq > 0.0)
+          m_influence[(kx*Ky + ky)*Kz + kz] = exp(-pi_sq_beta_sq*m_sq)/(M_PI*V*m_sq*bsp_mod[0][kx]*bsp_mod[1][ky]*bsp_mod[2][kz]);
+      }
+    }
+  }
+  
+  // Error estimate for the real space force (Kolafa and Perram); the reciprocal space error is not estimated
+  double q_sq = 0.0;
+  int N = m_system->size();
+  for (int i = 0; i < N; i++)
+  {
+    double q = m_q[m_system->get_particle(i).get_type()-1];
+    q_sq += q*q;
+  }
+  double real_err = (N > 0) ? 2.0*fabs(m_alpha)*q_sq*exp(-m_beta*m_beta*m_rcut*m_rcut)/sqrt(N*m_rcut*V) : 0.0;
+  
+  m_msg->msg(Messenger::INFO,"Ewald pair potential. Splitting parameter beta is set to "+lexical_cast<string>(m_beta)+".");
+  m_msg->msg(Messenger::INFO,"Ewald pair potential. Using "+lexical_cast<string>(Kx)+" x "+lexical_cast<string>(Ky)+" x "+lexical_cast<string>(Kz)+" mesh with charge assignment order "+lexical_cast<string>(m_order)+".");
+  m_msg->msg(Messenger::INFO,"Ewald pair potential. Estimated RMS error in the real space force is "+lexical_cast<string>(real_err)+".");
+  if (m_fixed_mesh > 0 && m_fixed_mesh < 2.0*m_max*std::max(m_Lx,std::max(m_Ly,m_Lz)))
+    m_msg->msg(Messenger::WARNING,"Ewald pair potential. Fixed mesh is too coarse to reach the requested tolerance. Mesh size of at least "+lexical_cast<string>(static_cast<int>(ceil(2.0*m_max*std::max(m_Lx,std::max(m_Ly,m_Lz)))))+" is recommended.");
+  m_msg->write_config("potential.pair.ewald.beta",lexical_cast<string>(m_beta));
+  m_msg->write_config("potential.pair.ewald.mesh_x",lexical_cast<string>(Kx));
+  m_msg->write_config("potential.pair.ewald.mesh_y",lexical_cast<string>(Ky));
+  m_msg->write_config("potential.pair.ewald.mesh_z",lexical_cast<string>(Kz));
+}
+
+//! Release FFT wavetables and workspaces
+void PairEwaldPotential::free_fft()
+{
+  for (int d = 0; d < 3; d++)
+  {
+    if (m_wavetable[d]) gsl_fft_complex_wavetable_free(m_wavetable[d]);
+    if (m_workspace[d]) gsl_fft_complex_workspace_free(m_workspace[d]);
+    m_wavetable[d] = 0;
+    m_workspace[d] = 0;
+  }
+}
+
+/*! Compute weights of a charge at fractional offset w from the mesh point using 
+ *  cardinal B-spline of order m_order (Essmann et al., J. Chem. Phys. 103, 8577 (1995)).
+ *  \param w fractional offset (between 0 and 1)
+ *  \param theta weights (array of length m_order)
+ *  \param dtheta derivatives of the weights (array of length m_order)
+**/
+void PairEwaldPotential::fill_bspline(double w, double* theta, double* dtheta)
+{
+  int n = m_order;
+  // Linear B-spline
+  theta[n-1] = 0.0;
+  theta[1] = w;
+  theta[0] = 1.0 - w;
+  // Recursion up to order n-1
+  for (int k = 3; k < n; k++)
+  {
+    double div = 1.0/(k-1);
+    theta[k-1] = div*w*theta[k-2];
+    for (int j = 1; j < k-1; j++)
+      theta[k-j-1] = div*((w+j)*theta[k-j-2] + (k-j-w)*theta[k-j-1]);
+    theta[0] *= div*(1.0-w);
+  }
+  // Derivatives follow from the order n-1 spline
+  dtheta[0] = -theta[0];
+  for (int j = 1; j < n; j++)
+    dtheta[j] = theta[j-1] - theta[j];
+  // Final recursion step
+  double div = 1.0/(n-1);
+  theta[n-1] = div*w*theta[n-2];
+  for (int j = 1; j < n-1; j++)
+    theta[n-j-1] = div*((w+j)*theta[n-j-2] + (n-j-w)*theta[n-j-1]);
+  theta[0] *= div*(1.0-w);
+}
+
+/*! Carry out in-place 3d FFT of the mesh as a sequence of 1d transforms along each direction.
+ *  \param forward if true, carry out forward transform, otherwise (unnormalised) backward transform
+**/
+void PairEwaldPotential::fft(bool forward)
+{
+  int Kx = m_K[0], Ky = m_K[1], Kz = m_K[2];
+  double* data = &m_grid[0];
+  for (int ix = 0; ix < Kx; ix++)
+    for (int iy = 0; iy < Ky; iy++)
+    {
+      double* line = data + 2*(ix*Ky + iy)*Kz;
+      if (forward) gsl_fft_complex_forward(line, 1, Kz, m_wavetable[2], m_workspace[2]);
+      else gsl_fft_complex_backward(line, 1, Kz, m_wavetable[2], m_workspace[2]);
+    }
+  for (int ix = 0; ix < Kx; ix++)
+    for (int iz = 0; iz < Kz; iz++)
+    {
+      double* line = data + 2*(ix*Ky*Kz + iz);
+      if (forward) gsl_fft_complex_forward(line, Kz, Ky, m_wavetable[1], m_workspace[1]);
+      else gsl_fft_complex_backward(line, Kz, Ky, m_wavetable[1], m_workspace[1]);
+    }
+  for (int iy = 0; iy < Ky; iy++)
+    for (int iz = 0; iz < Kz; iz++)
+    {
+      double* line = data + 2*(iy*Kz + iz);
+      if (forward) gsl_fft_complex_forward(line, Ky*Kz, Kx, m_wavetable[0], m_workspace[0]);
+      else gsl_fft_complex_backward(line, Ky*Kz, Kx, m_wavetable[0], m_workspace[0]);
+    }
+}
+
+//! Real space part is a screened Coulomb interaction evaluated over the neighbour list
+void PairEwaldPotential::compute_real()
+{
+  int N = m_system->size();
+  double sigma = m_sigma;
+  double sigma_sq = sigma*sigma;
+  double rcut_sq = m_rcut*m_rcut;
+  double beta_sq = m_beta*m_beta;
+  double two_beta_over_sqrt_pi = 2.0*m_beta/sqrt(M_PI);
+  
+  for  (int i = 0; i < N; i++)
+  {
+    Particle& pi = m_system->get_particle(i);
+    double qi = m_alpha*m_q[pi.get_type()-1];
+    if (qi == 0.0) continue;
+    vector<int>& neigh = m_nlist->get_neighbours(i);
+    for (unsigned int j = 0; j < neigh.size(); j++)
+    {
+      Particle& pj = m_system->get_particle(neigh[j]);
+      double qiqj = qi*m_q[pj.get_type()-1];
+      if (qiqj == 0.0) continue;
+      double dx = pi.x - pj.x, dy = pi.y - pj.y, dz = pi.z - pj.z;
+      m_system->apply_periodic(dx,dy,dz);
+      double r_sq = dx*dx + dy*dy + dz*dz;
+      if (r_sq <= rcut_sq)
+      {
+        if (m_has_pair_params)
+        {
+          sigma = m_pair_params[pi.get_type()-1][pj.get_type()-1].sigma;
+          sigma_sq = sigma*sigma;
+        }
+        double r = sqrt(r_sq);
+        double erfc_br = erfc(m_beta*r);
+        double inv_r_sq = sigma_sq/r_sq;
+        double inv_r_6  = inv_r_sq*inv_r_sq*inv_r_sq;
+        // Handle potential 
+        double potential_energy = qiqj*erfc_br/r + 4.0*fabs(qiqj)*inv_r_6*inv_r_6;
+        m_potential_energy += potential_energy;
+        // Handle force
+        double force_factor = qiqj*(erfc_br/r + two_beta_over_sqrt_pi*exp(-beta_sq*r_sq))/r_sq + 48.0*fabs(qiqj)*inv_r_6*inv_r_6/r_sq;
+        pi.fx += force_factor*dx;
+        pi.fy += force_factor*dy;
+        pi.fz += force_factor*dz;
+        // Use 3d Newton's law
+        pj.fx -= force_factor*dx;
+        pj.fy -= force_factor*dy;
+        pj.fz -= force_factor*dz;
+        if (m_system->compute_per_particle_energy())
+        {
+          pi.add_pot_energy("ewald",potential_energy);
+          pj.add_pot_energy("ewald",potential_energy);
+        }
+      }
+    }
+  }
+}
+
+/*! Reciprocal space part. Charges are spread onto the mesh using B-splines, mesh is Fourier 
+ *  transformed and multiplied by the influence function. Backward transform then gives the 
+ *  reciprocal space electrostatic potential on the mesh which is interpolated back to the particles
+ *  using the same B-splines. Finally, self-energy and (for non-neutral systems) neutralising 
+ *  background contributions are added.
+**/
+void PairEwaldPotential::compute_reciprocal()
+{
+  int N = m_system->size();
+  int n = m_order;
+  int Kx = m_K[0], Ky = m_K[1], Kz = m_K[2];
+  BoxPtr box = m_system->get_box();
+  double lo[3] = {box->xlo, box->ylo, box->zlo};
+  double L[3] = {m_Lx, m_Ly, m_Lz};
+  double V = m_Lx*m_Ly*m_Lz;
+  
+  for (int d = 0; d < 3; d++)
+  {
+    m_theta[d].resize(N*n);
+    m_dtheta[d].resize(N*n);
+    m_base[d].resize(N);
+  }
+  
+  // Spread charges onto the mesh
+  std::fill(m_grid.begin(), m_grid.end(), 0.0);
+  double q_tot = 0.0, q_sq = 0.0;
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(i);
+    double q = m_q[p.get_type()-1];
+    q_tot += q;
+    q_sq += q*q;
+    double r[3] = {p.x, p.y, p.z};
+    for (int d = 0; d < 3; d++)
+    {
+      double u = m_K[d]*(r[d] - lo[d])/L[d];
+      double fl = floor(u);
+      this->fill_bspline(u - fl, &m_theta[d][i*n], &m_dtheta[d][i*n]);
+      // Wrap base index into the mesh; particles may be slightly outside the box between wraps
+      int base = static_cast<int>(fl) - n + 1;
+      base %= m_K[d];
+      if (base < 0) base += m_K[d];
+      m_base[d][i] = base;
+    }
+    if (q == 0.0) continue;
+    double* thx = &m_theta[0][i*n];
+    double* thy = &m_theta[1][i*n];
+    double* thz = &m_theta[2][i*n];
+    for (int a = 0; a < n; a++)
+    {
+      int kx = (m_base[0][i] + a) % Kx;
+      double wx = q*thx[a];
+      for (int b = 0; b < n; b++)
+      {
+        int ky = (m_base[1][i] + b) % Ky;
+        double wxy = wx*thy[b];
+        int row = (kx*Ky + ky)*Kz;
+        for (int c = 0; c < n; c++)
+        {
+          int kz = (m_base[2][i] + c) % Kz;
+          m_grid[2*(row + kz)] += wxy*thz[c];
+        }
+      }
+    }
+  }
+  
+  // Convolution with the influence function
+  this->fft(true);
+  double rec_energy = 0.0;
+  int M = Kx*Ky*Kz;
+  for (int k = 0; k < M; k++)
+  {
+    double re = m_grid[2*k], im = m_grid[2*k+1];
+    rec_energy += m_influence[k]*(re*re + im*im);
+    m_grid[2*k] *= m_influence[k];
+    m_grid[2*k+1] *= m_influence[k];
+  }
+  rec_energy *= 0.5*m_alpha;
+  this->fft(false);
+  
+  // Constant terms
+  double self_fact = m_alpha*m_beta/sqrt(M_PI);
+  double neutral_fact = m_alpha*M_PI/(V*m_beta*m_beta);
+  m_potential_energy += rec_energy - self_fact*q_sq - 0.5*neutral_fact*q_tot*q_tot;
+  
+  // Interpolate forces (and potential) back to particles
+  bool per_particle = m_system->compute_per_particle_energy();
+  double scale[3] = {Kx/m_Lx, Ky/m_Ly, Kz/m_Lz};
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(i);
+    double q = m_q[p.get_type()-1];
+    if (q == 0.0) continue;
+    double* thx = &m_theta[0][i*n];
+    double* thy = &m_theta[1][i*n];
+    double* thz = &m_theta[2][i*n];
+    double* dthx = &m_dtheta[0][i*n];
+    double* dthy = &m_dtheta[1][i*n];
+    double* dthz = &m_dtheta[2][i*n];
+    double phi = 0.0, gx = 0.0, gy = 0.0, gz = 0.0;
+    for (int a = 0; a < n; a++)
+    {
+      int kx = (m_base[0][i] + a) % Kx;
+      for (int b = 0; b < n; b++)
+      {
+        int ky = (m_base[1][i] + b) % Ky;
+        int row = (kx*Ky + ky)*Kz;
+        for (int c = 0; c < n; c++)
+        {
+          int kz = (m_base[2][i] + c) % Kz;
+          double val = m_grid[2*(row + kz)];
+          gx += dthx[a]*thy[b]*thz[c]*val;
+          gy += thx[a]*dthy[b]*thz[c]*val;
+          gz += thx[a]*thy[b]*dthz[c]*val;
+          if (per_particle)
+            phi += thx[a]*thy[b]*thz[c]*val;
+        }
+      }
+    }
+    double aq = m_alpha*q;
+    p.fx -= aq*scale[0]*gx;
+    p.fy -= aq*scale[1]*gy;
+    p.fz -= aq*scale[2]*gz;
+    // Per particle energy is the full interaction energy of the particle with all other charges (same convention as in the real space part)
+    if (per_particle)
+      p.add_pot_energy("ewald",aq*phi - 2.0*self_fact*q*q - neutral_fact*q*q_tot);
+  }
+}
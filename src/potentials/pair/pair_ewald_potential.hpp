@@ -0,0 +1,354 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file pair_ewald_potential.hpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Declaration of PairEwaldPotential class
+ */ 
+
+#ifndef __PAIR_EWALD_POTENTIAL_HPP__
+#define __PAIR_EWALD_POTENTIAL_HPP__
+
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+#include <gsl/gsl_fft_complex.h>
+
+#include "pair_potential.hpp"
+
+using std::make_pair;
+using std::sqrt;
+using std::exp;
+using std::erfc;
+using std::vector;
+
+//! Structure that handles parameters for the Ewald pair potential
+struct EwaldParameters
+{
+  double sigma;
+};
+
+/*! PairEwaldPotential implements periodic Coulomb interactions using the smooth 
+ *  particle-mesh Ewald (PME) method. The Coulomb interaction 
+ *  \f$ U\left(r_{ij}\right) = \frac{\alpha q_i q_j}{r_{ij}} \f$ is split into a short ranged 
+ *  real space part, \f$ \alpha q_i q_j \frac{{\rm erfc}\left(\beta r_{ij}\right)}{r_{ij}} \f$, which is 
+ *  evaluated using the neighbour list, and a smooth long ranged part that is evaluated
+ *  in the reciprocal space. In the reciprocal part charges are assigned to a regular mesh 
+ *  using cardinal B-splines of a given order and the convolution with the Ewald Green's 
+ *  function is carried out using FFTs.
+ *  
+ *  Splitting parameter \f$ \beta \f$ is chosen such that \f$ {\rm erfc}\left(\beta r_{cut}\right) \f$ 
+ *  is equal to the requested tolerance, while the mesh is chosen fine enough to resolve all 
+ *  wave vectors for which the Gaussian damping factor \f$ \exp\left(-\pi^2 m^2/\beta^2\right) \f$ 
+ *  is larger than the tolerance.
+ *  
+ *  As in the case of the Coulomb potential a LJ repulsive core 
+ *  \f$ 4\left|\alpha q_i q_j\right|\left(\frac \sigma r_{ij}\right)^{12} \f$ is added to 
+ *  avoid collapse of oppositely charged particles. The core is cut at the real space cutoff 
+ *  but not shifted, i.e. energy jumps by \f$ 4\left|\alpha q_i q_j\right|\left(\frac \sigma r_{cut}\right)^{12} \f$
+ *  when a pair crosses \f$ r_{cut} \f$. This is negligible as long as \f$ r_{cut} \f$ is a few \f$ \sigma \f$.
+ *  
+ *  Charges are set per particle type using the pair_type_param command. 
+ *  
+ *  \note Method assumes a fully periodic three dimensional box.
+ *  \note Error estimate reported at setup covers only the real space force. Reciprocal space 
+ *  error depends on the mesh size and the charge assignment order and is not estimated.
+ */
+class PairEwaldPotential : public PairPotential
+{
+public:
+  
+  //! Constructor
+  //! \param sys Pointer to the System object
+  //! \param msg Pointer to the internal state messenger
+  //! \param nlist Pointer to the global neighbour list
+  //! \param val Value control object (for phasing in)
+  //! \param param Contains information about all parameters (alpha, sigma, q, rcut, tolerance, order and mesh)
+  PairEwaldPotential(SystemPtr sys, MessengerPtr msg, NeighbourListPtr nlist, ValuePtr val, pairs_type& param) : PairPotential(sys, msg, nlist, val, param),
+                                                                                                                 m_beta(0.0),
+                                                                                                                 m_fixed_mesh(0),
+                                                                                                                 m_Lx(0.0), m_Ly(0.0), m_Lz(0.0)
+  {
+    m_known_params.push_back("alpha");
+    m_known_params.push_back("sigma");
+    m_known_params.push_back("q");
+    m_known_params.push_back("rcut");
+    m_known_params.push_back("tolerance");
+    m_known_params.push_back("order");
+    m_known_params.push_back("mesh");
+    string param_test = this->params_ok(param);
+    if (param_test != "")
+    {
+      m_msg->msg(Messenger::ERROR,"Parameter \""+param_test+"\" is not a valid parameter for Ewald pair potential.");
+      throw runtime_error("Unknown parameter \""+param_test+"\" in Ewald potential.");
+    }
+    if (param.find("alpha") == param.end())
+    {
+      m_msg->msg(Messenger::WARNING,"No potential strength (alpha) specified for Ewald pair potential. Setting it to 1.");
+      m_alpha = 1.0;
+    }
+    else
+    {
+      m_msg->msg(Messenger::INFO,"Global potential strength (alpha) for Ewald pair potential is set to "+param["alpha"]+".");
+      m_alpha = lexical_cast<double>(param["alpha"]);
+    }
+    m_msg->write_config("potential.pair.ewald.alpha",lexical_cast<string>(m_alpha));
+    
+    if (param.find("sigma") == param.end())
+    {
+      m_msg->msg(Messenger::WARNING,"No particle diameter (sigma) specified for Ewald pair potential. Setting it to 1.");
+      m_sigma = 1.0;
+    }
+    else
+    {
+      m_msg->msg(Messenger::INFO,"Global particle diameter (sigma) for Ewald pair potential is set to "+param["sigma"]+".");
+      m_sigma = lexical_cast<double>(param["sigma"]);
+    }
+    m_msg->write_config("potential.pair.ewald.sigma",lexical_cast<string>(m_sigma));
+    
+    if (param.find("q") == param.end())
+    {
+      m_msg->msg(Messenger::WARNING,"No charge (q) specified for Ewald pair potential. Setting it to 1 for all particle types.");
+      m_q_default = 1.0;
+    }
+    else
+    {
+      m_msg->msg(Messenger::INFO,"Global charge (q) for Ewald pair potential is set to "+param["q"]+".");
+      m_q_default = lexical_cast<double>(param["q"]);
+    }
+    m_msg->write_config("potential.pair.ewald.q",lexical_cast<string>(m_q_default));
+    
+    if (param.find("rcut") == param.end())
+    {
+      m_msg->msg(Messenger::WARNING,"No real space cutoff distance (rcut) specified for the Ewald pair potential. Setting it to the neighbour list cutoff.");
+      m_rcut = m_nlist->get_cutoff();
+    }
+    else
+    {
+      m_msg->msg(Messenger::INFO,"Real space cutoff distance (rcut) for Ewald pair potential is set to "+param["rcut"]+".");
+      m_rcut = lexical_cast<double>(param["rcut"]);
+    }
+    if (m_rcut > m_nlist->get_cutoff())
+    {
+      m_msg->msg(Messenger::ERROR,"Neighbour list cutoff distance (" + lexical_cast<string>(m_nlist->get_cutoff())+
+      ") is smaller than the real space cutoff distance for the Ewald potential ("+lexical_cast<string>(m_rcut)+").");
+      throw runtime_error("Ewald real space cutoff larger than the neighbour list cutoff.");
+    }
+    m_msg->write_config("potential.pair.ewald.rcut",lexical_cast<string>(m_rcut));
+    
+    if (param.find("tolerance") == param.end())
+    {
+      m_msg->msg(Messenger::WARNING,"No relative accuracy (tolerance) specified for Ewald pair potential. Setting it to 1e-5.");
+      m_tolerance = 1e-5;
+    }
+    else
+    {
+      m_msg->msg(Messenger::INFO,"Relative accuracy (tolerance) for Ewald pair potential is set to "+param["tolerance"]+".");
+      m_tolerance = lexical_cast<double>(param["tolerance"]);
+    }
+    if (m_tolerance <= 0.0 || m_tolerance >= 1.0)
+    {
+      m_msg->msg(Messenger::ERROR,"Tolerance for Ewald pair potential has to be between 0 and 1.");
+      throw runtime_error("Invalid tolerance in Ewald potential.");
+    }
+    m_msg->write_config("potential.pair.ewald.tolerance",lexical_cast<string>(m_tolerance));
+    
+    if (param.find("order") == param.end())
+    {
+      m_msg->msg(Messenger::WARNING,"No charge assignment order (order) specified for Ewald pair potential. Setting it to 5.");
+      m_order = 5;
+    }
+    else
+    {
+      m_msg->msg(Messenger::INFO,"Charge assignment order (order) for Ewald pair potential is set to "+param["order"]+".");
+      m_order = lexical_cast<int>(param["order"]);
+    }
+    if (m_order < 3 || m_order > 12)
+    {
+      m_msg->msg(Messenger::ERROR,"Charge assignment order for Ewald pair potential has to be between 3 and 12.");
+      throw runtime_error("Invalid charge assignment order in Ewald potential.");
+    }
+    m_msg->write_config("potential.pair.ewald.order",lexical_cast<string>(m_order));
+    
+    if (param.find("mesh") != param.end())
+    {
+      m_fixed_mesh = lexical_cast<int>(param["mesh"]);
+      if (m_fixed_mesh < 2*m_order)
+      {
+        m_msg->msg(Messenger::ERROR,"Mesh size for Ewald pair potential has to be at least twice the charge assignment order.");
+        throw runtime_error("Invalid mesh size in Ewald potential.");
+      }
+      m_msg->msg(Messenger::INFO,"Ewald pair potential. Using fixed mesh with "+param["mesh"]+" points in each direction.");
+      m_msg->write_config("potential.pair.ewald.mesh",param["mesh"]);
+    }
+    else
+      m_msg->msg(Messenger::INFO,"Ewald pair potential. Mesh size will be determined from the tolerance.");
+    
+    m_q.resize(m_ntypes, m_q_default);
+    
+    m_pair_params = new EwaldParameters*[m_ntypes];
+    for (int i = 0; i < m_ntypes; i++)
+    {
+      m_pair_params[i] = new EwaldParameters[m_ntypes];
+      for (int j = 0; j < m_ntypes; j++)
+        m_pair_params[i][j].sigma = m_sigma;
+    }
+    
+    for (int d = 0; d < 3; d++)
+    {
+      m_K[d] = 0;
+      m_wavetable[d] = 0;
+      m_workspace[d] = 0;
+    }
+  }
+  
+  virtual ~PairEwaldPotential()
+  {
+    for (int i = 0; i < m_ntypes; i++)
+      delete [] m_pair_params[i];
+    delete [] m_pair_params;
+    this->free_fft();
+  }
+                                                                                                                
+  //! Set pair parameters data for pairwise interactions    
+  void set_pair_parameters(pairs_type& pair_param)
+  {
+    map<string,double> param;
+    
+    int type_1, type_2;
+    
+    if (pair_param.find("type_1") == pair_param.end())
+    {
+      m_msg->msg(Messenger::ERROR,"type_1 has not been defined for pair potential parameters in Ewald potential.");
+      throw runtime_error("Missing key for pair potential parameters.");
+    }
+    if (pair_param.find("type_2") == pair_param.end())
+    {
+      m_msg->msg(Messenger::ERROR,"type_2 has not been defined for pair potential parameters in Ewald potential.");
+      throw runtime_error("Missing key for pair potential parameters.");
+    }
+    type_1 = lexical_cast<int>(pair_param["type_1"]);
+    type_2 = lexical_cast<int>(pair_param["type_2"]);
+    
+    if (pair_param.find("sigma") != pair_param.end())
+    {
+      m_msg->msg(Messenger::INFO,"Ewald pair potential. Setting sigma to "+pair_param["sigma"]+" for particle pair of types "+lexical_cast<string>(type_1)+" and "+lexical_cast<string>(type_2)+").");
+      param["sigma"] = lexical_cast<double>(pair_param["sigma"]);
+    }
+    else
+    {
+      m_msg->msg(Messenger::INFO,"Ewald pair potential. Using default sigma ("+lexical_cast<string>(m_sigma)+") for particle pair of types "+lexical_cast<string>(type_1)+" and "+lexical_cast<string>(type_2)+").");
+      param["sigma"] = m_sigma;
+    }
+    m_msg->write_config("potential.pair.ewald.type_"+pair_param["type_1"]+"_and_type_"+pair_param["type_2"]+".sigma",lexical_cast<string>(param["sigma"]));
+        
+    m_pair_params[type_1-1][type_2-1].sigma = param["sigma"];
+    if (type_1 != type_2)
+      m_pair_params[type_2-1][type_1-1].sigma = param["sigma"];
+    
+    m_has_pair_params = true;
+  }
+  
+  //! Set charge for each particle type
+  void set_type_parameters(pairs_type& pair_param)
+  {
+    int type;
+    
+    if (pair_param.find("type") == pair_param.end())
+    {
+      m_msg->msg(Messenger::ERROR,"type has not been defined for particle specific parameters in Ewald potential.");
+      throw runtime_error("Missing key for pair potential particle parameters.");
+    }
+    type = lexical_cast<int>(pair_param["type"]);
+    
+    if (pair_param.find("q") != pair_param.end())
+    {
+      m_msg->msg(Messenger::INFO,"Ewald pair potential. Setting charge to "+pair_param["q"]+" for particles of type "+lexical_cast<string>(type)+".");
+      m_q[type-1] = lexical_cast<double>(pair_param["q"]);
+    }
+    else
+    {
+      m_msg->msg(Messenger::INFO,"Ewald pair potential. Using default charge ("+lexical_cast<string>(m_q_default)+") for particles of type "+lexical_cast<string>(type)+".");
+      m_q[type-1] = m_q_default;
+    }
+    m_msg->write_config("potential.pair.ewald.type_"+pair_param["type"]+".q",lexical_cast<string>(m_q[type-1]));
+  }
+  
+  //! Returns true since the real space part uses the neighbour list
+  bool need_nlist() { return true; }
+  
+  //! Returns real space cutoff distance (same for all pairs)
+  double get_pair_cutoff(int, int) { return m_rcut; }
+  
+  //! Computes potentials and forces for all particles
+  void compute(double);
+  
+  
+private:
+        
+  double m_alpha;                   //!< potential strength
+  double m_sigma;                   //!< particle diameter (repulsive core)
+  double m_q_default;               //!< default charge
+  double m_rcut;                    //!< real space cutoff 
+  double m_tolerance;               //!< requested relative accuracy
+  double m_beta;                    //!< Ewald splitting parameter
+  int m_order;                      //!< order of the B-spline charge assignment
+  int m_fixed_mesh;                 //!< if not zero, user set mesh size (same in all directions)
+  int m_K[3];                       //!< number of mesh points in each direction
+  double m_Lx, m_Ly, m_Lz;          //!< box size for which the mesh was set up
+  vector<double> m_q;               //!< charge of each particle type
+  EwaldParameters** m_pair_params;  //!< type specific pair parameters 
+  
+  vector<double> m_grid;            //!< charge mesh (complex numbers stored as pairs of doubles)
+  vector<double> m_influence;       //!< influence function (Green's function times B-spline moduli) 
+  vector<double> m_theta[3];        //!< B-spline weights for each particle and direction
+  vector<double> m_dtheta[3];       //!< B-spline weight derivatives for each particle and direction
+  vector<int> m_base[3];            //!< index of the first mesh point each particle is assigned to
+  gsl_fft_complex_wavetable* m_wavetable[3];   //!< FFT wavetables for each direction
+  gsl_fft_complex_workspace* m_workspace[3];   //!< FFT workspaces for each direction
+  
+  //! Set up splitting parameter, mesh and influence function for the current box
+  void setup();
+  
+  //! Release FFT wavetables and workspaces 
+  void free_fft();
+  
+  //! Compute B-spline weights and their derivatives for a given fractional offset
+  void fill_bspline(double, double*, double*);
+  
+  //! Carry out 3d FFT of the mesh 
+  void fft(bool);
+  
+  //! Compute real space part of the interaction
+  void compute_real();
+  
+  //! Compute reciprocal space part of the interaction
+  void compute_reciprocal();
+    
+};
+
+typedef shared_ptr<PairEwaldPotential> PairEwaldPotentialPtr;
+
+#endif
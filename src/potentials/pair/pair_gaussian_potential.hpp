@@ -332,6 +332,36 @@ public:
   //! Returns true since Gaussian potential needs neighbour list
   bool need_nlist() { return true; }
   
+  //! Evaluate Gaussian interaction for particles of given types (used for tabulation)
+  //! \param type_1 type of the first particle
+  //! \param type_2 type of the second particle
+  //! \param r interparticle distance
+  //! \param pot potential energy
+  //! \param force_factor magnitude of the force divided by the distance (positive for repulsion)
+  bool evaluate_pair(int type_1, int type_2, double r, double& pot, double& force_factor)
+  {
+    if (m_use_particle_radii) return false;
+    double A = m_A, B = m_B, alpha = m_alpha, beta = m_beta, rA = m_rA, rB = m_rB, rcut = m_rcut;
+    if (m_has_pair_params)
+    {
+      GaussianParameters& p = m_pair_params[type_1-1][type_2-1];
+      A = p.A;  B = p.B;  alpha = p.alpha;  beta = p.beta;  rA = p.rA;  rB = p.rB;  rcut = p.rcut;
+    }
+    double r_m_rA = r - rA, r_m_rB = r - rB;
+    double exp_A = exp(-alpha*r_m_rA*r_m_rA), exp_B = exp(-beta*r_m_rB*r_m_rB);
+    pot = A*exp_A + B*exp_B;
+    if (m_shifted)
+    {
+      double rcut_m_rA = rcut - rA, rcut_m_rB = rcut - rB;
+      pot -= A*exp(-alpha*rcut_m_rA*rcut_m_rA) + B*exp(-beta*rcut_m_rB*rcut_m_rB);
+    }
+    force_factor = (2.0/r)*(A*alpha*r_m_rA*exp_A + B*beta*r_m_rB*exp_B);
+    return true;
+  }
+  
+  //! Returns cutoff distance for the pair of particle types
+  double get_pair_cutoff(int type_1, int type_2) { return m_has_pair_params ? m_pair_params[type_1-1][type_2-1].rcut : m_rcut; }
+  
   //! Computes potentials and forces for all particles
   void compute(double);
   
@@ -48,39 +48,36 @@ void PairLineTensionPotential::compute(double dt)
   }
   
   m_potential_energy = 0.0;
-  for (int e = 0; e < mesh.nedges(); e++)
+  vector<int>& boundary_edges = mesh.get_boundary_edges();
+  BoundaryGeometry& geom = m_system->get_boundary_geometry();
+  for (unsigned int e = 0; e < boundary_edges.size(); e++)
   {
-    Edge& E = mesh.get_edges()[e];
-    if (E.boundary)
+    Edge& E = mesh.get_edges()[boundary_edges[e]];
+    Particle& pi = m_system->get_particle(E.from);
+    Particle& pj = m_system->get_particle(E.to);
+    double dx = geom.edge_vec[e].x, dy = geom.edge_vec[e].y, dz = geom.edge_vec[e].z;
+    if (m_has_pair_params)
     {
-      Particle& pi = m_system->get_particle(E.from);
-      Particle& pj = m_system->get_particle(E.to);
-      double dx = pj.x - pi.x, dy = pj.y - pi.y, dz = pj.z - pi.z;
-      m_system->apply_periodic(dx,dy,dz);
-      if (m_has_pair_params)
-      {
-        lambda = m_pair_params[pi.get_type() - 1][pj.get_type() - 1].lambda;
-        l0 = m_pair_params[pi.get_type() - 1][pj.get_type() - 1].l0;
-      }
-      double r_sq = dx*dx + dy*dy + dz*dz;
-      double r = sqrt(r_sq);
-      double dl = r - l0;
-      double pot_eng = 0.5*lambda*dl*dl;
-      m_potential_energy += pot_eng;
-      // Handle force
-      double force_factor = lambda*dl/r;
-      pi.fx += force_factor*dx;
-      pi.fy += force_factor*dy;
-      pi.fz += force_factor*dz;
-      // Use 3d Newton's law
-      pj.fx -= force_factor*dx;
-      pj.fy -= force_factor*dy;
-      pj.fz -= force_factor*dz;
-      if (m_system->compute_per_particle_energy())
-      {
-        pi.add_pot_energy("line_tension",pot_eng);
-        pj.add_pot_energy("line_tension",pot_eng);
-      }
+      lambda = m_pair_params[pi.get_type() - 1][pj.get_type() - 1].lambda;
+      l0 = m_pair_params[pi.get_type() - 1][pj.get_type() - 1].l0;
+    }
+    double r = geom.edge_len[e];
+    double dl = r - l0;
+    double pot_eng = 0.5*lambda*dl*dl;
+    m_potential_energy += pot_eng;
+    // Handle force
+    double force_factor = lambda*dl/r;
+    pi.fx += force_factor*dx;
+    pi.fy += force_factor*dy;
+    pi.fz += force_factor*dz;
+    // Use 3d Newton's law
+    pj.fx -= force_factor*dx;
+    pj.fy -= force_factor*dy;
+    pj.fz -= force_factor*dz;
+    if (m_system->compute_per_particle_energy())
+    {
+      pi.add_pot_energy("line_tension",pot_eng);
+      pj.add_pot_energy("line_tension",pot_eng);
     }
   }
 }
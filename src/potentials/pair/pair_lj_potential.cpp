@@ -104,8 +104,8 @@ void PairLJPotential::compute(double dt)
           potential_energy -= 4.0 * eps * alpha * inv_r_cut_6 * (inv_r_cut_6 - 1.0);
         }
         m_potential_energy += potential_energy;
-        // Handle force
-        double force_factor = 48.0*eps*alpha*inv_r_6*(inv_r_6 - 0.5)*inv_r_sq;
+        // Handle force (force_factor is -dU/dr/r, i.e. 1/r^2 and not sigma^2/r^2 multiplies the bracket)
+        double force_factor = 48.0*eps*alpha*inv_r_6*(inv_r_6 - 0.5)/r_sq;
         pi.fx += force_factor*dx;
         pi.fy += force_factor*dy;
         pi.fz += force_factor*dz;
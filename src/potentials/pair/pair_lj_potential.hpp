@@ -47,6 +47,11 @@ struct LJParameters
  * \f$ U_{LJ}\left(r_{ij}\right) = 4\varepsilon \left[\left(\frac \sigma r_{ij}\right)^{12}-\left(\frac \sigma r_{ij}\right)^6)\right] \f$,
  *  where \f$ \varepsilon \f$ is the potential strength, \f$ \sigma \f$ is the particle diameter and \f$ r_{ij} \f$ is the 
  *  interparticle distance.
+ *  
+ *  Force is \f$ \vec F_{ij} = -\frac{dU_{LJ}}{dr_{ij}}\frac{\vec r_{ij}}{r_{ij}} = 
+ *  \frac{48\varepsilon}{r_{ij}^2}\left(\frac \sigma r_{ij}\right)^6\left[\left(\frac \sigma r_{ij}\right)^6-\frac 1 2\right]\vec r_{ij} \f$ 
+ *  both in compute() and in evaluate_pair() (used to build tables), so direct and tabulated 
+ *  Lennard-Jones forces agree for any \f$ \sigma \f$.
  */
 class PairLJPotential : public PairPotential
 {
@@ -250,6 +255,40 @@ public:
   //! Returns true since Lennard-Jones potential needs neighbour list
   bool need_nlist() { return true; }
   
+  //! Evaluate Lennard-Jones interaction for particles of given types (used for tabulation)
+  //! \param type_1 type of the first particle
+  //! \param type_2 type of the second particle
+  //! \param r interparticle distance
+  //! \param pot potential energy
+  //! \param force_factor magnitude of the force divided by the distance (positive for repulsion)
+  //! \note force_factor is \f$ -\frac{1}{r}\frac{dU}{dr} \f$, the same as in compute()
+  bool evaluate_pair(int type_1, int type_2, double r, double& pot, double& force_factor)
+  {
+    if (m_use_particle_radii) return false;
+    double sigma = m_sigma, eps = m_eps, rcut = m_rcut;
+    if (m_has_pair_params)
+    {
+      sigma = m_pair_params[type_1-1][type_2-1].sigma;
+      eps = m_pair_params[type_1-1][type_2-1].eps;
+      rcut = m_pair_params[type_1-1][type_2-1].rcut;
+    }
+    double sigma_sq = sigma*sigma, r_sq = r*r;
+    double inv_r_sq = sigma_sq/r_sq;
+    double inv_r_6  = inv_r_sq*inv_r_sq*inv_r_sq;
+    pot = 4.0*eps*inv_r_6*(inv_r_6 - 1.0);
+    if (m_shifted)
+    {
+      double inv_r_cut_sq = sigma_sq/(rcut*rcut);
+      double inv_r_cut_6 = inv_r_cut_sq*inv_r_cut_sq*inv_r_cut_sq;
+      pot -= 4.0*eps*inv_r_cut_6*(inv_r_cut_6 - 1.0);
+    }
+    force_factor = 48.0*eps*inv_r_6*(inv_r_6 - 0.5)/r_sq;
+    return true;
+  }
+  
+  //! Returns cutoff distance for the pair of particle types
+  double get_pair_cutoff(int type_1, int type_2) { return m_has_pair_params ? m_pair_params[type_1-1][type_2-1].rcut : m_rcut; }
+  
   //! Computes potentials and forces for all particles
   void compute(double);
   
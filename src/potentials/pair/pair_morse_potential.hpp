@@ -262,6 +262,38 @@ public:
   //! Returns true since Morse potential needs neighbour list
   bool need_nlist() { return true; }
   
+  //! Evaluate Morse interaction for particles of given types (used for tabulation)
+  //! \param type_1 type of the first particle
+  //! \param type_2 type of the second particle
+  //! \param r interparticle distance
+  //! \param pot potential energy
+  //! \param force_factor magnitude of the force divided by the distance (positive for repulsion)
+  bool evaluate_pair(int type_1, int type_2, double r, double& pot, double& force_factor)
+  {
+    if (m_use_particle_radii) return false;
+    double D = m_D, a = m_a, re = m_re, rcut = m_rcut;
+    if (m_has_pair_params)
+    {
+      D = m_pair_params[type_1-1][type_2-1].D;
+      a = m_pair_params[type_1-1][type_2-1].a;
+      re = m_pair_params[type_1-1][type_2-1].re;
+      rcut = m_pair_params[type_1-1][type_2-1].rcut;
+    }
+    double exp_fact = exp(-a*(r-re));
+    double pot_fact = exp_fact - 1.0;
+    pot = D*(pot_fact*pot_fact-1.0);
+    if (m_shifted)
+    {
+      double shift_fact = exp(-a*(rcut-re)) - 1.0;
+      pot -= D*(shift_fact*shift_fact-1.0);
+    }
+    force_factor = 2.0*D*a*exp_fact*pot_fact/r;
+    return true;
+  }
+  
+  //! Returns cutoff distance for the pair of particle types
+  double get_pair_cutoff(int type_1, int type_2) { return m_has_pair_params ? m_pair_params[type_1-1][type_2-1].rcut : m_rcut; }
+  
   //! Computes potentials and forces for all particles
   void compute(double);
   
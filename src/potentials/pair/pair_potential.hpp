@@ -118,6 +118,30 @@ public:
   
   //! Computes potentials and forces for all particles
   virtual void compute(double) = 0;
+  
+  //! Evaluate interaction of two particles of given types at a given distance (used to tabulate potentials)
+  //! \return false if the interaction is not a function of particle types and distance alone
+  virtual bool evaluate_pair(int, int, double, double&, double&) { return false; }
+  
+  //! Returns cutoff distance for the pair of particle types (0 if not known)
+  virtual double get_pair_cutoff(int, int) { return 0.0; }
+  
+  //! Register cutoff distances of this potential with the neighbour list (used for per type pair neighbour list cutoffs)
+  //! \param name unique name of the potential
+  //! \note The neighbour list keeps a pointer to this object, so unregister_cutoff has to be called before it is destroyed
+  void register_cutoff(const string& name)
+  {
+    PairPotential* pot = this;
+    m_nlist->add_cutoff_provider("pair_potential." + name, [pot](int type_1, int type_2) { return pot->get_pair_cutoff(type_1, type_2); });
+  }
+  
+  //! Remove cutoff distances of this potential from the neighbour list
+  //! \param name unique name of the potential
+  void unregister_cutoff(const string& name)
+  {
+    if (m_nlist)
+      m_nlist->remove_cutoff_provider("pair_potential." + name);
+  }
 
   //! Check if there are no illegal parameters
   string params_ok(pairs_type& params)
@@ -0,0 +1,414 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file pair_table_potential.cpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Implementation of PairTablePotential class
+ */ 
+
+#include "pair_table_potential.hpp"
+#include "pair_lj_potential.hpp"
+#include "pair_morse_potential.hpp"
+#include "pair_gaussian_potential.hpp"
+#include "pair_yukawa_potential.hpp"
+
+//! Removes parameters that belong to the table (and not to the source potential)
+//! \param param parameters 
+static pairs_type strip_table_params(pairs_type& param)
+{
+  pairs_type source_param = param;
+  source_param.erase("source");
+  source_param.erase("file");
+  source_param.erase("points");
+  source_param.erase("rmin");
+  source_param.erase("phase_in");
+  source_param.erase("nlist");
+  return source_param;
+}
+
+PairTablePotential::PairTablePotential(SystemPtr sys, MessengerPtr msg, NeighbourListPtr nlist, ValuePtr val, pairs_type& param) : PairPotential(sys, msg, nlist, val, param), m_below_rmin(0)
+{
+  m_known_params.push_back("source");
+  m_known_params.push_back("file");
+  m_known_params.push_back("points");
+  m_known_params.push_back("rmin");
+  m_known_params.push_back("phase_in");
+  if (param.find("source") == param.end())
+  {
+    // Without the source potential all parameters belong to the table
+    string param_test = this->params_ok(param);
+    if (param_test != "")
+    {
+      m_msg->msg(Messenger::ERROR,"Parameter \""+param_test+"\" is not a valid parameter for tabulated pair potential.");
+      throw runtime_error("Unknown parameter \""+param_test+"\" in tabulated potential.");
+    }
+  }
+  
+  if (param.find("points") == param.end())
+  {
+    m_msg->msg(Messenger::WARNING,"No number of table points (points) specified for tabulated pair potential. Setting it to 1000.");
+    m_points = 1000;
+  }
+  else
+  {
+    m_msg->msg(Messenger::INFO,"Number of table points (points) for tabulated pair potential is set to "+param["points"]+".");
+    m_points = lexical_cast<int>(param["points"]);
+  }
+  if (m_points < 2)
+  {
+    m_msg->msg(Messenger::ERROR,"Tabulated pair potential needs at least two table points.");
+    throw runtime_error("Too few points in tabulated potential.");
+  }
+  m_msg->write_config("potential.pair.table.points",lexical_cast<string>(m_points));
+  
+  if (param.find("rmin") == param.end())
+  {
+    m_msg->msg(Messenger::INFO,"No smallest tabulated distance (rmin) specified for tabulated pair potential. Setting it to 10% of the cutoff distance.");
+    m_rmin = 0.0;
+  }
+  else
+  {
+    m_msg->msg(Messenger::INFO,"Smallest tabulated distance (rmin) for tabulated pair potential is set to "+param["rmin"]+".");
+    m_rmin = lexical_cast<double>(param["rmin"]);
+  }
+  m_msg->write_config("potential.pair.table.rmin",lexical_cast<string>(m_rmin));
+  
+  if (param.find("phase_in") != param.end())
+  {
+    m_msg->msg(Messenger::INFO,"Tabulated pair potential. Gradually phasing in the potential for new particles.");
+    m_phase_in = true;
+    m_msg->write_config("potential.pair.table.phase_in","true");
+  }
+  
+  m_pair_params = new TableParameters*[m_ntypes];
+  for (int i = 0; i < m_ntypes; i++)
+  {
+    m_pair_params[i] = new TableParameters[m_ntypes];
+    for (int j = 0; j < m_ntypes; j++)
+    {
+      m_pair_params[i][j].n = 0;
+      m_pair_params[i][j].from_file = false;
+    }
+  }
+  
+  if (param.find("source") != param.end())
+  {
+    m_source_name = param["source"];
+    m_msg->msg(Messenger::INFO,"Tabulated pair potential. Sampling "+m_source_name+" pair potential.");
+    m_msg->write_config("potential.pair.table.source",m_source_name);
+    pairs_type source_param = strip_table_params(param);
+    if (m_source_name == "lj")
+      m_source = PairPotentialPtr(new PairLJPotential(sys, msg, nlist, val, source_param));
+    else if (m_source_name == "morse")
+      m_source = PairPotentialPtr(new PairMorsePotential(sys, msg, nlist, val, source_param));
+    else if (m_source_name == "gaussian")
+      m_source = PairPotentialPtr(new PairGaussianPotential(sys, msg, nlist, val, source_param));
+    else if (m_source_name == "yukawa")
+      m_source = PairPotentialPtr(new PairYukawaPotential(sys, msg, nlist, val, source_param));
+    else
+    {
+      m_msg->msg(Messenger::ERROR,"Pair potential "+m_source_name+" cannot be tabulated. Supported source potentials are lj, morse, gaussian and yukawa.");
+      throw runtime_error("Unsupported source for tabulated pair potential.");
+    }
+    for (int i = 1; i <= m_ntypes; i++)
+      for (int j = i; j <= m_ntypes; j++)
+        this->tabulate_source(i,j);
+  }
+  else if (param.find("file") != param.end())
+  {
+    m_msg->msg(Messenger::INFO,"Tabulated pair potential. Reading table for all particle pairs from file "+param["file"]+".");
+    m_msg->write_config("potential.pair.table.file",param["file"]);
+    for (int i = 1; i <= m_ntypes; i++)
+      for (int j = i; j <= m_ntypes; j++)
+        this->tabulate_file(i,j,param["file"]);
+  }
+  else
+    m_msg->msg(Messenger::WARNING,"Neither source potential nor table file specified for tabulated pair potential. Tables have to be set for each pair of particle types using pair_param command.");
+}
+
+void PairTablePotential::set_pair_parameters(pairs_type& pair_param)
+{
+  int type_1, type_2;
+  
+  if (pair_param.find("type_1") == pair_param.end())
+  {
+    m_msg->msg(Messenger::ERROR,"type_1 has not been defined for pair potential parameters in tabulated potential.");
+    throw runtime_error("Missing key for pair potential parameters.");
+  }
+  if (pair_param.find("type_2") == pair_param.end())
+  {
+    m_msg->msg(Messenger::ERROR,"type_2 has not been defined for pair potential parameters in tabulated potential.");
+    throw runtime_error("Missing key for pair potential parameters.");
+  }
+  type_1 = lexical_cast<int>(pair_param["type_1"]);
+  type_2 = lexical_cast<int>(pair_param["type_2"]);
+  
+  if (pair_param.find("file") != pair_param.end())
+  {
+    m_msg->msg(Messenger::INFO,"Tabulated pair potential. Reading table for particle pair of types "+lexical_cast<string>(type_1)+" and "+lexical_cast<string>(type_2)+" from file "+pair_param["file"]+".");
+    m_msg->write_config("potential.pair.table.type_"+pair_param["type_1"]+"_and_type_"+pair_param["type_2"]+".file",pair_param["file"]);
+    this->tabulate_file(type_1,type_2,pair_param["file"]);
+  }
+  else if (m_source)
+  {
+    pairs_type source_param = strip_table_params(pair_param);
+    m_source->set_pair_parameters(source_param);
+    // Setting pair parameters may change the defaults used by the source for other pairs, so retabulate all of them
+    for (int i = 1; i <= m_ntypes; i++)
+      for (int j = i; j <= m_ntypes; j++)
+        if (!m_pair_params[i-1][j-1].from_file)
+          this->tabulate_source(i,j);
+  }
+  else
+  {
+    m_msg->msg(Messenger::ERROR,"Tabulated pair potential needs either a table file or a source potential for particle pair of types "+lexical_cast<string>(type_1)+" and "+lexical_cast<string>(type_2)+".");
+    throw runtime_error("Missing table for tabulated pair potential.");
+  }
+  
+  m_has_pair_params = true;
+}
+
+void PairTablePotential::compute(double dt)
+{
+  int N = m_system->size();
+  double alpha_i = 1.0;  // phase in factor for particle i
+  double alpha_j = 1.0;  // phase in factor for particle j
+  double alpha = 1.0;    // phase in factor for pair interaction (see below)
+  int below_rmin = 0;    // number of pairs closer than the first table point
+ 
+  if (m_system->compute_per_particle_energy())
+  {
+    for  (int i = 0; i < N; i++)
+    {
+      Particle& p = m_system->get_particle(i);
+      p.set_pot_energy("table",0.0);
+    }
+  }
+
+  // Reset total potential energy to zero
+  m_potential_energy = 0.0;
+  for  (int i = 0; i < N; i++)
+  {
+    Particle& pi = m_system->get_particle(i);
+    if (m_phase_in)
+      alpha_i = 0.5*(1.0 + m_val->get_val(static_cast<int>(pi.age/dt)));
+    TableParameters* table_i = m_pair_params[pi.get_type()-1];
+    vector<int>& neigh = m_nlist->get_neighbours(i);
+    for (unsigned int j = 0; j < neigh.size(); j++)
+    {
+      Particle& pj = m_system->get_particle(neigh[j]);
+      TableParameters& table = table_i[pj.get_type()-1];
+      double dx = pi.x - pj.x, dy = pi.y - pj.y, dz = pi.z - pj.z;
+      m_system->apply_periodic(dx,dy,dz);
+      double r_sq = dx*dx + dy*dy + dz*dz;
+      if (table.n > 0 && r_sq <= table.rcut_sq)
+      {
+        if (m_phase_in)
+        {
+          alpha_j = 0.5*(1.0 + m_val->get_val(static_cast<int>(pj.age/dt)));
+          // Determine global phase in factor: particles start at 0.5 strength (both daugthers of a division replace the mother)
+          // Except for the interaction between daugthers which starts at 0
+          if (alpha_i < 1.0 && alpha_j < 1.0)
+            alpha = alpha_i + alpha_j - 1.0;
+          else 
+            alpha = alpha_i*alpha_j;
+        }
+        double t = (r_sq - table.rmin_sq)*table.inv_h;
+        if (t < 0.0)
+        {
+          t = 0.0;
+          below_rmin++;
+        }
+        int k = static_cast<int>(t);
+        if (k > table.n - 2) k = table.n - 2;
+        t -= k;
+        const double* c = &table.coeff[4*k];
+        // Handle potential 
+        double potential_energy = alpha*(c[0] + t*(c[1] + t*(c[2] + t*c[3])));
+        m_potential_energy += potential_energy;
+        // Handle force (F = -2 dU/d(r^2) r)
+        double force_factor = -2.0*alpha*table.inv_h*(c[1] + t*(2.0*c[2] + 3.0*t*c[3]));
+        pi.fx += force_factor*dx;
+        pi.fy += force_factor*dy;
+        pi.fz += force_factor*dz;
+        // Use 3d Newton's law
+        pj.fx -= force_factor*dx;
+        pj.fy -= force_factor*dy;
+        pj.fz -= force_factor*dz;
+        if (m_system->compute_per_particle_energy())
+        {
+          pi.add_pot_energy("table",potential_energy);
+          pj.add_pot_energy("table",potential_energy);
+        }
+      }
+    }
+  }
+  // Warn only when the number of pairs below the table changes, not on every call
+  if (below_rmin > 0 && below_rmin != m_below_rmin)
+    m_msg->msg(Messenger::WARNING,"Tabulated pair potential. "+lexical_cast<string>(below_rmin)+" particle pairs are closer than the smallest tabulated distance.");
+  m_below_rmin = below_rmin;
+}
+
+/*! Sample source potential at table points.
+ *  \param type_1 type of the first particle
+ *  \param type_2 type of the second particle
+**/
+void PairTablePotential::tabulate_source(int type_1, int type_2)
+{
+  double rcut = m_source->get_pair_cutoff(type_1,type_2);
+  double rmin = (m_rmin > 0.0) ? m_rmin : 0.1*rcut;
+  if (rcut <= rmin)
+  {
+    m_msg->msg(Messenger::ERROR,"Tabulated pair potential. Cutoff distance for particle pair of types "+lexical_cast<string>(type_1)+" and "+lexical_cast<string>(type_2)+" is smaller than the smallest tabulated distance.");
+    throw runtime_error("Invalid table range in tabulated potential.");
+  }
+  double s_min = rmin*rmin, s_max = rcut*rcut;
+  double h = (s_max - s_min)/(m_points - 1);
+  vector<double> pot(m_points), force(m_points);
+  for (int k = 0; k < m_points; k++)
+  {
+    double r = sqrt(s_min + k*h);
+    if (!m_source->evaluate_pair(type_1, type_2, r, pot[k], force[k]))
+    {
+      m_msg->msg(Messenger::ERROR,"Tabulated pair potential. Pair potential "+m_source_name+" cannot be tabulated with the current parameters (e.g., it uses particle radii).");
+      throw runtime_error("Source potential cannot be tabulated.");
+    }
+  }
+  this->build_table(type_1, type_2, s_min, s_max, pot, force);
+  m_pair_params[type_1-1][type_2-1].from_file = false;
+  m_pair_params[type_2-1][type_1-1].from_file = false;
+}
+
+/*! Read table from a file and resample it onto a grid uniform in \f$ r^2 \f$ using 
+ *  cubic Hermite interpolation in \f$ r \f$.
+ *  \param type_1 type of the first particle
+ *  \param type_2 type of the second particle
+ *  \param name file name
+**/
+void PairTablePotential::tabulate_file(int type_1, int type_2, const string& name)
+{
+  ifstream inp(name.c_str());
+  if (!inp)
+  {
+    m_msg->msg(Messenger::ERROR,"Tabulated pair potential. Could not open table file "+name+".");
+    throw runtime_error("Could not open table file.");
+  }
+  vector<double> r_file, pot_file, force_file;
+  string line;
+  while (std::getline(inp, line))
+  {
+    size_t first = line.find_first_not_of(" \t");
+    if (first == string::npos || line[first] == '#') continue;
+    istringstream iss(line);
+    double r, pot, force;
+    if (!(iss >> r >> pot >> force))
+    {
+      m_msg->msg(Messenger::ERROR,"Tabulated pair potential. Could not parse line \""+line+"\" in table file "+name+".");
+      throw runtime_error("Error parsing table file.");
+    }
+    if (r <= 0.0 || (!r_file.empty() && r <= r_file.back()))
+    {
+      m_msg->msg(Messenger::ERROR,"Tabulated pair potential. Distances in table file "+name+" have to be positive and strictly increasing.");
+      throw runtime_error("Error parsing table file.");
+    }
+    r_file.push_back(r);
+    pot_file.push_back(pot);
+    force_file.push_back(force);
+  }
+  inp.close();
+  if (r_file.size() < 2)
+  {
+    m_msg->msg(Messenger::ERROR,"Tabulated pair potential. Table file "+name+" has to contain at least two points.");
+    throw runtime_error("Too few points in table file.");
+  }
+  
+  double rmin = std::max(m_rmin, r_file.front());
+  double rcut = r_file.back();
+  if (rcut <= rmin)
+  {
+    m_msg->msg(Messenger::ERROR,"Tabulated pair potential. Smallest tabulated distance is larger than the largest distance in table file "+name+".");
+    throw runtime_error("Invalid table range in tabulated potential.");
+  }
+  double s_min = rmin*rmin, s_max = rcut*rcut;
+  double h = (s_max - s_min)/(m_points - 1);
+  vector<double> pot(m_points), force(m_points);
+  unsigned int j = 0;
+  for (int k = 0; k < m_points; k++)
+  {
+    double r = std::min(sqrt(s_min + k*h), rcut);
+    while (j < r_file.size() - 2 && r > r_file[j+1]) j++;
+    double dr = r_file[j+1] - r_file[j];
+    double t = (r - r_file[j])/dr;
+    double t_sq = t*t, t_3 = t_sq*t;
+    // Hermite basis functions and their derivatives 
+    double h00 = 2.0*t_3 - 3.0*t_sq + 1.0, h10 = t_3 - 2.0*t_sq + t, h01 = 3.0*t_sq - 2.0*t_3, h11 = t_3 - t_sq;
+    double dh00 = 6.0*(t_sq - t), dh10 = 3.0*t_sq - 4.0*t + 1.0, dh01 = 6.0*(t - t_sq), dh11 = 3.0*t_sq - 2.0*t;
+    double m0 = -force_file[j]*dr, m1 = -force_file[j+1]*dr;
+    pot[k] = h00*pot_file[j] + h10*m0 + h01*pot_file[j+1] + h11*m1;
+    double dU_dr = (dh00*pot_file[j] + dh10*m0 + dh01*pot_file[j+1] + dh11*m1)/dr;
+    force[k] = -dU_dr/r;
+  }
+  this->build_table(type_1, type_2, s_min, s_max, pot, force);
+  m_pair_params[type_1-1][type_2-1].from_file = true;
+  m_pair_params[type_2-1][type_1-1].from_file = true;
+}
+
+/*! Build coefficients of the cubic Hermite spline in \f$ s = r^2 \f$. On each interval 
+ *  \f$ U = c_0 + c_1 t + c_2 t^2 + c_3 t^3 \f$, where \f$ t \f$ is the fractional position within the interval.
+ *  \param type_1 type of the first particle
+ *  \param type_2 type of the second particle
+ *  \param s_min square of the smallest tabulated distance
+ *  \param s_max square of the cutoff distance
+ *  \param pot potential at table points 
+ *  \param force force divided by distance at table points 
+**/
+void PairTablePotential::build_table(int type_1, int type_2, double s_min, double s_max, const vector<double>& pot, const vector<double>& force)
+{
+  int n = pot.size();
+  double h = (s_max - s_min)/(n - 1);
+  TableParameters& table = m_pair_params[type_1-1][type_2-1];
+  table.rmin_sq = s_min;
+  table.rcut_sq = s_max;
+  table.inv_h = 1.0/h;
+  table.n = n;
+  table.coeff.resize(4*(n-1));
+  for (int k = 0; k < n - 1; k++)
+  {
+    // Slopes dU/dt = h dU/ds = -h f/2
+    double m0 = -0.5*h*force[k], m1 = -0.5*h*force[k+1];
+    table.coeff[4*k]   = pot[k];
+    table.coeff[4*k+1] = m0;
+    table.coeff[4*k+2] = 3.0*(pot[k+1] - pot[k]) - 2.0*m0 - m1;
+    table.coeff[4*k+3] = 2.0*(pot[k] - pot[k+1]) + m0 + m1;
+  }
+  if (type_1 != type_2)
+    m_pair_params[type_2-1][type_1-1] = table;
+  
+  double rcut = sqrt(s_max);
+  if (rcut > m_nlist->get_cutoff())
+    m_msg->msg(Messenger::WARNING,"Neighbour list cutoff distance (" + lexical_cast<string>(m_nlist->get_cutoff())+
+    ") is smaller than the table cutoff distance ("+lexical_cast<string>(rcut)+
+    ") for particle pair of types "+lexical_cast<string>(type_1)+" and "+lexical_cast<string>(type_2)+"). Results will not be reliable.");
+  m_msg->write_config("potential.pair.table.type_"+lexical_cast<string>(type_1)+"_and_type_"+lexical_cast<string>(type_2)+".rcut",lexical_cast<string>(rcut));
+}
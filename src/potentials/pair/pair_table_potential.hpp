@@ -0,0 +1,134 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file pair_table_potential.hpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Declaration of PairTablePotential class
+ */ 
+
+#ifndef __PAIR_TABLE_POTENTIAL_HPP__
+#define __PAIR_TABLE_POTENTIAL_HPP__
+
+#include <cmath>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+
+#include "pair_potential.hpp"
+
+using std::make_pair;
+using std::sqrt;
+using std::vector;
+using std::string;
+using std::ifstream;
+using std::istringstream;
+
+//! Structure that handles the interpolation table for a pair of particle types
+struct TableParameters
+{
+  double rmin_sq;             //!< square of the smallest tabulated distance
+  double rcut_sq;             //!< square of the cutoff distance 
+  double inv_h;               //!< inverse spacing of the table (in r^2)
+  int n;                      //!< number of table points (0 if table has not been set)
+  bool from_file;             //!< if true, table has been read from a file
+  vector<double> coeff;       //!< four cubic polynomial coefficients for each table interval
+};
+
+/*! PairTablePotential implements a generic pair potential given by a table. 
+ *  Potential \f$ U \f$ is tabulated for each pair of particle types on a grid 
+ *  uniformly spaced in \f$ s = r^2 \f$ and interpolated with a cubic Hermite spline 
+ *  that matches both the potential and its derivative at the grid points. Force is computed
+ *  as the exact derivative of the interpolated potential, \f$ \vec F = -2\frac{dU}{ds}\vec r \f$, 
+ *  so energy is conserved and no square roots or transcendental functions are evaluated 
+ *  in the inner loop.
+ *  
+ *  Tables can be either read from a file (parameter file), or obtained at startup by 
+ *  sampling an analytic pair potential (parameter source, e.g., source = morse). In the 
+ *  latter case all other parameters are passed to the source potential, as are all 
+ *  subsequent pair_param commands, so the same syntax as for the source potential can be used.
+ *  
+ *  Table files contain three columns: distance \f$ r \f$, potential \f$ U(r) \f$ and force
+ *  \f$ F(r) = -dU/dr \f$. Lines starting with # are ignored. A separate file can be given 
+ *  for each pair of types using the file parameter of the pair_param command.
+ *  
+ *  For distances smaller than the first table point, potential and force divided by distance 
+ *  are held at their values at the first table point (i.e., the magnitude of the force decreases 
+ *  linearly with the distance) and a warning is issued whenever the number of such pairs changes.
+ */
+class PairTablePotential : public PairPotential
+{
+public:
+  
+  //! Constructor
+  //! \param sys Pointer to the System object
+  //! \param msg Pointer to the internal state messenger
+  //! \param nlist Pointer to the global neighbour list
+  //! \param val Value control object (for phasing in)
+  //! \param param Contains information about all parameters (source or file, points, rmin and parameters of the source potential)
+  PairTablePotential(SystemPtr sys, MessengerPtr msg, NeighbourListPtr nlist, ValuePtr val, pairs_type& param);
+  
+  virtual ~PairTablePotential()
+  {
+    for (int i = 0; i < m_ntypes; i++)
+      delete [] m_pair_params[i];
+    delete [] m_pair_params;
+  }
+                                                                                                                
+  //! Set pair parameters data for pairwise interactions    
+  void set_pair_parameters(pairs_type&);
+  
+  //! Returns true since tabulated potential needs neighbour list
+  bool need_nlist() { return true; }
+  
+  //! Returns cutoff distance of the table for the pair of particle types (0 if the table has not been set)
+  double get_pair_cutoff(int type_1, int type_2) { return (m_pair_params[type_1-1][type_2-1].n > 0) ? sqrt(m_pair_params[type_1-1][type_2-1].rcut_sq) : 0.0; }
+  
+  //! Computes potentials and forces for all particles
+  void compute(double);
+  
+  
+private:
+  
+  string m_source_name;             //!< name of the sampled analytic potential (empty if tables are read from files)
+  PairPotentialPtr m_source;        //!< sampled analytic potential 
+  int m_points;                     //!< number of table points
+  double m_rmin;                    //!< smallest tabulated distance (if zero, set to 10% of the cutoff)
+  int m_below_rmin;                 //!< number of particle pairs closer than the smallest tabulated distance in the last call to compute
+  TableParameters** m_pair_params;  //!< type specific tables
+  
+  //! Tabulate source potential for a pair of types
+  void tabulate_source(int, int);
+  
+  //! Read table for a pair of types from a file
+  void tabulate_file(int, int, const string&);
+  
+  //! Build Hermite spline coefficients from potential and force at table points
+  void build_table(int, int, double, double, const vector<double>&, const vector<double>&);
+  
+};
+
+typedef shared_ptr<PairTablePotential> PairTablePotentialPtr;
+
+#endif
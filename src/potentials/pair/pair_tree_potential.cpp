@@ -0,0 +1,366 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file pair_tree_potential.cpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Implementation of PairTreePotential class
+ */ 
+
+#include "pair_tree_potential.hpp"
+
+void PairTreePotential::compute(double)
+{
+  int N = m_system->size();
+  bool per_particle = m_system->compute_per_particle_energy();
+  
+  if (per_particle)
+  {
+    for  (int i = 0; i < N; i++)
+    {
+      Particle& p = m_system->get_particle(i);
+      p.set_pot_energy("tree",0.0);
+    }
+  }
+  
+  m_potential_energy = 0.0;
+  if (N == 0) return;
+  
+  this->build_tree();
+  if (!m_error_checked)
+  {
+    this->estimate_error();
+    m_error_checked = true;
+  }
+  
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(i);
+    if (m_q[p.get_type()-1] == 0.0) continue;
+    double fx, fy, fz, pot;
+    this->tree_force(i, fx, fy, fz, pot);
+    p.fx += fx;
+    p.fy += fy;
+    p.fz += fz;
+    // Each pair is visited from both sides
+    m_potential_energy += 0.5*pot;
+    if (per_particle)
+      p.add_pot_energy("tree",pot);
+  }
+  
+  this->core_force();
+}
+
+//! Sort particles into an octree and compute multipole moments of all nodes
+void PairTreePotential::build_tree()
+{
+  int N = m_system->size();
+  m_index.resize(N);
+  m_buffer.resize(N);
+  m_nodes.clear();
+  
+  double xmin = m_system->get_particle(0).x, xmax = xmin;
+  double ymin = m_system->get_particle(0).y, ymax = ymin;
+  double zmin = m_system->get_particle(0).z, zmax = zmin;
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(i);
+    m_index[i] = i;
+    xmin = std::min(xmin,p.x);  xmax = std::max(xmax,p.x);
+    ymin = std::min(ymin,p.y);  ymax = std::max(ymax,p.y);
+    zmin = std::min(zmin,p.z);  zmax = std::max(zmax,p.z);
+  }
+  double h = 0.5*std::max(xmax-xmin, std::max(ymax-ymin, zmax-zmin));
+  h = (h > 0.0) ? h*(1.0 + 1e-10) : 1.0;
+  this->build_node(0, N, 0.5*(xmin+xmax), 0.5*(ymin+ymax), 0.5*(zmin+zmax), h, 0);
+}
+
+/*! Build a node containing particles m_index[start] to m_index[end-1] and all its children. 
+ *  \param start first particle of the node
+ *  \param end one past the last particle of the node
+ *  \param cx x coordinate of the node centre
+ *  \param cy y coordinate of the node centre
+ *  \param cz z coordinate of the node centre
+ *  \param h half of the node side
+ *  \param depth depth of the node in the tree
+ *  \return index of the node in m_nodes
+**/
+int PairTreePotential::build_node(int start, int end, double cx, double cy, double cz, double h, int depth)
+{
+  int idx = m_nodes.size();
+  m_nodes.push_back(TreeNode());
+  TreeNode& node = m_nodes[idx];
+  node.cx = cx;  node.cy = cy;  node.cz = cz;  node.h = h;
+  node.start = start;  node.end = end;
+  for (int c = 0; c < 8; c++) node.child[c] = -1;
+  // Very deep trees only occur for (nearly) coincident particles; stop subdividing then
+  node.leaf = (end - start <= m_leaf_size || depth >= 32);
+  this->compute_moments(node);
+  if (node.leaf)
+    return idx;
+  
+  // Counting sort of particles into octants
+  int count[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  for (int k = start; k < end; k++)
+  {
+    Particle& p = m_system->get_particle(m_index[k]);
+    int oct = (p.x >= cx) | ((p.y >= cy) << 1) | ((p.z >= cz) << 2);
+    count[oct]++;
+  }
+  int offset[8];
+  offset[0] = start;
+  for (int c = 1; c < 8; c++) offset[c] = offset[c-1] + count[c-1];
+  int pos[8];
+  for (int c = 0; c < 8; c++) pos[c] = offset[c];
+  for (int k = start; k < end; k++)
+  {
+    Particle& p = m_system->get_particle(m_index[k]);
+    int oct = (p.x >= cx) | ((p.y >= cy) << 1) | ((p.z >= cz) << 2);
+    m_buffer[pos[oct]++] = m_index[k];
+  }
+  std::copy(m_buffer.begin()+start, m_buffer.begin()+end, m_index.begin()+start);
+  
+  double hh = 0.5*h;
+  for (int c = 0; c < 8; c++)
+  {
+    if (count[c] == 0) continue;
+    double ccx = cx + ((c & 1) ? hh : -hh);
+    double ccy = cy + ((c & 2) ? hh : -hh);
+    double ccz = cz + ((c & 4) ? hh : -hh);
+    int child = this->build_node(offset[c], offset[c] + count[c], ccx, ccy, ccz, hh, depth+1);
+    m_nodes[idx].child[c] = child;   // m_nodes may have been reallocated, do not use node reference here
+  }
+  return idx;
+}
+
+//! Compute monopole, dipole and second moments of the charge distribution in the node with respect to its centre
+//! \param node node of the octree
+void PairTreePotential::compute_moments(TreeNode& node)
+{
+  node.Q = 0.0;
+  for (int a = 0; a < 3; a++) node.D[a] = 0.0;
+  for (int a = 0; a < 6; a++) node.Qm[a] = 0.0;
+  for (int k = node.start; k < node.end; k++)
+  {
+    Particle& p = m_system->get_particle(m_index[k]);
+    double q = m_q[p.get_type()-1];
+    if (q == 0.0) continue;
+    double sx = p.x - node.cx, sy = p.y - node.cy, sz = p.z - node.cz;
+    node.Q += q;
+    node.D[0] += q*sx;  node.D[1] += q*sy;  node.D[2] += q*sz;
+    node.Qm[0] += q*sx*sx;  node.Qm[1] += q*sy*sy;  node.Qm[2] += q*sz*sz;
+    node.Qm[3] += q*sx*sy;  node.Qm[4] += q*sx*sz;  node.Qm[5] += q*sy*sz;
+  }
+}
+
+/*! Evaluate the kernel \f$ \phi(r) = e^{-\kappa r}/r \f$ together with functions 
+ *  \f$ f_1 = \phi'/r \f$, \f$ f_2 = f_1'/r \f$ and \f$ f_3 = f_2'/r \f$. Derivatives of 
+ *  a radial function are then \f$ \partial_a\phi = f_1 R_a \f$, 
+ *  \f$ \partial_a\partial_b\phi = f_1\delta_{ab} + f_2 R_a R_b \f$, etc.
+ *  \param r distance
+ *  \param phi kernel value 
+ *  \param f1 first radial derivative function
+ *  \param f2 second radial derivative function
+ *  \param f3 third radial derivative function
+**/
+void PairTreePotential::kernel(double r, double& phi, double& f1, double& f2, double& f3)
+{
+  double inv_r = 1.0/r;
+  double inv_r_sq = inv_r*inv_r;
+  double e = (m_kappa > 0.0) ? exp(-m_kappa*r) : 1.0;
+  double kr = m_kappa*r;
+  phi = e*inv_r;
+  f1 = -e*(1.0 + kr)*inv_r*inv_r_sq;
+  f2 = e*(kr*kr + 3.0*kr + 3.0)*inv_r*inv_r_sq*inv_r_sq;
+  f3 = -e*(kr*kr*kr + 6.0*kr*kr + 15.0*kr + 15.0)*inv_r*inv_r_sq*inv_r_sq*inv_r_sq;
+}
+
+/*! Traverse the tree and accumulate the force on particle i. Well separated nodes 
+ *  contribute through their multipole expansions, while leaves that are too close are summed directly. 
+ *  \param i particle index
+ *  \param fx x component of the force
+ *  \param fy y component of the force
+ *  \param fz z component of the force
+ *  \param pot potential energy of the particle (interaction with all other particles)
+**/
+void PairTreePotential::tree_force(int i, double& fx, double& fy, double& fz, double& pot)
+{
+  Particle& pi = m_system->get_particle(i);
+  double aq = m_alpha*m_q[pi.get_type()-1];
+  double theta_sq = m_theta*m_theta;
+  fx = fy = fz = pot = 0.0;
+  
+  m_stack.clear();
+  m_stack.push_back(0);
+  while (!m_stack.empty())
+  {
+    TreeNode& node = m_nodes[m_stack.back()];
+    m_stack.pop_back();
+    double Rx = pi.x - node.cx, Ry = pi.y - node.cy, Rz = pi.z - node.cz;
+    double r_sq = Rx*Rx + Ry*Ry + Rz*Rz;
+    double s = 2.0*node.h;
+    if (s*s < theta_sq*r_sq)
+    {
+      double phi, f1, f2, f3;
+      this->kernel(sqrt(r_sq), phi, f1, f2, f3);
+      const double* Qm = node.Qm;
+      double QRx = Qm[0]*Rx + Qm[3]*Ry + Qm[4]*Rz;
+      double QRy = Qm[3]*Rx + Qm[1]*Ry + Qm[5]*Rz;
+      double QRz = Qm[4]*Rx + Qm[5]*Ry + Qm[2]*Rz;
+      double RQR = Rx*QRx + Ry*QRy + Rz*QRz;
+      double trQ = Qm[0] + Qm[1] + Qm[2];
+      double DR = node.D[0]*Rx + node.D[1]*Ry + node.D[2]*Rz;
+      // Potential and its gradient of the multipole expansion
+      pot += aq*(node.Q*phi - f1*DR + 0.5*f1*trQ + 0.5*f2*RQR);
+      double radial = node.Q*f1 - f2*DR + 0.5*f2*trQ + 0.5*f3*RQR;
+      fx -= aq*(radial*Rx - f1*node.D[0] + f2*QRx);
+      fy -= aq*(radial*Ry - f1*node.D[1] + f2*QRy);
+      fz -= aq*(radial*Rz - f1*node.D[2] + f2*QRz);
+    }
+    else if (node.leaf)
+      this->direct_force(i, node.start, node.end, fx, fy, fz, pot);
+    else
+    {
+      for (int c = 0; c < 8; c++)
+        if (node.child[c] >= 0)
+          m_stack.push_back(node.child[c]);
+    }
+  }
+}
+
+/*! Sum the force on particle i directly over particles m_index[start] to m_index[end-1]. 
+ *  Only the long range part of the interaction is included, the repulsive core is handled by core_force.
+ *  \param i particle index
+ *  \param start first particle in the range
+ *  \param end one past the last particle in the range
+ *  \param fx x component of the force (accumulated)
+ *  \param fy y component of the force (accumulated)
+ *  \param fz z component of the force (accumulated)
+ *  \param pot potential energy of the particle (accumulated)
+**/
+void PairTreePotential::direct_force(int i, int start, int end, double& fx, double& fy, double& fz, double& pot)
+{
+  Particle& pi = m_system->get_particle(i);
+  double aq = m_alpha*m_q[pi.get_type()-1];
+  for (int k = start; k < end; k++)
+  {
+    int j = m_index[k];
+    if (j == i) continue;
+    Particle& pj = m_system->get_particle(j);
+    double qiqj = aq*m_q[pj.get_type()-1];
+    if (qiqj == 0.0) continue;
+    double dx = pi.x - pj.x, dy = pi.y - pj.y, dz = pi.z - pj.z;
+    double r_sq = dx*dx + dy*dy + dz*dz;
+    double phi, f1, f2, f3;
+    this->kernel(sqrt(r_sq), phi, f1, f2, f3);
+    pot += qiqj*phi;
+    double force_factor = -qiqj*f1;
+    fx += force_factor*dx;
+    fy += force_factor*dy;
+    fz += force_factor*dz;
+  }
+}
+
+/*! Repulsive core \f$ 4\left|\alpha q_i q_j\right|\left(\frac \sigma r_{ij}\right)^{12} \f$, shifted to zero at the cutoff, 
+ *  summed over all pairs in the neighbour list that are closer than the cutoff.
+**/
+void PairTreePotential::core_force()
+{
+  int N = m_system->size();
+  bool per_particle = m_system->compute_per_particle_energy();
+  double sigma_sq = m_sigma*m_sigma;
+  double rcut_sq = m_rcut*m_rcut;
+  
+  for  (int i = 0; i < N; i++)
+  {
+    Particle& pi = m_system->get_particle(i);
+    int pi_t = pi.get_type() - 1;
+    double aq = m_alpha*m_q[pi_t];
+    if (aq == 0.0) continue;
+    vector<int>& neigh = m_nlist->get_neighbours(i);
+    for (unsigned int j = 0; j < neigh.size(); j++)
+    {
+      Particle& pj = m_system->get_particle(neigh[j]);
+      int pj_t = pj.get_type() - 1;
+      double qiqj = aq*m_q[pj_t];
+      if (qiqj == 0.0) continue;
+      if (m_has_pair_params)
+      {
+        sigma_sq = m_pair_params[pi_t][pj_t].sigma*m_pair_params[pi_t][pj_t].sigma;
+        rcut_sq = m_pair_params[pi_t][pj_t].rcut*m_pair_params[pi_t][pj_t].rcut;
+      }
+      double dx = pi.x - pj.x, dy = pi.y - pj.y, dz = pi.z - pj.z;
+      m_system->apply_periodic(dx,dy,dz);
+      double r_sq = dx*dx + dy*dy + dz*dz;
+      if (r_sq <= rcut_sq)
+      {
+        double inv_r_sq = sigma_sq/r_sq;
+        double inv_r_6  = inv_r_sq*inv_r_sq*inv_r_sq;
+        double inv_rc_sq = sigma_sq/rcut_sq;
+        double inv_rc_6  = inv_rc_sq*inv_rc_sq*inv_rc_sq;
+        // Handle potential 
+        double potential_energy = 4.0*fabs(qiqj)*(inv_r_6*inv_r_6 - inv_rc_6*inv_rc_6);
+        m_potential_energy += potential_energy;
+        // Handle force
+        double force_factor = 48.0*fabs(qiqj)*inv_r_6*inv_r_6/r_sq;
+        pi.fx += force_factor*dx;
+        pi.fy += force_factor*dy;
+        pi.fz += force_factor*dz;
+        // Use 3d Newton's law
+        pj.fx -= force_factor*dx;
+        pj.fy -= force_factor*dy;
+        pj.fz -= force_factor*dz;
+        if (per_particle)
+        {
+          pi.add_pot_energy("tree",potential_energy);
+          pj.add_pot_energy("tree",potential_energy);
+        }
+      }
+    }
+  }
+}
+
+//! Compare tree code forces on a sample of particles with the exact direct sum and report the relative RMS error
+void PairTreePotential::estimate_error()
+{
+  int N = m_system->size();
+  int nsample = std::min(m_error_sample, N);
+  if (nsample <= 0) return;
+  double err_sq = 0.0, f_sq = 0.0, err_max = 0.0;
+  for (int s = 0; s < nsample; s++)
+  {
+    int i = static_cast<int>((static_cast<long>(s)*N)/nsample);
+    double fx, fy, fz, pot, ex_fx = 0.0, ex_fy = 0.0, ex_fz = 0.0, ex_pot = 0.0;
+    this->tree_force(i, fx, fy, fz, pot);
+    this->direct_force(i, 0, N, ex_fx, ex_fy, ex_fz, ex_pot);
+    double dfx = fx - ex_fx, dfy = fy - ex_fy, dfz = fz - ex_fz;
+    double e_sq = dfx*dfx + dfy*dfy + dfz*dfz;
+    double ex_sq = ex_fx*ex_fx + ex_fy*ex_fy + ex_fz*ex_fz;
+    err_sq += e_sq;
+    f_sq += ex_sq;
+    if (ex_sq > 0.0)
+      err_max = std::max(err_max, sqrt(e_sq/ex_sq));
+  }
+  double rms = (f_sq > 0.0) ? sqrt(err_sq/f_sq) : 0.0;
+  m_msg->msg(Messenger::INFO,"Tree code pair potential. Octree has "+lexical_cast<string>(m_nodes.size())+" nodes. Relative RMS force error estimated from "+lexical_cast<string>(nsample)+" particles is "+lexical_cast<string>(rms)+" (maximum relative error "+lexical_cast<string>(err_max)+").");
+}
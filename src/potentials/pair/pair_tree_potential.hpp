@@ -0,0 +1,387 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file pair_tree_potential.hpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Declaration of PairTreePotential class
+ */ 
+
+#ifndef __PAIR_TREE_POTENTIAL_HPP__
+#define __PAIR_TREE_POTENTIAL_HPP__
+
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+#include "pair_potential.hpp"
+
+using std::make_pair;
+using std::sqrt;
+using std::exp;
+using std::vector;
+
+//! Structure that handles parameters for the tree code pair potential
+struct TreeParameters
+{
+  double sigma;
+  double rcut;
+};
+
+//! Node of the octree used by the tree code
+struct TreeNode
+{
+  double cx, cy, cz;      //!< Centre of the node cube (expansion centre)
+  double h;               //!< Half of the cube side
+  int start, end;         //!< Range of particles (in the sorted index array) that belong to the node
+  int child[8];           //!< Indices of child nodes (-1 if there is no child)
+  bool leaf;              //!< True if the node is not subdivided further
+  double Q;               //!< Total charge (monopole moment)
+  double D[3];            //!< Dipole moment with respect to the node centre
+  double Qm[6];           //!< Second moment of the charge distribution (xx, yy, zz, xy, xz, yz) with respect to the node centre
+};
+
+/*! PairTreePotential computes screened Coulomb (Yukawa) interactions 
+ *  \f$ U\left(r_{ij}\right) = \alpha q_i q_j \frac{e^{-\kappa r_{ij}}}{r_{ij}} \f$ 
+ *  between all pairs of charged particles without truncation. For \f$ \kappa = 0 \f$ it 
+ *  reduces to the bare Coulomb interaction.
+ *  
+ *  Particles are sorted into an octree and interactions with distant nodes are evaluated 
+ *  using the multipole expansion (up to quadrupole order) of the charge distribution in the node. 
+ *  A node of side \f$ s \f$ at distance \f$ d \f$ is accepted if \f$ s/d < \theta \f$, where 
+ *  \f$ \theta \f$ is the opening angle (Barnes and Hut, Nature 324, 446 (1986)). Closer nodes are opened 
+ *  and for leaves interactions are summed directly. Overall cost is \f$ O\left(N\log N\right) \f$.
+ *  
+ *  In addition, all pairs closer than the cutoff \f$ r_c \f$ interact via the LJ repulsive core 
+ *  \f$ 4\left|\alpha q_i q_j\right|\left[\left(\frac \sigma r_{ij}\right)^{12} - \left(\frac \sigma r_c\right)^{12}\right] \f$, 
+ *  which is summed over the neighbour list separately from the tree, i.e. it does not depend on 
+ *  the way particles are partitioned into the tree nodes.
+ *  
+ *  Charges are set per particle type using the pair_type_param command. 
+ *  
+ *  On the first evaluation the accuracy of the tree code is estimated by comparing 
+ *  forces on a small sample of particles with the exact direct summation. 
+ *  
+ *  \note Tree code is intended for non-periodic systems (e.g., particles confined to curved surfaces).
+ *  Use the Ewald potential for periodic systems.
+ */
+class PairTreePotential : public PairPotential
+{
+public:
+  
+  //! Constructor
+  //! \param sys Pointer to the System object
+  //! \param msg Pointer to the internal state messenger
+  //! \param nlist Pointer to the global neighbour list
+  //! \param val Value control object (for phasing in)
+  //! \param param Contains information about all parameters (alpha, kappa, sigma, rcut, q, theta, leaf_size and error_sample)
+  PairTreePotential(SystemPtr sys, MessengerPtr msg, NeighbourListPtr nlist, ValuePtr val, pairs_type& param) : PairPotential(sys, msg, nlist, val, param), m_error_checked(false)
+  {
+    m_known_params.push_back("alpha");
+    m_known_params.push_back("kappa");
+    m_known_params.push_back("sigma");
+    m_known_params.push_back("rcut");
+    m_known_params.push_back("q");
+    m_known_params.push_back("theta");
+    m_known_params.push_back("leaf_size");
+    m_known_params.push_back("error_sample");
+    string param_test = this->params_ok(param);
+    if (param_test != "")
+    {
+      m_msg->msg(Messenger::ERROR,"Parameter \""+param_test+"\" is not a valid parameter for tree code pair potential.");
+      throw runtime_error("Unknown parameter \""+param_test+"\" in tree code potential.");
+    }
+    if (param.find("alpha") == param.end())
+    {
+      m_msg->msg(Messenger::WARNING,"No potential strength (alpha) specified for tree code pair potential. Setting it to 1.");
+      m_alpha = 1.0;
+    }
+    else
+    {
+      m_msg->msg(Messenger::INFO,"Global potential strength (alpha) for tree code pair potential is set to "+param["alpha"]+".");
+      m_alpha = lexical_cast<double>(param["alpha"]);
+    }
+    m_msg->write_config("potential.pair.tree.alpha",lexical_cast<string>(m_alpha));
+    
+    if (param.find("kappa") == param.end())
+    {
+      m_msg->msg(Messenger::WARNING,"No inverse screening length (kappa) specified for tree code pair potential. Setting it to 0 (bare Coulomb interaction).");
+      m_kappa = 0.0;
+    }
+    else
+    {
+      m_msg->msg(Messenger::INFO,"Inverse screening length (kappa) for tree code pair potential is set to "+param["kappa"]+".");
+      m_kappa = lexical_cast<double>(param["kappa"]);
+    }
+    if (m_kappa < 0.0)
+    {
+      m_msg->msg(Messenger::ERROR,"Inverse screening length (kappa) for tree code pair potential has to be non-negative.");
+      throw runtime_error("Negative kappa in tree code potential.");
+    }
+    m_msg->write_config("potential.pair.tree.kappa",lexical_cast<string>(m_kappa));
+    
+    if (param.find("sigma") == param.end())
+    {
+      m_msg->msg(Messenger::WARNING,"No particle diameter (sigma) specified for tree code pair potential. Setting it to 1.");
+      m_sigma = 1.0;
+    }
+    else
+    {
+      m_msg->msg(Messenger::INFO,"Global particle diameter (sigma) for tree code pair potential is set to "+param["sigma"]+".");
+      m_sigma = lexical_cast<double>(param["sigma"]);
+    }
+    m_msg->write_config("potential.pair.tree.sigma",lexical_cast<string>(m_sigma));
+    
+    if (param.find("rcut") == param.end())
+    {
+      m_msg->msg(Messenger::WARNING,"No cutoff distance of the repulsive core (rcut) specified for tree code pair potential. Setting it to 2^(1/6) sigma.");
+      m_rcut = pow(2.0,1.0/6.0)*m_sigma;
+    }
+    else
+    {
+      m_msg->msg(Messenger::INFO,"Global cutoff distance of the repulsive core (rcut) for tree code pair potential is set to "+param["rcut"]+".");
+      m_rcut = lexical_cast<double>(param["rcut"]);
+    }
+    if (m_rcut > m_nlist->get_cutoff())
+    {
+      m_msg->msg(Messenger::ERROR,"Neighbour list cutoff distance (" + lexical_cast<string>(m_nlist->get_cutoff())+
+      ") is smaller than the cutoff distance of the repulsive core for the tree code potential ("+lexical_cast<string>(m_rcut)+").");
+      throw runtime_error("Tree code repulsive core cutoff larger than the neighbour list cutoff.");
+    }
+    m_msg->write_config("potential.pair.tree.rcut",lexical_cast<string>(m_rcut));
+    
+    if (param.find("q") == param.end())
+    {
+      m_msg->msg(Messenger::WARNING,"No charge (q) specified for tree code pair potential. Setting it to 1 for all particle types.");
+      m_q_default = 1.0;
+    }
+    else
+    {
+      m_msg->msg(Messenger::INFO,"Global charge (q) for tree code pair potential is set to "+param["q"]+".");
+      m_q_default = lexical_cast<double>(param["q"]);
+    }
+    m_msg->write_config("potential.pair.tree.q",lexical_cast<string>(m_q_default));
+    
+    if (param.find("theta") == param.end())
+    {
+      m_msg->msg(Messenger::WARNING,"No opening angle (theta) specified for tree code pair potential. Setting it to 0.5.");
+      m_theta = 0.5;
+    }
+    else
+    {
+      m_msg->msg(Messenger::INFO,"Opening angle (theta) for tree code pair potential is set to "+param["theta"]+".");
+      m_theta = lexical_cast<double>(param["theta"]);
+    }
+    if (m_theta < 0.0 || m_theta > 1.0)
+    {
+      m_msg->msg(Messenger::ERROR,"Opening angle (theta) for tree code pair potential has to be between 0 and 1.");
+      throw runtime_error("Invalid opening angle in tree code potential.");
+    }
+    m_msg->write_config("potential.pair.tree.theta",lexical_cast<string>(m_theta));
+    
+    if (param.find("leaf_size") == param.end())
+    {
+      m_msg->msg(Messenger::INFO,"No maximum number of particles in a tree leaf (leaf_size) specified for tree code pair potential. Setting it to 8.");
+      m_leaf_size = 8;
+    }
+    else
+    {
+      m_msg->msg(Messenger::INFO,"Maximum number of particles in a tree leaf (leaf_size) for tree code pair potential is set to "+param["leaf_size"]+".");
+      m_leaf_size = lexical_cast<int>(param["leaf_size"]);
+    }
+    if (m_leaf_size < 1)
+    {
+      m_msg->msg(Messenger::ERROR,"Maximum number of particles in a tree leaf has to be positive.");
+      throw runtime_error("Invalid leaf size in tree code potential.");
+    }
+    m_msg->write_config("potential.pair.tree.leaf_size",lexical_cast<string>(m_leaf_size));
+    
+    if (param.find("error_sample") == param.end())
+      m_error_sample = 10;
+    else
+      m_error_sample = lexical_cast<int>(param["error_sample"]);
+    m_msg->msg(Messenger::INFO,"Tree code pair potential. Accuracy will be estimated using "+lexical_cast<string>(m_error_sample)+" particles.");
+    m_msg->write_config("potential.pair.tree.error_sample",lexical_cast<string>(m_error_sample));
+    
+    if (m_system->get_periodic())
+      m_msg->msg(Messenger::WARNING,"Tree code pair potential ignores periodic boundary conditions. Use Ewald pair potential for periodic systems.");
+    
+    m_q.resize(m_ntypes, m_q_default);
+    
+    m_pair_params = new TreeParameters*[m_ntypes];
+    for (int i = 0; i < m_ntypes; i++)
+    {
+      m_pair_params[i] = new TreeParameters[m_ntypes];
+      for (int j = 0; j < m_ntypes; j++)
+      {
+        m_pair_params[i][j].sigma = m_sigma;
+        m_pair_params[i][j].rcut = m_rcut;
+      }
+    }
+  }
+  
+  virtual ~PairTreePotential()
+  {
+    for (int i = 0; i < m_ntypes; i++)
+      delete [] m_pair_params[i];
+    delete [] m_pair_params;
+  }
+                                                                                                                
+  //! Set pair parameters data for pairwise interactions    
+  void set_pair_parameters(pairs_type& pair_param)
+  {
+    map<string,double> param;
+    
+    int type_1, type_2;
+    
+    if (pair_param.find("type_1") == pair_param.end())
+    {
+      m_msg->msg(Messenger::ERROR,"type_1 has not been defined for pair potential parameters in tree code potential.");
+      throw runtime_error("Missing key for pair potential parameters.");
+    }
+    if (pair_param.find("type_2") == pair_param.end())
+    {
+      m_msg->msg(Messenger::ERROR,"type_2 has not been defined for pair potential parameters in tree code potential.");
+      throw runtime_error("Missing key for pair potential parameters.");
+    }
+    type_1 = lexical_cast<int>(pair_param["type_1"]);
+    type_2 = lexical_cast<int>(pair_param["type_2"]);
+    
+    if (pair_param.find("sigma") != pair_param.end())
+    {
+      m_msg->msg(Messenger::INFO,"Tree code pair potential. Setting sigma to "+pair_param["sigma"]+" for particle pair of types "+lexical_cast<string>(type_1)+" and "+lexical_cast<string>(type_2)+").");
+      param["sigma"] = lexical_cast<double>(pair_param["sigma"]);
+    }
+    else
+    {
+      m_msg->msg(Messenger::INFO,"Tree code pair potential. Using default sigma ("+lexical_cast<string>(m_sigma)+") for particle pair of types "+lexical_cast<string>(type_1)+" and "+lexical_cast<string>(type_2)+").");
+      param["sigma"] = m_sigma;
+    }
+    m_msg->write_config("potential.pair.tree.type_"+pair_param["type_1"]+"_and_type_"+pair_param["type_2"]+".sigma",lexical_cast<string>(param["sigma"]));
+        
+    if (pair_param.find("rcut") != pair_param.end())
+    {
+      m_msg->msg(Messenger::INFO,"Tree code pair potential. Setting rcut to "+pair_param["rcut"]+" for particle pair of types "+lexical_cast<string>(type_1)+" and "+lexical_cast<string>(type_2)+").");
+      param["rcut"] = lexical_cast<double>(pair_param["rcut"]);
+    }
+    else
+    {
+      m_msg->msg(Messenger::INFO,"Tree code pair potential. Using default rcut ("+lexical_cast<string>(m_rcut)+") for particle pair of types "+lexical_cast<string>(type_1)+" and "+lexical_cast<string>(type_2)+").");
+      param["rcut"] = m_rcut;
+    }
+    m_msg->write_config("potential.pair.tree.type_"+pair_param["type_1"]+"_and_type_"+pair_param["type_2"]+".rcut",lexical_cast<string>(param["rcut"]));
+        
+    m_pair_params[type_1-1][type_2-1].sigma = param["sigma"];
+    m_pair_params[type_1-1][type_2-1].rcut = param["rcut"];
+    if (type_1 != type_2)
+    {
+      m_pair_params[type_2-1][type_1-1].sigma = param["sigma"];
+      m_pair_params[type_2-1][type_1-1].rcut = param["rcut"];
+    }
+    
+    m_has_pair_params = true;
+  }
+  
+  //! Set charge for each particle type
+  void set_type_parameters(pairs_type& pair_param)
+  {
+    int type;
+    
+    if (pair_param.find("type") == pair_param.end())
+    {
+      m_msg->msg(Messenger::ERROR,"type has not been defined for particle specific parameters in tree code potential.");
+      throw runtime_error("Missing key for pair potential particle parameters.");
+    }
+    type = lexical_cast<int>(pair_param["type"]);
+    
+    if (pair_param.find("q") != pair_param.end())
+    {
+      m_msg->msg(Messenger::INFO,"Tree code pair potential. Setting charge to "+pair_param["q"]+" for particles of type "+lexical_cast<string>(type)+".");
+      m_q[type-1] = lexical_cast<double>(pair_param["q"]);
+    }
+    else
+    {
+      m_msg->msg(Messenger::INFO,"Tree code pair potential. Using default charge ("+lexical_cast<string>(m_q_default)+") for particles of type "+lexical_cast<string>(type)+".");
+      m_q[type-1] = m_q_default;
+    }
+    m_msg->write_config("potential.pair.tree.type_"+pair_param["type"]+".q",lexical_cast<string>(m_q[type-1]));
+  }
+  
+  //! Returns true since the repulsive core is summed over the neighbour list
+  bool need_nlist() { return true; }
+  
+  //! Returns cutoff distance of the repulsive core for the pair of particle types
+  double get_pair_cutoff(int type_1, int type_2) { return m_has_pair_params ? m_pair_params[type_1-1][type_2-1].rcut : m_rcut; }
+  
+  //! Computes potentials and forces for all particles
+  void compute(double);
+  
+  
+private:
+        
+  double m_alpha;                   //!< potential strength
+  double m_kappa;                   //!< inverse screening length (0 for bare Coulomb)
+  double m_sigma;                   //!< particle diameter (repulsive core)
+  double m_rcut;                    //!< cutoff distance of the repulsive core
+  double m_q_default;               //!< default charge
+  double m_theta;                   //!< opening angle
+  int m_leaf_size;                  //!< maximum number of particles in a leaf
+  int m_error_sample;               //!< number of particles used to estimate the accuracy
+  bool m_error_checked;             //!< if true, accuracy has already been estimated
+  vector<double> m_q;               //!< charge of each particle type
+  TreeParameters** m_pair_params;   //!< type specific pair parameters 
+  
+  vector<TreeNode> m_nodes;         //!< octree nodes (root is the first node)
+  vector<int> m_index;              //!< particle indices sorted such that each node owns a contiguous range
+  vector<int> m_buffer;             //!< scratch space used while sorting particles into octants
+  vector<int> m_stack;              //!< stack of nodes used during the tree traversal
+  
+  //! Build the octree
+  void build_tree();
+  
+  //! Recursively build a node of the octree
+  int build_node(int, int, double, double, double, double, int);
+  
+  //! Compute multipole moments of a node
+  void compute_moments(TreeNode&);
+  
+  //! Evaluate the interaction kernel and its radial derivatives
+  void kernel(double, double&, double&, double&, double&);
+  
+  //! Compute the force and the potential energy of a particle using the tree
+  void tree_force(int, double&, double&, double&, double&);
+  
+  //! Compute the force and the potential energy of a particle by direct summation
+  void direct_force(int, int, int, double&, double&, double&, double&);
+  
+  //! Compute the short range repulsive core over the neighbour list
+  void core_force();
+  
+  //! Estimate accuracy of the tree code
+  void estimate_error();
+    
+};
+
+typedef shared_ptr<PairTreePotential> PairTreePotentialPtr;
+
+#endif
@@ -29,227 +29,180 @@
 
 #include "pair_vertex_particle_potential.hpp"
 
-static int prev(int i, int N)
-{
-  if (i == 0) return N-1;
-  return i-1;
-}
-
-static int next(int i, int N)
-{
-  if (i == N-1) return 0;
-  return i+1;
-}
-
-//! \param dt time step sent by the integrator 
+/*! Compute forces and potential energies. 
+ *
+ *  Force on particle i is the sum over all dual faces (triangles) \f$\nu\f$ it belongs to
+ *  of \f$ -\alpha_i G_\nu \cdot \partial \mathbf{r}_\nu / \partial \mathbf{r}_i \f$, where \f$G_\nu\f$ is 
+ *  the sum of the derivatives of the energies of the three cells that share face centre \f$\nu\f$ 
+ *  with respect to the position of the centre. 
+ *  Computation proceeds in three passes, each of which is parallel (if compiled with OpenMP) 
+ *  and writes only to its own entries: 
+ *  -# face centres, corner vertices and cell centre Jacobians are copied into contiguous arrays;
+ *  -# each cell computes its contribution to \f$G_\nu\f$ for all of its dual corners and its energy;
+ *  -# each particle gathers contributions from faces around it.
+ *  \param dt time step sent by the integrator 
+*/
 void PairVertexParticlePotential::compute(double dt)
 {
   int N = m_system->size();
-  double K = m_K;
-  double gamma = m_gamma;
-  double lambda = m_lambda;
-  double alpha = 1.0;  // phase in factor
-  double pot_eng = 0.0;
   
   if (m_mesh_update_steps > 0)
     if (m_system->get_step() % m_mesh_update_steps == 0)
-      m_nlist->build_mesh();
+      m_nlist->refresh_mesh();
   
   Mesh& mesh = m_system->get_mesh();
+  vector<Vertex>& vertices = mesh.get_vertices();
+  vector<Face>& faces = mesh.get_faces();
+  int nface = faces.size();
   
-  if (m_system->compute_per_particle_energy())
+  // Parameters are looked up in type tables (filled with global values if no type parameters were given)
+  VertexParticleParameters* particle_params = m_particle_params;
+  VertexParticleParameters** pair_params = m_pair_params;
+  bool has_pair_params = m_has_pair_params;
+  bool include_boundary = m_include_boundary;
+  
+  // Pass 1: Copy face centres, corners and Jacobians into contiguous arrays (storage is reused between calls)
+  m_fc_x.resize(nface);  m_fc_y.resize(nface);  m_fc_z.resize(nface);
+  m_fc_hole.resize(nface);
+  m_fc_tri.resize(nface);
+  m_fc_vert.resize(3*nface);
+  m_fc_jac.resize(27*nface);
+  m_grad.assign(9*nface, 0.0);
+#ifdef _OPENMP
+  #pragma omp parallel for
+#endif
+  for (int f = 0; f < nface; f++)
   {
-    for  (int i = 0; i < N; i++)
+    Face& face = faces[f];
+    m_fc_x[f] = face.rc.x;  m_fc_y[f] = face.rc.y;  m_fc_z[f] = face.rc.z;
+    m_fc_hole[f] = face.is_hole ? 1 : 0;
+    m_fc_tri[f] = (!face.is_hole && face.n_sides == 3) ? 1 : 0;
+    if (!m_fc_tri[f])
+      continue;
+    for (int c = 0; c < 3; c++)
     {
-      Particle& p = m_system->get_particle(i);
-      p.set_pot_energy("vp",0.0);
+      m_fc_vert[3*f + c] = face.vertices[c];
+      const Matrix3d& J = face.drcdr[c];
+      double* jac = &m_fc_jac[27*f + 9*c];
+      for (int a = 0; a < 3; a++)
+        for (int b = 0; b < 3; b++)
+          jac[3*a + b] = J.M[a][b];
     }
   }
   
-  m_potential_energy = 0.0;
-  for  (int i = 0; i < N; i++)
+  // Pass 2: For each cell, compute derivative of its energy with respect to each of its dual vertices
+  m_cell_eng.assign(N, 0.0);
+#ifdef _OPENMP
+  #pragma omp parallel for
+#endif
+  for (int k = 0; k < N; k++)
   {
-    Particle& pi = m_system->get_particle(i);
-    Vertex& vi = mesh.get_vertices()[i];
-    Vector3d Nvec = Vector3d(pi.Nx, pi.Ny, pi.Nz);
-    if (m_phase_in)
-      alpha = m_val->get_val(static_cast<int>(pi.age/dt));
-    // First handle the vertex itself
-    if (pi.in_tissue && (m_include_boundary || !vi.boundary))
+    Particle& pk = m_system->get_particle(k);
+    Vertex& vk = vertices[k];
+    if (!pk.in_tissue || !(include_boundary || !vk.boundary))
+      continue;
+    int n = vk.n_faces;
+    if (n == 0)
+      continue;
+    const VertexParticleParameters& par = particle_params[vk.type-1];
+    double dA = vk.area - pk.A0;
+    double area_term = 0.5*par.K*dA;
+    double perim_term = par.gamma*vk.perim;
+    Vector3d Nvec(pk.Nx, pk.Ny, pk.Nz);
+    double eng = 0.5*(par.K*dA*dA + par.gamma*vk.perim*vk.perim);
+    
+    // Dual edge entering slot f (from face f-1 to face f) and its contractility
+    int fid_m = vk.dual[n-1];
+    Vector3d r_m(m_fc_x[fid_m], m_fc_y[fid_m], m_fc_z[fid_m]);
+    int fid = vk.dual[0];
+    Vector3d r(m_fc_x[fid], m_fc_y[fid], m_fc_z[fid]);
+    bool ok_m = !(m_fc_hole[fid_m] || m_fc_hole[fid]);
+    Vector3d e = ok_m ? (r - r_m).unit() : Vector3d(0.0,0.0,0.0);
+    double lambda = has_pair_params ? pair_params[vk.type-1][vertices[vk.dual_neighbour_map[0]].type-1].lambda : par.lambda;
+    for (int f = 0; f < n; f++)
     {
-      if (m_has_part_params) 
-      {
-        K  = m_particle_params[vi.type-1].K;
-        gamma = m_particle_params[vi.type-1].gamma;
-        lambda = m_particle_params[vi.type-1].lambda;
-      }
-      double dA = 0.0; 
-      dA = (vi.area - pi.A0);
-      double area_term = 0.5*K*dA;
-      double perim_term = gamma*vi.perim;
-      pot_eng = 0.5*(K*dA*dA+gamma*vi.perim*vi.perim);
-      Vector3d area_vec(0.0,0.0,0.0);
-      Vector3d perim_vec(0.0,0.0,0.0);
-      Vector3d con_vec(0.0,0.0,0.0);
-      for (int f = 0; f < vi.n_faces; f++)
+      int f_p = (f == n-1) ? 0 : f + 1;
+      int fid_p = vk.dual[f_p];
+      Vector3d r_p(m_fc_x[fid_p], m_fc_y[fid_p], m_fc_z[fid_p]);
+      bool ok_p = !(m_fc_hole[fid] || m_fc_hole[fid_p]);
+      Vector3d e_p = ok_p ? (r_p - r).unit() : Vector3d(0.0,0.0,0.0);
+      double lambda_p = has_pair_params ? pair_params[vk.type-1][vertices[vk.dual_neighbour_map[f_p]].type-1].lambda : par.lambda;
+      
+      if (m_fc_tri[fid])
       {
-        int fid = vi.dual[f];
-        int fid_m = vi.dual[prev(f,vi.n_faces)];
-        int fid_p = vi.dual[next(f,vi.n_faces)];
-        
-        Face& f_nu_m = mesh.get_faces()[fid_m];
-        Face& f_nu   = mesh.get_faces()[fid];
-        Face& f_nu_p = mesh.get_faces()[fid_p];
-         
-        Vector3d& r_nu_m = f_nu_m.rc; 
-        Vector3d& r_nu   = f_nu.rc; 
-        Vector3d& r_nu_p = f_nu_p.rc; 
-        
-        Vector3d cross_prod_1(0.0,0.0,0.0);
-        if (!(f_nu.is_hole || f_nu_p.is_hole)) cross_prod_1 = (cross(r_nu_p, Nvec))*f_nu.get_jacobian(i);
-        if (!(f_nu_m.is_hole || f_nu.is_hole)) cross_prod_1 = cross_prod_1 - (cross(r_nu_m, Nvec))*f_nu.get_jacobian(i);
-        area_vec = area_vec + cross_prod_1;  
-        
-        Vector3d cross_prod_2(0.0,0.0,0.0);
-        if (!(f_nu_m.is_hole || f_nu.is_hole)) cross_prod_2 = ((r_nu - r_nu_m).unit())*f_nu.get_jacobian(i);
-        if (!(f_nu_p.is_hole || f_nu.is_hole)) cross_prod_2 -= (((r_nu_p - r_nu).unit())*f_nu.get_jacobian(i));
-        perim_vec = perim_vec + cross_prod_2; 
-        
-        // Adding force contributions from the dual edges associated with face f and face next(f,vi.n_faces)
-        if (m_has_pair_params)
-        {
-          Vertex& vn = mesh.get_vertices()[vi.dual_neighbour_map[f]];
-          lambda = m_pair_params[vi.type-1][vn.type-1].lambda;
-        } 
-        Vector3d cross_prod_3(0.0,0.0,0.0);
-        if (!(f_nu_m.is_hole || f_nu.is_hole)) cross_prod_3 = lambda*(((r_nu - r_nu_m).unit())*f_nu.get_jacobian(i));
-        con_vec = con_vec + cross_prod_3; 
-        
-        // Adding force contributions from the dual edges associated with face f and face prev(f,vi.n_faces)
-        if (m_has_pair_params)
-        {
-          Vertex& vn = mesh.get_vertices()[vi.dual_neighbour_map[next(f,vi.n_faces)]];
-          lambda = m_pair_params[vi.type-1][vn.type-1].lambda;
-        } 
-        Vector3d cross_prod_4(0.0,0.0,0.0);
-        if (!(f_nu_p.is_hole || f_nu.is_hole)) cross_prod_4 = lambda*(((r_nu_p - r_nu).unit())*f_nu.get_jacobian(i));
-        con_vec = con_vec - cross_prod_4; 
-        
-        pot_eng += lambda*(r_nu - r_nu_m).len();
+        Vector3d area_vec(0.0,0.0,0.0);
+        if (ok_p) area_vec = cross(r_p, Nvec);
+        if (ok_m) area_vec = area_vec - cross(r_m, Nvec);
+        Vector3d grad = area_term*area_vec + perim_term*(e - e_p) + (lambda*e - lambda_p*e_p);
+        const int* fv = &m_fc_vert[3*fid];
+        int c = (fv[0] == k) ? 0 : ((fv[1] == k) ? 1 : 2);
+        double* g = &m_grad[9*fid + 3*c];
+        g[0] = grad.x;  g[1] = grad.y;  g[2] = grad.z;
       }
-      // area term
-      double area_fact = -alpha*area_term;
-      pi.fx += area_fact*area_vec.x;
-      pi.fy += area_fact*area_vec.y;
-      pi.fz += area_fact*area_vec.z;
-      // perimeter term 
-      double perim_fact = -alpha*perim_term;
-      pi.fx += perim_fact*perim_vec.x;
-      pi.fy += perim_fact*perim_vec.y;
-      pi.fz += perim_fact*perim_vec.z;
-      // Add contractile term
-      pi.fx -= alpha*con_vec.x;
-      pi.fy -= alpha*con_vec.y;
-      pi.fz -= alpha*con_vec.z;
-      // add potential energy
-      m_potential_energy += pot_eng;
+      eng += (has_pair_params ? lambda_p : par.lambda)*(r - r_m).len();
+      
+      r_m = r;  r = r_p;
+      fid = fid_p;
+      e = e_p;  ok_m = ok_p;
+      lambda = lambda_p;
+    }
+    m_cell_eng[k] = eng;
+  }
+  
+  // Pass 3: Gather forces from all faces around each particle
+#ifdef _OPENMP
+  #pragma omp parallel for
+#endif
+  for (int i = 0; i < N; i++)
+  {
+    Particle& pi = m_system->get_particle(i);
+    Vertex& vi = vertices[i];
+    double alpha = m_phase_in ? m_val->get_val(static_cast<int>(pi.age/dt)) : 1.0;
+    double fx = 0.0, fy = 0.0, fz = 0.0;
+    for (int f = 0; f < vi.n_faces; f++)
+    {
+      int fid = vi.faces[f];
+      if (!m_fc_tri[fid])
+        continue;
+      const double* g = &m_grad[9*fid];
+      double gx = g[0] + g[3] + g[6];
+      double gy = g[1] + g[4] + g[7];
+      double gz = g[2] + g[5] + g[8];
+      const int* fv = &m_fc_vert[3*fid];
+      int c = (fv[0] == i) ? 0 : ((fv[1] == i) ? 1 : 2);
+      const double* J = &m_fc_jac[27*fid + 9*c];   // row major, J[3*a+b] = d rc_a / d r_b
+      fx += J[0]*gx + J[3]*gy + J[6]*gz;
+      fy += J[1]*gx + J[4]*gy + J[7]*gz;
+      fz += J[2]*gx + J[5]*gy + J[8]*gz;
     }
-    // Now check neighbours
-    for (int j = 0; j < vi.n_edges; j++)
+    pi.fx -= alpha*fx;
+    pi.fy -= alpha*fy;
+    pi.fz -= alpha*fz;
+    if (m_compute_stress && !vi.boundary && vi.area > 0)
     {
-      Particle& pj = m_system->get_particle(vi.neigh[j]);
-      Vertex& vj = mesh.get_vertices()[vi.neigh[j]];
-      if (pj.in_tissue && (m_include_boundary || !vj.boundary))  
+      double inv_area = 1.0/vi.area;
+      for (int j = 0; j < vi.n_edges; j++)
       {
-        if (m_has_part_params) 
-        {
-          K  = m_particle_params[vj.type-1].K;
-          gamma = m_particle_params[vj.type-1].gamma;
-          lambda = m_particle_params[vj.type-1].lambda;
-        }
-        double dA = 0.0;
-        dA = (vj.area - pj.A0);
-        double area_term = 0.5*K*dA;
-        double perim_term = gamma*vj.perim;
-        Vector3d area_vec(0.0,0.0,0.0);
-        Vector3d perim_vec(0.0,0.0,0.0);
-        Vector3d con_vec(0.0,0.0,0.0);
-        Vector3d Nvec = Vector3d(pj.Nx, pj.Ny, pj.Nz);
-        
-        for (int f = 0; f < vj.n_faces; f++)
-        {
-          int fid = vj.dual[f];
-          Face& f_nu   = mesh.get_faces()[fid];
-          if (f_nu.has_vertex(i))
-          {
-            int fid_m = vj.dual[prev(f,vj.n_faces)];
-            int fid_p = vj.dual[next(f,vj.n_faces)];
-            Face& f_nu_m = mesh.get_faces()[fid_m];
-            Face& f_nu_p = mesh.get_faces()[fid_p];
-            Vector3d& r_nu_m = f_nu_m.rc; 
-            Vector3d& r_nu   = f_nu.rc; 
-            Vector3d& r_nu_p = f_nu_p.rc; 
-
-            Vector3d cross_prod_1(0.0,0.0,0.0);
-            if (!(f_nu.is_hole || f_nu_p.is_hole)) cross_prod_1 = cross(r_nu_p, Nvec)*f_nu.get_jacobian(i);
-            if (!(f_nu_m.is_hole || f_nu.is_hole)) cross_prod_1 = cross_prod_1 - cross(r_nu_m, Nvec)*f_nu.get_jacobian(i);
-            area_vec = area_vec + cross_prod_1; 
-            
-            Vector3d cross_prod_2(0.0,0.0,0.0);
-            if (!(f_nu_m.is_hole || f_nu.is_hole)) cross_prod_2 = ((r_nu - r_nu_m).unit())*f_nu.get_jacobian(i);
-            if (!(f_nu_p.is_hole || f_nu.is_hole)) cross_prod_2 -= ((r_nu_p - r_nu).unit())*f_nu.get_jacobian(i);
-            perim_vec = perim_vec + cross_prod_2; 
-            
-            // Adding force contributions from the dual edges associated with face f and face next(f,vi.n_faces)
-            if (m_has_pair_params)
-            {
-              Vertex& vn = mesh.get_vertices()[vj.dual_neighbour_map[f]];
-              lambda = m_pair_params[vj.type-1][vn.type-1].lambda;
-            } 
-            Vector3d cross_prod_3(0.0,0.0,0.0);
-            if (!(f_nu_m.is_hole || f_nu.is_hole)) cross_prod_3 = lambda*(((r_nu - r_nu_m).unit())*f_nu.get_jacobian(i));
-            con_vec = con_vec + cross_prod_3; 
-
-            // Adding force contributions from the dual edges associated with face f and face next(f,vi.n_faces)
-            if (m_has_pair_params)
-            {
-              Vertex& vn = mesh.get_vertices()[vj.dual_neighbour_map[next(f,vj.n_faces)]];
-              lambda = m_pair_params[vj.type-1][vn.type-1].lambda;
-            } 
-            Vector3d cross_prod_4(0.0,0.0,0.0);
-            if (!(f_nu_p.is_hole || f_nu.is_hole)) cross_prod_4 = lambda*(((r_nu_p - r_nu).unit())*f_nu.get_jacobian(i));
-            con_vec = con_vec - cross_prod_4; 
-            
-          }
-        }
-        // area term
-        double area_fact = -alpha*area_term;
-        pi.fx += area_fact*area_vec.x;
-        pi.fy += area_fact*area_vec.y;
-        pi.fz += area_fact*area_vec.z;
-        // perimeter term
-        double perim_fact = -alpha*perim_term;
-        pi.fx += perim_fact*perim_vec.x;
-        pi.fy += perim_fact*perim_vec.y;
-        pi.fz += perim_fact*perim_vec.z;
-        // Add contractile term
-        pi.fx -= alpha*con_vec.x;
-        pi.fy -= alpha*con_vec.y;
-        pi.fz -= alpha*con_vec.z;
-        if (m_compute_stress)
+        Particle& pj = m_system->get_particle(vi.neigh[j]);
+        if (pj.in_tissue && (include_boundary || !vertices[vi.neigh[j]].boundary))
         {
-          if (!vi.boundary && vi.area > 0)
-          {
-            double inv_area = 1.0/vi.area;
-            pi.s_xx *= inv_area;  pi.s_xy *= inv_area; pi.s_xz *= inv_area;
-            pi.s_yx *= inv_area;  pi.s_yy *= inv_area; pi.s_yz *= inv_area;
-            pi.s_zx *= inv_area;  pi.s_zy *= inv_area; pi.s_zz *= inv_area;
-          }
+          pi.s_xx *= inv_area;  pi.s_xy *= inv_area; pi.s_xz *= inv_area;
+          pi.s_yx *= inv_area;  pi.s_yy *= inv_area; pi.s_yz *= inv_area;
+          pi.s_zx *= inv_area;  pi.s_zy *= inv_area; pi.s_zz *= inv_area;
         }
       }
     }
-    // potential energy
-    if (m_system->compute_per_particle_energy())
-      pi.add_pot_energy("vp",pot_eng);
+  }
+  
+  m_potential_energy = 0.0;
+  for (int i = 0; i < N; i++)
+    m_potential_energy += m_cell_eng[i];
+  if (m_system->compute_per_particle_energy())
+  {
+    for  (int i = 0; i < N; i++)
+    {
+      Particle& p = m_system->get_particle(i);
+      p.set_pot_energy("vp",m_cell_eng[i]);
+    }
   }
 }
@@ -286,6 +286,16 @@ private:
   bool m_include_boundary;          //!< if true, include boudary terms in force calculation
   VertexParticleParameters*  m_particle_params;   //!< type specific particle parameters 
   VertexParticleParameters** m_pair_params;       //!< type specific pair parameters 
+  
+  vector<double> m_fc_x;            //!< x coordinates of face centres (contiguous copy used by the force kernel)
+  vector<double> m_fc_y;            //!< y coordinates of face centres
+  vector<double> m_fc_z;            //!< z coordinates of face centres
+  vector<char> m_fc_hole;           //!< 1 if face is a hole
+  vector<char> m_fc_tri;            //!< 1 if face is a triangle that contributes to forces (not a hole)
+  vector<int> m_fc_vert;            //!< Corner vertices of each triangular face (3 per face)
+  vector<double> m_fc_jac;          //!< Cell centre Jacobians of each triangular face (3 corners x 3x3 matrix, row major)
+  vector<double> m_grad;            //!< Derivatives of cell energies with respect to face centres (3 corners x 3 components per face)
+  vector<double> m_cell_eng;        //!< Energy of each cell
      
 };
 
@@ -58,6 +58,11 @@ void PairYukawaPotential::compute(double dt)
       double dx = pi.x - pj.x, dy = pi.y - pj.y, dz = pi.z - pj.z;
       m_system->apply_periodic(dx,dy,dz);
       double r_sq = dx*dx + dy*dy + dz*dz;
+      if (m_has_pair_params)
+      {
+        rcut = m_pair_params[pi.get_type()-1][pj.get_type()-1].rcut;
+        rcut_sq = rcut*rcut;
+      }
       if (r_sq <= rcut_sq)
       {
         if (m_has_pair_params)
@@ -193,8 +193,31 @@ public:
     m_has_pair_params = true;
   }
   
-  //! Returns false since Yukawa potential does not need neighbour list
-  bool need_nlist() { return false; }
+  //! Returns true since Yukawa potential uses neighbour list
+  bool need_nlist() { return true; }
+  
+  //! Evaluate Yukawa interaction for particles of given types (used for tabulation)
+  //! \param type_1 type of the first particle
+  //! \param type_2 type of the second particle
+  //! \param r interparticle distance
+  //! \param pot potential energy
+  //! \param force_factor magnitude of the force divided by the distance (positive for repulsion)
+  bool evaluate_pair(int type_1, int type_2, double r, double& pot, double& force_factor)
+  {
+    double g = m_g, kappa = m_kappa;
+    if (m_has_pair_params)
+    {
+      g = m_pair_params[type_1-1][type_2-1].g;
+      kappa = m_pair_params[type_1-1][type_2-1].kappa;
+    }
+    double exp_fact = g*exp(-kappa*r);
+    pot = exp_fact/r;
+    force_factor = exp_fact*(1.0 + kappa*r)/(r*r*r);
+    return true;
+  }
+  
+  //! Returns cutoff distance for the pair of particle types
+  double get_pair_cutoff(int type_1, int type_2) { return m_has_pair_params ? m_pair_params[type_1-1][type_2-1].rcut : m_rcut; }
   
   //! Computes potentials and forces for all particles
   void compute(double);
@@ -36,19 +36,43 @@
 void Potential::compute(double dt)
 {
   //m_system->reset_forces();
+  this->compute_nonbonded(dt);
+  this->compute_bonded();
+}
+
+/*! Iterate over all pair and external potentials and compute 
+ *  their potential energies and forces
+ *  \param dt step size (used to phase in particles)
+ */
+void Potential::compute_nonbonded(double dt)
+{
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
   PairPotType::iterator it_pair;
   ExternPotType::iterator it_ext;
-  BondPotType::iterator it_bond;
-  AnglePotType::iterator it_angle;
   
+  // Particles have moved, so geometry of the mesh boundary has to be recomputed (once for all boundary potentials)
+  m_system->get_mesh().invalidate_boundary_geometry();
   for(it_pair = m_pair_interactions.begin(); it_pair != m_pair_interactions.end(); it_pair++)
     (*it_pair).second->compute(dt);
   for(it_ext = m_external_potentials.begin(); it_ext != m_external_potentials.end(); it_ext++)
     (*it_ext).second->compute();
+  m_nonbonded_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/*! Iterate over all bond and angle potentials and compute 
+ *  their potential energies and forces
+ */
+void Potential::compute_bonded()
+{
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  BondPotType::iterator it_bond;
+  AnglePotType::iterator it_angle;
+  
   for(it_bond = m_bond.begin(); it_bond != m_bond.end(); it_bond++)
     (*it_bond).second->compute();
   for(it_angle = m_angle.begin(); it_angle != m_angle.end(); it_angle++)
     (*it_angle).second->compute();
+  m_bonded_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
 }
 
 /*! Iterate over all pair, external, bond and angle force computes  
@@ -33,6 +33,7 @@
 #include <map>
 #include <string>
 #include <vector>
+#include <chrono>
 
 using std::map;
 using std::string;
@@ -63,11 +64,13 @@ public:
   //! Construct Potential object
   //! \param sys Reference to the System object
   //! \param msg Reference to the system wide messenger
-  Potential(SystemPtr sys, const MessengerPtr msg) : m_system(sys), m_msg(msg), m_need_nlist(false) { }
+  Potential(SystemPtr sys, const MessengerPtr msg) : m_system(sys), m_msg(msg), m_need_nlist(false), m_nonbonded_time(0.0), m_bonded_time(0.0) { }
   
   //! Destructor
   ~Potential()
   {
+    for (PairPotType::iterator it = m_pair_interactions.begin(); it != m_pair_interactions.end(); it++)
+      (*it).second->unregister_cutoff((*it).first);
     m_pair_interactions.clear();
     m_external_potentials.clear();
     m_bond.clear();
@@ -79,11 +82,16 @@ public:
   //! \param pot Pointer to the pair potential object
   void add_pair_potential(const string& name, PairPotentialPtr pot)
   {
+    if (m_pair_interactions.find(name) != m_pair_interactions.end())   // Potential is being replaced
+      m_pair_interactions[name]->unregister_cutoff(name);
     m_pair_interactions[name] = pot;
     m_need_nlist = m_need_nlist | pot->need_nlist();
     m_msg->msg(Messenger::INFO,"Added pair potential : " + name + " to the list of pair interactions.");
     if (pot->need_nlist())
+    {
       m_msg->msg(Messenger::INFO,"Pair potential " + name + " has neighbour list. Neighbour list updates will be performed during the simulation.");
+      pot->register_cutoff(name);
+    }
   }
   
   //! Add external potential to the list of all external potentials
@@ -210,6 +218,24 @@ public:
   //! Compute all forces and potentials in the system
   void compute(double);
   
+  //! Compute forces and potentials due to pair interactions and external potentials
+  void compute_nonbonded(double);
+  
+  //! Compute forces and potentials due to bonds and angles
+  void compute_bonded();
+  
+  //! Returns true if there are bond or angle potentials
+  bool has_bonded() { return (m_bond.size() > 0 || m_angle.size() > 0); }
+  
+  //! Returns wall clock time (in seconds) spent in computing pair and external forces since the last reset
+  double get_nonbonded_time() { return m_nonbonded_time; }
+  
+  //! Returns wall clock time (in seconds) spent in computing bond and angle forces since the last reset
+  double get_bonded_time() { return m_bonded_time; }
+  
+  //! Reset force computation timers (called at the beginning of each run)
+  void reset_timers() { m_nonbonded_time = 0.0; m_bonded_time = 0.0; }
+  
 private:
   
   SystemPtr m_system;            //!< Contains pointer to the System object
@@ -221,6 +247,9 @@ private:
   AnglePotType m_angle;                 //!< Contains information about all angles
   
   bool m_need_nlist;                  //!< If true, there are potentials that need neighbour list
+  
+  double m_nonbonded_time;            //!< Time spent in pair and external force computes (used for benchmarking)
+  double m_bonded_time;               //!< Time spent in bond and angle force computes (used for benchmarking)
    
 };
 
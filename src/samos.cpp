@@ -32,6 +32,7 @@
 #include <string>
 #include <fstream>
 #include <ctime>
+#include <chrono>
 
 #include <boost/functional/factory.hpp>
 #include <boost/function.hpp>
@@ -46,6 +47,124 @@
 using std::map;
 using std::string;
 
+/*! Update all named neighbour lists (in the order they were defined, so that parent lists 
+ *  are always handled before the lists derived from them).
+ *  \param sys pointer to the System object
+ *  \param named_nlists named neighbour lists
+ *  \param force if true, rebuild all lists; otherwise rebuild only lists for which some particle moved too far 
+ *  \param rescale if different from 1, rescale cutoff distance of all lists (this also rebuilds them)
+ *  \return number of lists that were rebuilt
+*/
+static int update_named_nlists(SystemPtr sys, vector<NeighbourListPtr>& named_nlists, bool force, double rescale = 1.0)
+{
+  int builds = 0;
+  for (vector<NeighbourListPtr>::iterator it_n = named_nlists.begin(); it_n != named_nlists.end(); it_n++)
+  {
+    bool rebuild = force;
+    for (int i = 0; !rebuild && i < sys->size(); i++)
+      if ((*it_n)->need_update(sys->get_particle(i)))
+        rebuild = true;
+    if (rebuild)
+    {
+      if (rescale != 1.0)
+        (*it_n)->rescale_cutoff(rescale);
+      else
+        (*it_n)->build();
+      builds++;
+    }
+  }
+  return builds;
+}
+
+/*! Total time spent in building the global and all named neighbour lists
+ *  \param nlist global neighbour list (may be empty)
+ *  \param named_nlists all named neighbour lists
+*/
+static double nlist_build_time(NeighbourListPtr nlist, vector<NeighbourListPtr>& named_nlists)
+{
+  double t = nlist ? nlist->get_build_time() : 0.0;
+  for (vector<NeighbourListPtr>::iterator it_n = named_nlists.begin(); it_n != named_nlists.end(); it_n++)
+    t += (*it_n)->get_build_time();
+  return t;
+}
+
+//! Wall clock time (in seconds) elapsed since a given time point
+static double seconds_since(const std::chrono::steady_clock::time_point& start)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/*! Report how long the run took and how the time was split between different parts of the code.
+ *  Times are reported in ns per particle-step. The same numbers are stored under "run.stats" in the 
+ *  configuration file (if one has been requested with the "config" command) so that they can be 
+ *  processed by benchmarking scripts.
+ *  \param msg pointer to the Messenger object
+ *  \param total total wall clock time of the run (in seconds)
+ *  \param particle_steps sum of system sizes over all steps
+ *  \param steps number of steps
+ *  \param nlist_builds number of neighbour list builds
+ *  \param t_nlist time spent building and checking neighbour lists
+ *  \param t_nonbonded time spent in pair and external force computes
+ *  \param t_bonded time spent in bond and angle force computes
+ *  \param t_align time spent in alignment computes
+ *  \param t_integrate time spent in integrators (including force and alignment computes)
+ *  \param t_constraint time spent in rescaling constraints
+ *  \param t_population time spent in population control 
+ *  \param t_output time spent in dumps and logs
+*/
+static void report_run_timing(MessengerPtr msg, double total, double particle_steps, int steps, int nlist_builds, double t_nlist, 
+                              double t_nonbonded, double t_bonded, double t_align, double t_integrate, double t_constraint, double t_population, double t_output)
+{
+  double ns = (particle_steps > 0.0) ? 1e9/particle_steps : 0.0;
+  vector<std::pair<string,double> > parts;
+  parts.push_back(std::make_pair("neighbour_list", t_nlist));
+  parts.push_back(std::make_pair("nonbonded_forces", t_nonbonded));
+  parts.push_back(std::make_pair("bonded_forces", t_bonded));
+  parts.push_back(std::make_pair("alignment", t_align));
+  parts.push_back(std::make_pair("integration", std::max(0.0, t_integrate - t_nonbonded - t_bonded - t_align)));
+  parts.push_back(std::make_pair("constraint", t_constraint));
+  parts.push_back(std::make_pair("population", t_population));
+  parts.push_back(std::make_pair("output", t_output));
+  string breakdown;
+  for (unsigned int i = 0; i < parts.size(); i++)
+  {
+    breakdown += ((i > 0) ? ", " : "") + parts[i].first + " " + lexical_cast<string>(ns*parts[i].second);
+    msg->write_config("run.stats.breakdown."+parts[i].first, lexical_cast<string>(ns*parts[i].second));
+  }
+  long rss = peak_rss_kb();
+  msg->msg(Messenger::INFO,"Run took "+lexical_cast<string>(total)+" s ("+lexical_cast<string>(ns*total)+" ns per particle-step). Peak memory use : "+lexical_cast<string>(rss)+" kB.");
+  msg->msg(Messenger::INFO,"Time per particle-step (ns) : "+breakdown+".");
+  msg->write_config("run.stats.steps", lexical_cast<string>(steps));
+  msg->write_config("run.stats.average_size", lexical_cast<string>(particle_steps/steps));
+  msg->write_config("run.stats.wall_time", lexical_cast<string>(total));
+  msg->write_config("run.stats.ns_per_particle_step", lexical_cast<string>(ns*total));
+  msg->write_config("run.stats.nlist_builds", lexical_cast<string>(nlist_builds));
+  msg->write_config("run.stats.peak_rss_kb", lexical_cast<string>(rss));
+}
+
+/*! Select neighbour list requested with "nlist" parameter. If no list is requested, return global list.
+ *  The "nlist" key is removed from the parameters, since it is not a parameter of the potential or aligner itself.
+ *  \param msg pointer to the Messenger object
+ *  \param nlist global neighbour list
+ *  \param nlists all named neighbour lists
+ *  \param param parameters of the command
+ *  \param line current line in the command file (for error reporting)
+*/
+static NeighbourListPtr select_nlist(MessengerPtr msg, NeighbourListPtr nlist, map<string,NeighbourListPtr>& nlists, pairs_type& param, int line)
+{
+  if (param.find("nlist") == param.end())
+    return nlist;
+  if (nlists.find(param["nlist"]) == nlists.end())
+  {
+    msg->msg(Messenger::ERROR,"Neighbour list "+param["nlist"]+" requested in line "+lexical_cast<string>(line)+" has not been defined.");
+    throw std::runtime_error("Unknown neighbour list.");
+  }
+  msg->msg(Messenger::INFO,"Using neighbour list "+param["nlist"]+".");
+  NeighbourListPtr selected = nlists[param["nlist"]];
+  param.erase("nlist");
+  return selected;
+}
+
 
 int main(int argc, char* argv[])
 {
@@ -68,6 +187,7 @@ int main(int argc, char* argv[])
   BondData                bond_data;
   AngleData               angle_data;
   TimeStepData            timestep_data;
+  NlistData               nlist_data;
   pairs_type              parameter_data;   // All parameters for different commands
   
   // Parser grammars
@@ -89,6 +209,7 @@ int main(int argc, char* argv[])
   bond_grammar                    bond_parser(bond_data);
   angle_grammar                   angle_parser(angle_data);
   timestep_grammar                timestep_parser(timestep_data);
+  nlist_grammar                   nlist_parser(nlist_data);
   key_value_sequence              param_parser;
   
   // Class factories 
@@ -112,6 +233,8 @@ int main(int argc, char* argv[])
   PotentialPtr pot;                                // Handles all potentials
   ConstrainerPtr constraint;                       // Handles constrints to the manifold
   NeighbourListPtr nlist;                          // Handles global neighbour list
+  map<string,NeighbourListPtr> nlists;             // Handles named neighbour lists (e.g., one list per pair potential)
+  vector<NeighbourListPtr> named_nlists;           // Named neighbour lists in the order they were defined
   map<string,IntegratorPtr> integrator;            // Handles the integrator
   AlignerPtr    aligner;                           // Handles all aligners
   ExternalAlignPtr external_aligner;               // Handles all external aligners
@@ -216,6 +339,12 @@ int main(int argc, char* argv[])
               box = std::make_shared<Box>(Box(lx,ly,lz));
               if (defined["messages"])   msg->msg(Messenger::INFO,"Simulation box is "+box_data.type+" with size (lx,ly,lz) = ("+lexical_cast<string>(lx)+","+lexical_cast<string>(ly)+","+lexical_cast<string>(lz)+").");
               else  std::cout << "Simulation box is "+box_data.type+" with size (lx,ly,lz) = ("+lexical_cast<string>(lx)+","+lexical_cast<string>(ly)+","+lexical_cast<string>(lz)+")." << std::endl;
+              if (parameter_data.find("planar") != parameter_data.end())
+              {
+                box->planar = true;
+                if (defined["messages"])   msg->msg(Messenger::INFO,"Simulation box is planar. Cell lists and integrators will ignore the z direction.");
+                else  std::cout << "Simulation box is planar. Cell lists and integrators will ignore the z direction." << std::endl;
+              }
             }
             else
             {
@@ -352,10 +481,11 @@ int main(int argc, char* argv[])
                 std::string phase_in = "constant";
                 if (parameter_data.find("phase_in") != parameter_data.end())
                     phase_in = parameter_data["phase_in"];                
+                NeighbourListPtr pair_nlist = select_nlist(msg,nlist,nlists,parameter_data,current_line);
                 pot->add_pair_potential(potential_data.type, pair_potentials[potential_data.type](
                                                                                                   sys,
                                                                                                   msg,
-                                                                                                  nlist,
+                                                                                                  pair_nlist,
                                                                                                   std::shared_ptr<Value>(values[phase_in](msg,parameter_data)),
                                                                                                   parameter_data
                                                                                                  ));
@@ -513,6 +643,12 @@ int main(int argc, char* argv[])
               }
               if (qi::phrase_parse(constraint_data.params.begin(), constraint_data.params.end(), param_parser, qi::space, parameter_data))
               {
+                // Integrators skip the z direction in planar boxes, so particles have to be confined to the xy plane
+                if (sys->get_box()->planar && constraint_data.type != "plane" && constraint_data.type != "walls")
+                {
+                  msg->msg(Messenger::ERROR,"Simulation box is planar, but constraint "+constraint_data.type+" in line "+lexical_cast<string>(current_line)+" does not confine particles to the xy plane. Use plane or walls constraint.");
+                  throw std::runtime_error("Planar box requires plane constraint.");
+                }
                 //constraint = std::shared_ptr<Constraint>(constraints[constraint_data.type](sys,msg,parameter_data));  // dirty workaround shared_ptr and inherited classes
                 constraint->add_constraint(constraint_data.type,constraints[constraint_data.type](sys,msg,parameter_data));
                 msg->msg(Messenger::INFO,"Adding constraint of type "+constraint_data.type+".");
@@ -542,15 +678,46 @@ int main(int argc, char* argv[])
                 std::cerr << "System has not been defined. Please define system using \"input\" command before adding neighbour list." << std::endl;
               throw std::runtime_error("System not defined.");
             }
-            if (qi::phrase_parse(command_data.attrib_param_complex.begin(), command_data.attrib_param_complex.end(), param_parser, qi::space, parameter_data))
+            nlist_data.name = "";
+            if (qi::phrase_parse(command_data.attrib_param_complex.begin(), command_data.attrib_param_complex.end(), nlist_parser, qi::space) &&
+                qi::phrase_parse(nlist_data.params.begin(), nlist_data.params.end(), param_parser, qi::space, parameter_data))
             {
               double rcut = DEFAULT_CUTOFF;
               double pad = DEFAULT_PADDING;
               if (parameter_data.find("rcut") != parameter_data.end()) rcut = lexical_cast<double>(parameter_data["rcut"]);
               if (parameter_data.find("pad") != parameter_data.end())  pad = lexical_cast<double>(parameter_data["pad"]);
-              nlist = std::make_shared<NeighbourList>(NeighbourList(sys,msg,rcut,pad,parameter_data));
-              msg->msg(Messenger::INFO,"Created neighbour list with cutoff "+lexical_cast<string>(rcut)+" and padding distance "+lexical_cast<string>(pad)+".");
-              defined["nlist"] = true;
+              if (nlist_data.name == "")
+              {
+                nlist = std::make_shared<NeighbourList>(NeighbourList(sys,msg,rcut,pad,parameter_data));
+                msg->msg(Messenger::INFO,"Created neighbour list with cutoff "+lexical_cast<string>(rcut)+" and padding distance "+lexical_cast<string>(pad)+".");
+                defined["nlist"] = true;
+              }
+              else
+              {
+                if (nlists.find(nlist_data.name) != nlists.end())
+                {
+                  msg->msg(Messenger::ERROR,"Neighbour list "+nlist_data.name+" has already been defined.");
+                  throw std::runtime_error("Duplicate neighbour list.");
+                }
+                NeighbourListPtr parent;
+                if (parameter_data.find("parent") != parameter_data.end())
+                {
+                  if (nlists.find(parameter_data["parent"]) == nlists.end())
+                  {
+                    msg->msg(Messenger::ERROR,"Parent neighbour list "+parameter_data["parent"]+" of list "+nlist_data.name+" has not been defined.");
+                    throw std::runtime_error("Unknown parent neighbour list.");
+                  }
+                  parent = nlists[parameter_data["parent"]];
+                }
+                if (parameter_data.find("auto_pad") != parameter_data.end())
+                {
+                  msg->msg(Messenger::WARNING,"Auto-tuning of padding distance is only supported for the global neighbour list. Ignoring it for list "+nlist_data.name+".");
+                  parameter_data.erase("auto_pad");
+                }
+                nlists[nlist_data.name] = std::make_shared<NeighbourList>(NeighbourList(sys,msg,rcut,pad,parameter_data,parent,nlist_data.name));
+                named_nlists.push_back(nlists[nlist_data.name]);
+                msg->msg(Messenger::INFO,"Created neighbour list "+nlist_data.name+" with cutoff "+lexical_cast<string>(rcut)+" and padding distance "+lexical_cast<string>(pad)+".");
+              }
             }
             else
             {
@@ -868,22 +1035,63 @@ int main(int argc, char* argv[])
                 pot->compute(1e-3);  // Some value to make sure phase in is working.
               if (aligner)
                 aligner->compute();
+              // Reset timers used for the breakdown of the run time
+              if (pot)
+                pot->reset_timers();
+              if (aligner)
+                aligner->reset_timer();
+              if (nlist)
+                nlist->reset_build_time();
+              for (vector<NeighbourListPtr>::iterator it_n = named_nlists.begin(); it_n != named_nlists.end(); it_n++)
+                (*it_n)->reset_build_time();
+              // Time spent in each part of the step (builds of neighbour lists are measured separately)
+              double t_constraint = 0.0, t_output = 0.0, t_integrate = 0.0, t_population = 0.0, t_nlist = 0.0;
+              double particle_steps = 0.0;    // Sum of system sizes over all steps (system size changes if there are populations)
+              std::chrono::steady_clock::time_point run_start = std::chrono::steady_clock::now();
               int nlist_builds = 0;     // Count how many neighbour list builds we had during this run
+              unsigned long run_allocs = 0, max_step_allocs = 0;   // Heap allocations (only counted if compiled with ENABLE_ALLOC_COUNT)
+              int alloc_free_steps = 0;
               for (int t = 0; t <= run_data.steps; t++)
               {
+                std::chrono::steady_clock::time_point step_start = std::chrono::steady_clock::now();
+                unsigned long step_allocs = heap_allocations();
                 sys->set_step(time_step);
                 sys->set_run_step(t);
+                particle_steps += sys->size();
+                std::chrono::steady_clock::time_point part_start = step_start;
+                double part_builds = nlist_build_time(nlist,named_nlists);
                 if (constraint->rescale())
                 {
-                  nlist->build();
-                  nlist_builds++;
+                  double affine_scale = constraint->get_affine_scale();
+                  if (affine_scale > 0.0)  // Uniform scaling; lists are rebuilt only if scaling used up the skin
+                  {
+                    if (nlist->affine_rescale(affine_scale))
+                      nlist_builds++;
+                    for (vector<NeighbourListPtr>::iterator it_n = named_nlists.begin(); it_n != named_nlists.end(); it_n++)
+                      if ((*it_n)->affine_rescale(affine_scale))
+                        nlist_builds++;
+                  }
+                  else
+                  {
+                    nlist->build();
+                    nlist_builds++;
+                    nlist_builds += update_named_nlists(sys,named_nlists,true);
+                  }
                 }
+                // List builds triggered by rescaling are accounted for as neighbour list time
+                t_constraint += seconds_since(part_start) - (nlist_build_time(nlist,named_nlists) - part_builds);
+                part_start = std::chrono::steady_clock::now();
                 for (vector<DumpPtr>::iterator it_d = dump.begin(); it_d != dump.end(); it_d++)
                   (*it_d)->dump(time_step);
 		for (vector<LoggerPtr>::iterator it_l = log.begin(); it_l != log.end(); it_l++)
                   (*it_l)->log();
+                t_output += seconds_since(part_start);
+                part_start = std::chrono::steady_clock::now();
                 for (std::map<std::string, IntegratorPtr>::iterator it_integ = integrator.begin(); it_integ != integrator.end(); it_integ++)
                   (*it_integ).second->integrate();
+                t_integrate += seconds_since(part_start);
+                part_start = std::chrono::steady_clock::now();
+                part_builds = nlist_build_time(nlist,named_nlists);
                 if (has_population)
                 {
                   for (map<string,PopulationPtr>::iterator it_pop = population.begin(); it_pop != population.end(); it_pop++)
@@ -893,6 +1101,7 @@ int main(int argc, char* argv[])
                     {
                       nlist->build();
                       nlist_builds++;
+                      nlist_builds += update_named_nlists(sys,named_nlists,true);
                       sys->set_force_nlist_rebuild(false);
                     }
                     (*it_pop).second->remove(time_step);
@@ -900,6 +1109,7 @@ int main(int argc, char* argv[])
                     {
                       nlist->build();
                       nlist_builds++;
+                      nlist_builds += update_named_nlists(sys,named_nlists,true);
                       sys->set_force_nlist_rebuild(false);
                     }
                     (*it_pop).second->grow(time_step);
@@ -910,6 +1120,7 @@ int main(int argc, char* argv[])
                       else
                         nlist->build();
                       nlist_builds++;
+                      nlist_builds += update_named_nlists(sys,named_nlists,true,sys->get_nlist_rescale());
                       sys->set_force_nlist_rebuild(false);
                       sys->set_nlist_rescale(1.0);
                     }
@@ -921,18 +1132,24 @@ int main(int argc, char* argv[])
                       else
                         nlist->build();
                       nlist_builds++;
+                      nlist_builds += update_named_nlists(sys,named_nlists,true,sys->get_nlist_rescale());
                       sys->set_force_nlist_rebuild(false);
                       sys->set_nlist_rescale(1.0);
                     }
                   }
                 }
+                t_population += seconds_since(part_start) - (nlist_build_time(nlist,named_nlists) - part_builds);
+                part_start = std::chrono::steady_clock::now();
+                part_builds = nlist_build_time(nlist,named_nlists);
                 // Check the neighbour list rebuild only if necessary 
                 if ((pot && pot->need_nlist()) || (aligner && aligner->need_nlist()))
                 {
                   bool nlist_rebuild = false;
+                  bool force_rebuild = false;
                   if (sys->get_force_nlist_rebuild())
                   {
                     nlist_rebuild = true;
+                    force_rebuild = true;
                     sys->set_force_nlist_rebuild(false);
                   }
                   else
@@ -949,12 +1166,26 @@ int main(int argc, char* argv[])
                     nlist->build();
                     nlist_builds++;
                   }
+                  nlist_builds += update_named_nlists(sys,named_nlists,force_rebuild);
                 }
+                t_nlist += seconds_since(part_start) - (nlist_build_time(nlist,named_nlists) - part_builds);
+                if (nlist)   // Used for neighbour list auto-tuning
+                  nlist->tune(std::chrono::duration<double>(std::chrono::steady_clock::now() - step_start).count());
+                step_allocs = heap_allocations() - step_allocs;
+                run_allocs += step_allocs;
+                max_step_allocs = std::max(max_step_allocs, step_allocs);
+                if (step_allocs == 0) alloc_free_steps++;
                 if (t % PRINT_EVERY == 0)
                   std::cout << "Time step: " << t <<"/" << run_data.steps << "   cumulative time step : " << time_step<< std::endl;
                 time_step++;
               }
               msg->msg(Messenger::INFO,"Built neighbour list "+lexical_cast<string>(nlist_builds)+" time. Average number of steps between two builds : "+lexical_cast<string>(static_cast<double>(run_data.steps)/nlist_builds)+".");
+              report_run_timing(msg, seconds_since(run_start), particle_steps, run_data.steps+1, nlist_builds,
+                                t_nlist + nlist_build_time(nlist,named_nlists), 
+                                pot ? pot->get_nonbonded_time() : 0.0, pot ? pot->get_bonded_time() : 0.0, aligner ? aligner->get_compute_time() : 0.0,
+                                t_integrate, t_constraint, t_population, t_output);
+              if (alloc_count_enabled())
+                msg->msg(Messenger::INFO,"Heap allocations during the run : "+lexical_cast<string>(run_allocs)+" ("+lexical_cast<string>(static_cast<double>(run_allocs)/(run_data.steps+1))+" per step, at most "+lexical_cast<string>(max_step_allocs)+" in a single step). "+lexical_cast<string>(alloc_free_steps)+" out of "+lexical_cast<string>(run_data.steps+1)+" steps did not allocate any memory.");
             }
             else
             {
@@ -987,7 +1218,8 @@ int main(int argc, char* argv[])
                   nlist = std::make_shared<NeighbourList>(NeighbourList(sys,msg,DEFAULT_CUTOFF,DEFAULT_PADDING, parameter_data));
                   defined["nlist"] = true;
                 }
-                aligner->add_pair_align(pair_align_data.type, pair_aligners[pair_align_data.type](sys,msg,nlist,parameter_data));
+                NeighbourListPtr align_nlist = select_nlist(msg,nlist,nlists,parameter_data,current_line);
+                aligner->add_pair_align(pair_align_data.type, pair_aligners[pair_align_data.type](sys,msg,align_nlist,parameter_data));
                 msg->msg(Messenger::INFO,"Added "+pair_align_data.type+" to the list of pairwise aligners.");
               }
               else
@@ -49,6 +49,7 @@
 #include "parse_align.hpp"
 #include "parse_external_align.hpp"
 #include "parse_group.hpp"
+#include "parse_nlist.hpp"
 #include "parse_disable.hpp"
 #include "parse_population.hpp"
 #include "parse_bond.hpp"
@@ -71,6 +72,8 @@
 #include "constraint_tetrahedron.hpp"
 #include "constraint_slab.hpp"
 #include "rng.hpp"
+#include "alloc_counter.hpp"
+#include "resource_usage.hpp"
 #include "particle.hpp"
 #include "vector3d.hpp"
 #include "box.hpp"
@@ -84,6 +87,9 @@
 #include "my_pair_vertex_particle_potential.hpp"
 #include "pair_potential.hpp"
 #include "pair_coulomb_potential.hpp"
+#include "pair_ewald_potential.hpp"
+#include "pair_tree_potential.hpp"
+#include "pair_table_potential.hpp"
 #include "pair_soft_potential.hpp"
 #include "pair_lj_potential.hpp"
 #include "pair_gaussian_potential.hpp"
@@ -106,12 +112,15 @@
 #include "integrator_brownian_rod.hpp"
 #include "integrator_vicsek.hpp"
 #include "integrator_nve.hpp"
+#include "integrator_respa.hpp"
 #include "integrator_nematic.hpp"
 #include "integrator_actomyo.hpp"
 #include "integrator_brownian_pos.hpp"
 #include "integrator_brownian_align.hpp"
 #include "integrator_langevin.hpp"
 #include "integrator_fire.hpp"
+#include "integrator_cg.hpp"
+#include "integrator_lbfgs.hpp"
 #include "integrator_sepulveda.hpp"
 #include "aligner.hpp"
 #include "pair_aligner.hpp"
@@ -53,14 +53,14 @@ struct Box
 	\param ZLO z-coordinate of the low corner
 	\param ZHI z-coordinate of the high corner	
   */
-  Box(double lx, double ly, double lz) : Lx(lx), Ly(ly), Lz(lz)
+  Box(double lx, double ly, double lz) : Lx(lx), Ly(ly), Lz(lz), planar(false)
   {
     assert(Lx >= 0.0 && Ly >= 0.0 && Lz >= 0.0);
     xlo = -0.5*Lx;  xhi = 0.5*Lx;
     ylo = -0.5*Ly;  yhi = 0.5*Ly;
     zlo = -0.5*Lz;  zhi = 0.5*Lz;
   }
-  Box(double XLO, double XHI, double YLO, double YHI, double ZLO, double ZHI) : xlo(XLO), xhi(XHI), ylo(YLO), yhi(YHI), zlo(ZLO), zhi(ZHI) 
+  Box(double XLO, double XHI, double YLO, double YHI, double ZLO, double ZHI) : xlo(XLO), xhi(XHI), ylo(YLO), yhi(YHI), zlo(ZLO), zhi(ZHI), planar(false) 
   {
     assert(XHI > XLO && YHI > YLO && ZHI > ZLO);
     Lx = xhi - xlo;
@@ -85,6 +85,7 @@ struct Box
   double Lx;          //!< box length in x direction
   double Ly;          //!< box length in y direction
   double Lz;          //!< box length in z direction
+  bool planar;        //!< If true, system is two dimensional (all particles in the xy plane); z direction is ignored by cell lists and integrators
 };
 
 typedef shared_ptr<Box> BoxPtr;
@@ -34,15 +34,37 @@
 //! \param sys Pointer to the system object
 //! \param msg Pointer to the messenger object
 //! \param cutoff cell size (currently all cells are cubic)
-CellList::CellList(SystemPtr sys, MessengerPtr msg, double cutoff) : m_system(sys), m_msg(msg)
+CellList::CellList(SystemPtr sys, MessengerPtr msg, double cutoff) : m_system(sys), m_msg(msg), m_nx(0), m_ny(0), m_nz(0)
 {
-  m_nx = static_cast<int>(sys->get_box()->Lx/cutoff);
-  m_ny = static_cast<int>(sys->get_box()->Ly/cutoff);
-  m_nz = static_cast<int>(sys->get_box()->Lz/cutoff);
+  this->resize(cutoff);
+  m_msg->msg(Messenger::INFO,"Created cell list with "+lexical_cast<string>(m_size)+" cells.");
+  m_msg->msg(Messenger::INFO,"Each cell has dimensions ("+lexical_cast<string>(m_wx)+","+lexical_cast<string>(m_wy)+","+lexical_cast<string>(m_wz)+").");
+  if (m_planar)
+    m_msg->msg(Messenger::INFO,"Cell list is planar. Using 9 cell stencil.");
+}
+
+/*! Adjust cell list to a new cell size and/or box size. If number of cells in 
+ *  each direction is unchanged only cell widths are updated. Otherwise, cells are
+ *  set up again, reusing existing storage.
+ *  \param cutoff new cell size 
+*/
+void CellList::resize(double cutoff)
+{
+  BoxPtr box = m_system->get_box();
+  m_planar = box->planar;
+  int nx = std::max(1,static_cast<int>(box->Lx/cutoff));
+  int ny = std::max(1,static_cast<int>(box->Ly/cutoff));
+  int nz = m_planar ? 1 : std::max(1,static_cast<int>(box->Lz/cutoff));   // In planar systems there is a single layer of cells and the stencil has 9 cells
+  bool same = (nx == m_nx && ny == m_ny && nz == m_nz);
+  m_nx = nx;  m_ny = ny;  m_nz = nz;
   m_size = m_nx*m_ny*m_nz;
-  m_wx = sys->get_box()->Lx/m_nx;
-  m_wy = sys->get_box()->Ly/m_ny;
-  m_wz = sys->get_box()->Lz/m_nz;
+  m_wx = box->Lx/m_nx;
+  m_wy = box->Ly/m_ny;
+  m_wz = box->Lz/m_nz;
+  if (same)
+    return;
+  m_cells.clear();
+  int zrange = m_planar ? 0 : 1;
   for (int i = 0; i < m_nx; i++)
     for (int j = 0; j < m_ny; j++)
       for (int k = 0; k < m_nz; k++)
@@ -51,7 +73,7 @@ CellList::CellList(SystemPtr sys, MessengerPtr msg, double cutoff) : m_system(sy
         m_cells.push_back(Cell(idx));
         for (int ix = -1; ix <= 1; ix++)
           for (int iy = -1; iy <= 1; iy++)
-            for (int iz = -1; iz <= 1; iz++)
+            for (int iz = -zrange; iz <= zrange; iz++)
             {
               int iix = i + ix, iiy = j + iy, iiz = k + iz;
               if (iix < 0) iix = m_nx - 1;
@@ -60,11 +82,13 @@ CellList::CellList(SystemPtr sys, MessengerPtr msg, double cutoff) : m_system(sy
               else if (iiy == m_ny) iiy = 0;
               if (iiz < 0) iiz = m_nz - 1;
               else if (iiz == m_nz) iiz = 0;
-              m_cells[idx].add_neighbour(m_ny*m_nz*iix + m_nz*iiy + iiz);
+              int n_idx = m_ny*m_nz*iix + m_nz*iiy + iiz;
+              // With only two cells in some direction both sides wrap onto the same cell, which must not be visited twice
+              vector<int>& neigh = m_cells[idx].get_neighbours();
+              if (find(neigh.begin(),neigh.end(),n_idx) == neigh.end())
+                m_cells[idx].add_neighbour(n_idx);
             }
       } 
-  m_msg->msg(Messenger::INFO,"Created cell list with "+lexical_cast<string>(m_size)+" cells.");
-  m_msg->msg(Messenger::INFO,"Each cell has dimensions ("+lexical_cast<string>(m_wx)+","+lexical_cast<string>(m_wy)+","+lexical_cast<string>(m_wz)+").");
 }
 
 //! Get cell to which given particle belongs
@@ -74,31 +98,124 @@ int CellList::get_cell_idx(const Particle& p)
   BoxPtr box = m_system->get_box();
   int i = static_cast<int>((p.x-box->xlo)/m_wx);
   int j = static_cast<int>((p.y-box->ylo)/m_wy);
-  int k = static_cast<int>((p.z-box->zlo)/m_wz); 
+  int k = m_planar ? 0 : static_cast<int>((p.z-box->zlo)/m_wz); 
   return m_ny*m_nz*i + m_nz*j + k;
 }
 
 //! Populate cell list
 void CellList::populate()
 {
-  BoxPtr box = m_system->get_box();
-  double lx = box->Lx, ly = box->Ly, lz = box->Lz;
   bool periodic = m_system->get_periodic();
   for (int i = 0; i < m_size; i++)
     m_cells[i].wipe();
   for (int i = 0; i < m_system->size(); i++)
+    this->wrap_and_add(m_system->get_particle(i), periodic);
+  //m_msg->msg(Messenger::INFO,"Populated cell list.");
+}
+
+//! Populate cell list with a subset of particles
+//! \param particles ids of particles to add
+void CellList::populate(const vector<int>& particles)
+{
+  bool periodic = m_system->get_periodic();
+  for (int i = 0; i < m_size; i++)
+    m_cells[i].wipe();
+  for (unsigned int i = 0; i < particles.size(); i++)
+    this->wrap_and_add(m_system->get_particle(particles[i]), periodic);
+}
+
+/*! Collect all cells that can contain particles closer than a given distance 
+ *  to a given particle. Unlike the cell stencil, distance can be larger than the cell width.
+ *  \param p Reference to the particle object
+ *  \param dist distance 
+ *  \param cells on return contains indices of all cells (each listed once)
+*/
+void CellList::get_cells_within(const Particle& p, double dist, vector<int>& cells)
+{
+  BoxPtr box = m_system->get_box();
+  int n[3] = {static_cast<int>(m_nx), static_cast<int>(m_ny), static_cast<int>(m_nz)};
+  double w[3] = {m_wx, m_wy, m_wz};
+  double f[3] = {p.x - box->xlo, p.y - box->ylo, p.z - box->zlo};
+  int lo[3], hi[3];
+  for (int a = 0; a < 3; a++)
   {
-    Particle& p = m_system->get_particle(i);
-    if (periodic)
+    if (a == 2 && m_planar)
+    {
+      lo[a] = hi[a] = 0;
+      continue;
+    }
+    lo[a] = static_cast<int>(std::floor((f[a] - dist)/w[a]));
+    hi[a] = static_cast<int>(std::floor((f[a] + dist)/w[a]));
+    // Range covers the whole box in this direction, so each cell is visited once
+    if (hi[a] - lo[a] + 1 >= n[a])
     {
-      if (p.x < box->xlo) p.x += lx;
-      else if (p.x > box->xhi) p.x -= lx;
-      if (p.y < box->ylo) p.y += ly;
-      else if (p.y > box->yhi) p.y -= ly;
-      if (p.z < box->zlo) p.z += lz;
-      else if (p.z > box->zhi) p.z -= lz;
+      lo[a] = 0;
+      hi[a] = n[a] - 1;
     }
-    this->add_particle(p);
   }
-  //m_msg->msg(Messenger::INFO,"Populated cell list.");
+  cells.clear();
+  for (int i = lo[0]; i <= hi[0]; i++)
+  {
+    int ii = ((i % n[0]) + n[0]) % n[0];
+    for (int j = lo[1]; j <= hi[1]; j++)
+    {
+      int jj = ((j % n[1]) + n[1]) % n[1];
+      for (int k = lo[2]; k <= hi[2]; k++)
+      {
+        int kk = ((k % n[2]) + n[2]) % n[2];
+        cells.push_back(m_ny*m_nz*ii + m_nz*jj + kk);
+      }
+    }
+  }
+}
+
+//! Wrap particle back into the box (for periodic systems) and add it to the appropriate cell 
+//! \param p Reference to the particle object
+//! \param periodic if true, system is periodic
+void CellList::wrap_and_add(Particle& p, bool periodic)
+{
+  BoxPtr box = m_system->get_box();
+  if (periodic)
+  {
+    if (p.x < box->xlo) p.x += box->Lx;
+    else if (p.x > box->xhi) p.x -= box->Lx;
+    if (p.y < box->ylo) p.y += box->Ly;
+    else if (p.y > box->yhi) p.y -= box->Ly;
+    if (!m_planar)
+    {
+      if (p.z < box->zlo) p.z += box->Lz;
+      else if (p.z > box->zhi) p.z -= box->Lz;
+    }
+  }
+  this->add_particle(p);
+}
+
+/*! Compute the squared distance between a particle and the closest point of one 
+ *  of the cells in the stencil of the particle's cell. Used to skip cells that are 
+ *  too far for interactions with a short cutoff.
+ *  \param p Reference to the particle object
+ *  \param cell_idx index of the cell the particle belongs to
+ *  \param neigh_idx index of the neighbouring cell
+ *  \note If there are fewer than three cells in some direction the neighbouring cell 
+ *  touches both sides of the particle's cell and the distance along that direction is zero.
+*/
+double CellList::min_distance_sq(const Particle& p, int cell_idx, int neigh_idx)
+{
+  BoxPtr box = m_system->get_box();
+  int nx = static_cast<int>(m_nx), ny = static_cast<int>(m_ny), nz = static_cast<int>(m_nz);
+  int ci[3] = {cell_idx/(ny*nz), (cell_idx/nz) % ny, cell_idx % nz};
+  int ni[3] = {neigh_idx/(ny*nz), (neigh_idx/nz) % ny, neigh_idx % nz};
+  int n[3] = {nx, ny, nz};
+  double w[3] = {m_wx, m_wy, m_wz};
+  double f[3] = {p.x - box->xlo - ci[0]*m_wx, p.y - box->ylo - ci[1]*m_wy, p.z - box->zlo - ci[2]*m_wz};   // position within the cell
+  double d_sq = 0.0;
+  for (int a = 0; a < 3; a++)
+  {
+    int d = ni[a] - ci[a];
+    if (d == 0 || n[a] < 3) continue;
+    double fa = std::min(std::max(f[a], 0.0), w[a]);
+    double dist = (d == 1 || d == 1 - n[a]) ? w[a] - fa : fa;
+    d_sq += dist*dist;
+  }
+  return d_sq;
 }
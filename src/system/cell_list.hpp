@@ -32,6 +32,8 @@
 
 #include <vector>
 #include <stdexcept>
+#include <algorithm>
+#include <cmath>
 
 #include "messenger.hpp"
 #include "system.hpp"
@@ -41,6 +43,7 @@ using std::vector;
 
 /*! Handles cell list in the system. For simplicity all cell have 
  *  same dimensions (lx,ly,lz) and are given in 3 dimensions.
+ *  For planar boxes there is only one layer of cells in the z direction.
 */
 class CellList
 {
@@ -49,6 +52,9 @@ public:
   //! Construct cell list
   CellList(SystemPtr, MessengerPtr, double); 
   
+  //! Adjust cell list to a new cell size or box size
+  void resize(double);
+  
   //! Get cell to which given particle belongs
   int get_cell_idx(const Particle&);
   
@@ -69,6 +75,15 @@ public:
   //! Populates cell list
   void populate();
   
+  //! Populates cell list with a subset of particles
+  void populate(const vector<int>&);
+  
+  //! Get all cells that may contain particles within a given distance from a particle
+  void get_cells_within(const Particle&, double, vector<int>&);
+  
+  //! Squared distance between a particle and a neighbouring cell
+  double min_distance_sq(const Particle&, int, int);
+  
 private:
   
   SystemPtr m_system;              //!< Pointer to the System object
@@ -77,6 +92,10 @@ private:
   int m_size;                      //!< Cell list size (number of cells)
   double m_nx, m_ny, m_nz;         //!< Number of cell is x, y, z direction
   double m_wx, m_wy, m_wz;         //!< Cell width in the x, y, and z direction
+  bool m_planar;                   //!< If true, system is planar and cells span the entire box in the z direction
+  
+  //! Wrap particle back into the box and add it to the appropriate cell
+  void wrap_and_add(Particle&, bool);
   
 };
 
@@ -0,0 +1,213 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file edge_map.hpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Declaration of EdgeMap class.
+ */ 
+
+#ifndef __EDGE_MAP_HPP__
+#define __EDGE_MAP_HPP__
+
+#include <vector>
+#include <cstdint>
+
+using std::vector;
+
+const uint64_t EDGE_MAP_EMPTY = ~static_cast<uint64_t>(0);         // marks a free slot in the edge map
+const uint64_t EDGE_MAP_DELETED = ~static_cast<uint64_t>(0) - 1;   // marks a removed entry in the edge map
+
+/*! EdgeMap relates ordered pairs of vertex indices (i,j) to the index
+ *  of the half-edge pointing from i to j. 
+ *
+ *  It is a flat open-addressing hash table with linear probing. Compared to 
+ *  a map<pair<int,int>,int> there is no allocation per edge and lookups touch 
+ *  one or two cache lines. Clearing keeps the allocated storage, so rebuilding the 
+ *  mesh does not allocate once the table has grown to its working size.
+ *  Removed entries are marked as deleted (tombstones) and are purged on the next
+ *  rehash.
+*/
+class EdgeMap
+{
+public:
+  
+  //! Construct an empty map
+  EdgeMap() : m_size(0), m_used(0) {   }
+  
+  //! Remove all entries (keeps allocated storage)
+  void clear()
+  {
+    m_keys.assign(m_keys.size(), EDGE_MAP_EMPTY);
+    m_size = 0;
+    m_used = 0;
+  }
+  
+  //! Make sure that at least n entries can be stored without rehashing
+  //! \param n number of entries
+  void reserve(int n)
+  {
+    unsigned int cap = 16;
+    while (cap < 2*static_cast<unsigned int>(n)) cap <<= 1;
+    if (cap > m_keys.size())
+      this->rehash(cap);
+  }
+  
+  //! Set index of the edge pointing from vertex i to vertex j
+  //! \param i index of the 1st vertex
+  //! \param j index of the 2nd vertex
+  //! \param e edge index
+  void insert(int i, int j, int e)
+  {
+    if (2*(m_used + 1) > m_keys.size())
+    {
+      // Grow if more than a quarter of slots hold edges, otherwise only purge tombstones
+      unsigned int cap = m_keys.size();
+      if (cap == 0) cap = 16;
+      else if (4*(m_size + 1) > cap) cap *= 2;
+      this->rehash(cap);
+    }
+    uint64_t key = make_key(i,j);
+    unsigned int mask = m_keys.size() - 1;
+    unsigned int slot = hash(key) & mask;
+    int tomb = -1;
+    while (m_keys[slot] != EDGE_MAP_EMPTY)
+    {
+      if (m_keys[slot] == key)
+      {
+        m_values[slot] = e;
+        return;
+      }
+      if (m_keys[slot] == EDGE_MAP_DELETED && tomb < 0)
+        tomb = slot;
+      slot = (slot + 1) & mask;
+    }
+    if (tomb >= 0)
+      slot = tomb;
+    else
+      m_used++;
+    m_keys[slot] = key;
+    m_values[slot] = e;
+    m_size++;
+  }
+  
+  //! Get index of the edge pointing from vertex i to vertex j
+  //! \param i index of the 1st vertex
+  //! \param j index of the 2nd vertex
+  //! \return edge index or -1 if there is no such edge
+  int find(int i, int j) const
+  {
+    if (m_size == 0)
+      return -1;
+    uint64_t key = make_key(i,j);
+    unsigned int mask = m_keys.size() - 1;
+    unsigned int slot = hash(key) & mask;
+    while (m_keys[slot] != EDGE_MAP_EMPTY)
+    {
+      if (m_keys[slot] == key)
+        return m_values[slot];
+      slot = (slot + 1) & mask;
+    }
+    return -1;
+  }
+  
+  //! Remove edge pointing from vertex i to vertex j (if present)
+  //! \param i index of the 1st vertex
+  //! \param j index of the 2nd vertex
+  void erase(int i, int j)
+  {
+    if (m_size == 0)
+      return;
+    uint64_t key = make_key(i,j);
+    unsigned int mask = m_keys.size() - 1;
+    unsigned int slot = hash(key) & mask;
+    while (m_keys[slot] != EDGE_MAP_EMPTY)
+    {
+      if (m_keys[slot] == key)
+      {
+        m_keys[slot] = EDGE_MAP_DELETED;
+        m_size--;
+        return;
+      }
+      slot = (slot + 1) & mask;
+    }
+  }
+  
+  //! Relabel edges after edge e has been removed from the edge list,
+  //! i.e. decrease all edge indices larger than e by one
+  //! \param e index of the removed edge
+  void remove_label(int e)
+  {
+    for (unsigned int s = 0; s < m_keys.size(); s++)
+      if (m_keys[s] < EDGE_MAP_DELETED && m_values[s] > e)
+        m_values[s]--;
+  }
+  
+  //! Number of stored edges
+  int size() const { return m_size; }
+  
+private:
+  
+  vector<uint64_t> m_keys;     //!< Packed vertex pairs (capacity is always a power of 2)
+  vector<int> m_values;        //!< Edge indices
+  unsigned int m_size;         //!< Number of stored edges
+  unsigned int m_used;         //!< Number of slots that are not empty (stored edges and tombstones)
+  
+  //! Pack a pair of (non-negative) vertex indices into a single key
+  static uint64_t make_key(int i, int j)
+  {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(i)) << 32) | static_cast<uint32_t>(j);
+  }
+  
+  //! Fibonacci hashing of the key 
+  static unsigned int hash(uint64_t key)
+  {
+    return static_cast<unsigned int>((key * 0x9E3779B97F4A7C15ULL) >> 32);
+  }
+  
+  //! Move all entries to a table of given capacity, dropping tombstones
+  //! \param cap new capacity (power of 2)
+  void rehash(unsigned int cap)
+  {
+    vector<uint64_t> keys(cap, EDGE_MAP_EMPTY);
+    vector<int> values(cap, -1);
+    unsigned int mask = cap - 1;
+    for (unsigned int s = 0; s < m_keys.size(); s++)
+    {
+      if (m_keys[s] < EDGE_MAP_DELETED)
+      {
+        unsigned int slot = hash(m_keys[s]) & mask;
+        while (keys[slot] != EDGE_MAP_EMPTY)
+          slot = (slot + 1) & mask;
+        keys[slot] = m_keys[s];
+        values[slot] = m_values[s];
+      }
+    }
+    m_keys.swap(keys);
+    m_values.swap(values);
+    m_used = m_size;
+  }
+  
+};
+
+#endif
@@ -113,6 +113,18 @@ public:
         m_particles[i]--;
   }
   
+  //! Relabel particles after a bulk removal 
+  //! \param new_id maps old particle ids to new ones (-1 for removed particles)
+  void remap(const vector<int>& new_id)
+  {
+    unsigned int n = 0;
+    for (unsigned int i = 0; i < m_particles.size(); i++)
+      if (new_id[m_particles[i]] >= 0)
+        m_particles[n++] = new_id[m_particles[i]];
+    m_particles.resize(n);
+    m_size = n;
+  }
+  
   //! Get particles in the group
   vector<int>& get_particles() { return m_particles; } //!< \return reference to the vector containing indices of all particles in this group
     
@@ -52,7 +52,7 @@ void Mesh::reset()
   m_edges.clear();              
   m_faces.clear();              
   m_edge_map.clear();  
-  m_edge_face.clear();
+  this->mark_all_dirty();
 }
 
 /*! Add and edge to the list of edges. Edge is defined
@@ -67,7 +67,7 @@ void Mesh::add_edge(int vi, int vj)
   m_edges.push_back(Edge(m_nedge,vi,vj));
   m_vertices[vi].add_edge(m_nedge);
   m_vertices[vi].add_neighbour(vj);
-  m_edge_map[make_pair(vi,vj)] = m_nedge;
+  m_edge_map.insert(vi,vj,m_nedge);
   m_nedge++;
 }
 
@@ -136,6 +136,9 @@ void Mesh::generate_faces()
 /*! Genererate position of the dual vertices */
 void Mesh::generate_dual_mesh()
 {
+#ifdef _OPENMP
+  #pragma omp parallel for
+#endif
   for (int f = 0; f < m_nface; f++)
   {
     Face& face = m_faces[f];
@@ -147,21 +150,168 @@ void Mesh::generate_dual_mesh()
   }    
 }
 
-/*! Update position of the dual vertices as well as the cell centre Jacobian */
+/*! Update position of the dual vertices as well as the cell centre Jacobian.
+ *  Only faces marked as dirty (i.e., those with a vertex that moved or that were changed 
+ *  by an edge flip) are updated. If the whole mesh is dirty, faces are updated in parallel 
+ *  (if compiled with OpenMP support).
+*/
 void Mesh::update_dual_mesh()
 {
-  for (int f = 0; f < m_nface; f++)
+  if (m_all_faces_dirty)
   {
-    Face& face = m_faces[f];
-    if (!face.is_hole)
+#ifdef _OPENMP
+    #pragma omp parallel for
+#endif
+    for (int f = 0; f < m_nface; f++)
+    {
+      Face& face = m_faces[f];
+      if (!face.is_hole)
+      {
+        this->compute_angles(f);
+        this->compute_centre(f);     
+      }
+      this->fc_jacobian(f);
+    }
+    m_all_faces_dirty = false;
+  }
+  else
+  {
+    int n_dirty = m_dirty_faces.size();
+#ifdef _OPENMP
+    #pragma omp parallel for if (n_dirty > 1000)
+#endif
+    for (int i = 0; i < n_dirty; i++)
     {
+      int f = m_dirty_faces[i];
       this->compute_angles(f);
-      this->compute_centre(f);     
+      this->compute_centre(f);
+      this->fc_jacobian(f);
     }
-    this->fc_jacobian(f);
-  }   
+    for (int i = 0; i < n_dirty; i++)
+      m_face_dirty[m_dirty_faces[i]] = false;
+  }
+  m_dirty_faces.clear();
 }
 
+/*! Reorder duals and update dual areas and perimeters for all vertices 
+ *  that belong to faces that changed since the last call.
+*/
+void Mesh::update_dual_cells()
+{
+  if (m_all_vertices_dirty)
+  {
+    for (int v = 0; v < m_size; v++)
+    {
+      this->order_dual(v);
+      this->dual_perimeter(v);
+      this->dual_area(v);
+    }
+    m_all_vertices_dirty = false;
+  }
+  else
+  {
+    for (unsigned int i = 0; i < m_dirty_vertices.size(); i++)
+    {
+      int v = m_dirty_vertices[i];
+      this->order_dual(v);
+      this->dual_perimeter(v);
+      this->dual_area(v);
+      m_vertex_dirty[v] = false;
+    }
+  }
+  m_dirty_vertices.clear();
+  m_dual_generation++;
+}
+
+/*! Mark face as dirty. Its angles, centre and Jacobian will be recomputed
+ *  in the next dual mesh update and the duals of all its vertices will be 
+ *  reordered. Holes are never marked as they have no centre.
+ *  \param f face index
+*/
+void Mesh::mark_face_dirty(int f)
+{
+  Face& face = m_faces[f];
+  if (face.is_hole)
+    return;
+  if (!m_all_faces_dirty)
+  {
+    if (static_cast<int>(m_face_dirty.size()) < m_nface)
+      m_face_dirty.resize(m_nface, false);
+    if (!m_face_dirty[f])
+    {
+      m_face_dirty[f] = true;
+      m_dirty_faces.push_back(f);
+    }
+  }
+  if (!m_all_boundary_dirty)
+  {
+    if (static_cast<int>(m_boundary_face_dirty.size()) < m_nface)
+      m_boundary_face_dirty.resize(m_nface, false);
+    if (!m_boundary_face_dirty[f])
+    {
+      for (int i = 0; i < face.n_sides; i++)
+        if (m_vertices[face.vertices[i]].boundary)
+        {
+          m_boundary_face_dirty[f] = true;
+          m_dirty_boundary_faces.push_back(f);
+          break;
+        }
+    }
+  }
+  if (!m_all_vertices_dirty)
+  {
+    if (static_cast<int>(m_vertex_dirty.size()) < m_size)
+      m_vertex_dirty.resize(m_size, false);
+    for (int i = 0; i < face.n_sides; i++)
+    {
+      int v = face.vertices[i];
+      if (!m_vertex_dirty[v])
+      {
+        m_vertex_dirty[v] = true;
+        m_dirty_vertices.push_back(v);
+      }
+    }
+  }
+}
+
+/*! Mark all faces and vertices as dirty. Used when the mesh has been rebuilt or 
+ *  edges and faces have been relabelled, so that lists of dirty items are no longer valid. 
+*/
+void Mesh::mark_all_dirty()
+{
+  m_check_all = true;
+  m_all_faces_dirty = true;
+  m_all_vertices_dirty = true;
+  m_dirty_faces.clear();
+  m_dirty_vertices.clear();
+  m_face_dirty.assign(m_face_dirty.size(), false);
+  m_vertex_dirty.assign(m_vertex_dirty.size(), false);
+  m_all_boundary_dirty = true;
+  m_boundary_vertices_dirty = true;
+  m_boundary_geometry.valid = false;
+  m_dual_generation++;
+  m_dirty_boundary_faces.clear();
+  m_boundary_face_dirty.assign(m_boundary_face_dirty.size(), false);
+}
+
+
+/*! Boundary vertices only change when the mesh is rebuilt or 
+ *  boundary edges are removed, so the list is rebuilt lazily. 
+ *  Potentials that act only on the boundary loop over this list 
+ *  instead of over the entire mesh.
+*/
+vector<int>& Mesh::get_boundary_vertices()
+{
+  if (m_boundary_vertices_dirty)
+  {
+    m_boundary_vertices.clear();
+    for (int v = 0; v < m_size; v++)
+      if (m_vertices[v].boundary)
+        m_boundary_vertices.push_back(v);
+    m_boundary_vertices_dirty = false;
+  }
+  return m_boundary_vertices;
+}
 
 /*! Once the mesh is read in, we need to set things like
  *  boundary flags.
@@ -196,7 +346,9 @@ void Mesh::postprocess(bool flag)
   for (int e = 0; e < m_nedge; e++)
   {
     Edge& E = m_edges[e];
-    Edge& Epair = m_edges[m_edge_map[make_pair(E.to,E.from)]];
+    int pe = m_edge_map.find(E.to,E.from);
+    assert(pe >= 0);
+    Edge& Epair = m_edges[pe];
     E.pair = Epair.id;
     Epair.pair = E.id;
   }
@@ -205,6 +357,7 @@ void Mesh::postprocess(bool flag)
     for (int v = 0; v < m_size; v++)
       this->order_star(v);
   }
+  this->mark_all_dirty();
 }
 
 /*! Computes centre of a face. If the face is not triangle, compute geometric centre.
@@ -564,17 +717,19 @@ int Mesh::opposite_vertex(int e)
  *  Namely we flip an edge (pair of half-edges) shred by two trangles. Needless to say,
  *  this move is only defined for triangulations.
  *  \param e id of the half-edge to flip (its pair is also flipped)
+ *  \param faces ids of the two faces changed by the flip are appended to this vector
+ *  \return true if the edge has been flipped
 */
-void Mesh::edge_flip(int e)
+bool Mesh::edge_flip(int e, vector<int>& faces)
 {
   if (!m_is_triangulation)
-    return;  // Edge flip is only defined for triangulations
+    return false;  // Edge flip is only defined for triangulations
   
   Edge& E = m_edges[e];
   Edge& Ep = m_edges[E.pair];
     
   if (E.boundary || Ep.boundary)
-    return;   // We cannot flip a boundary edge.
+    return false;   // We cannot flip a boundary edge.
   
   Face& F  = m_faces[E.face];
   Face& Fp = m_faces[Ep.face];
@@ -655,16 +810,11 @@ void Mesh::edge_flip(int e)
   V4.add_face(F.id);
   
   // Finally, we need to update edge_map
-  map<pair<int,int>, int>::iterator it = m_edge_map.find(make_pair(V1.id,V2.id));
-  if (it != m_edge_map.end())
-     m_edge_map.erase(it);
-     
-  it = m_edge_map.find(make_pair(V2.id,V1.id));
-  if (it != m_edge_map.end())
-     m_edge_map.erase(it);
+  m_edge_map.erase(V1.id,V2.id);
+  m_edge_map.erase(V2.id,V1.id);
   
-  m_edge_map[make_pair(V3.id,V4.id)]  = Ep.id;
-  m_edge_map[make_pair(V4.id,V3.id)]  = E.id;
+  m_edge_map.insert(V3.id,V4.id,Ep.id);
+  m_edge_map.insert(V4.id,V3.id,E.id);
   
   // Make sure that the vertex stars are all properly ordered
   
@@ -687,44 +837,206 @@ void Mesh::edge_flip(int e)
 
   if ((V1.n_edges <= 2) || (V2.n_edges <= 2) || (V3.n_edges <= 2) || (V4.n_edges <= 2))
     this->m_has_dangling = true;
-    
+  
+  faces.push_back(F.id);
+  faces.push_back(Fp.id);
+  this->mark_face_dirty(F.id);
+  this->mark_face_dirty(Fp.id);
+  
+  return true;
+}
+
+/*! Find the face in the star of a vertex that contains a given point. 
+ *  Point is tested against the triangle edges projected onto the plane 
+ *  perpendicular to the vertex normal.
+ *  \param v vertex index
+ *  \param r position of the point
+ *  \return index of the face (-1 if point is not inside the vertex star)
+*/
+int Mesh::find_face(int v, const Vector3d& r)
+{
+  Vertex& V = m_vertices[v];
+  for (int f = 0; f < V.n_faces; f++)
+  {
+    Face& face = m_faces[V.faces[f]];
+    if (face.is_hole || face.n_sides != 3)
+      continue;
+    Vector3d& r0 = m_vertices[face.vertices[0]].r;
+    Vector3d& r1 = m_vertices[face.vertices[1]].r;
+    Vector3d& r2 = m_vertices[face.vertices[2]].r;
+    double orient = dot(cross(r1-r0,r2-r0),V.N);
+    if (orient*dot(cross(r1-r0,r-r0),V.N) > 0.0 && 
+        orient*dot(cross(r2-r1,r-r1),V.N) > 0.0 && 
+        orient*dot(cross(r0-r2,r-r2),V.N) > 0.0)
+      return face.id;
+  }
+  return -1;
+}
+
+/*! Check if a vertex can be moved to a new position without inverting any of the 
+ *  triangles in its star. Each triangle has to keep the sign of its orientation 
+ *  with respect to the vertex normal. This is stronger than the new position being 
+ *  inside the star, which also admits points outside of the star's kernel.
+ *  \param v vertex index
+ *  \param r new position of the vertex
+ *  \return true if no triangle in the star changes orientation
+*/
+bool Mesh::keeps_orientation(int v, const Vector3d& r)
+{
+  Vertex& V = m_vertices[v];
+  for (int f = 0; f < V.n_faces; f++)
+  {
+    Face& face = m_faces[V.faces[f]];
+    if (face.is_hole)
+      continue;
+    if (face.n_sides != 3)
+      return false;
+    Vector3d r_old[3], r_new[3];
+    for (int i = 0; i < 3; i++)
+    {
+      r_old[i] = m_vertices[face.vertices[i]].r;
+      r_new[i] = (face.vertices[i] == v) ? r : r_old[i];
+    }
+    double orient_old = dot(cross(r_old[1]-r_old[0],r_old[2]-r_old[0]),V.N);
+    double orient_new = dot(cross(r_new[1]-r_new[0],r_new[2]-r_new[0]),V.N);
+    if (orient_old*orient_new <= 0.0)
+      return false;
+  }
+  return true;
+}
+
+/*! Insert a new vertex into a triangular face. This is used for local remeshing 
+ *  after cell division. The face is split into three triangles that share the new vertex. 
+ *  All three triangles are marked dirty, so the next equiangulation restores the 
+ *  Delaunay property around the new vertex by local edge flips and there is no need to 
+ *  rebuild the entire mesh.
+ *  \param p particle that corresponds to the new vertex (its id has to be equal to the number of vertices)
+ *  \param f index of the face that contains the particle
+ *  \return true if the vertex has been inserted
+*/
+bool Mesh::insert_vertex(Particle& p, int f)
+{
+  if (!m_is_triangulation || p.get_id() != m_size || f < 0 || f >= m_nface)
+    return false;
+  if (m_faces[f].is_hole || m_faces[f].n_sides != 3)
+    return false;
+  
+  int v = m_size;
+  this->add_vertex(p);
+  int vf[3], ef[3];
+  for (int i = 0; i < 3; i++)
+  {
+    vf[i] = m_faces[f].vertices[i];
+    ef[i] = m_faces[f].edges[i];
+  }
+  // The original face is reused for the first of the three new faces 
+  int fid[3] = {f, m_nface, m_nface+1};
+  for (int i = 1; i < 3; i++)
+  {
+    m_faces.push_back(Face(fid[i]));
+    m_faces.back().type = m_faces[f].type;
+  }
+  m_nface += 2;
+  
+  // Half-edges from the new vertex to the face vertices (out) and back (in)
+  int out[3], in[3];
+  for (int i = 0; i < 3; i++)
+  {
+    out[i] = m_nedge;
+    this->add_edge(v,vf[i]);
+    in[i] = m_nedge;
+    this->add_edge(vf[i],v);
+    m_edges[out[i]].pair = in[i];
+    m_edges[in[i]].pair = out[i];
+  }
+  
+  // Face i is spanned by the original edge ef[i] (from vf[i] to vf[i+1]) and the new vertex
+  for (int i = 0; i < 3; i++)
+  {
+    int j = (i == 2) ? 0 : i + 1;
+    Face& face = m_faces[fid[i]];
+    face.vertices.clear();
+    face.edges.clear();
+    face.n_sides = 0;
+    face.add_vertex(vf[i]);  face.add_edge(ef[i]);
+    face.add_vertex(vf[j]);  face.add_edge(in[j]);
+    face.add_vertex(v);      face.add_edge(out[i]);
+    m_edges[ef[i]].next = in[j];
+    m_edges[in[j]].next = out[i];
+    m_edges[out[i]].next = ef[i];
+    m_edges[ef[i]].face = fid[i];
+    m_edges[in[j]].face = fid[i];
+    m_edges[out[i]].face = fid[i];
+  }
+  for (int i = 0; i < 3; i++)
+  {
+    Vertex& V = m_vertices[vf[i]];
+    V.remove_face(f);
+    V.add_face(fid[i]);
+    V.add_face(fid[(i == 0) ? 2 : i - 1]);
+    m_vertices[v].add_face(fid[i]);
+  }
+  
+  for (int i = 0; i < 3; i++)
+  {
+    this->compute_angles(fid[i]);
+    this->compute_centre(fid[i]);
+  }
+  for (int i = 0; i < 3; i++)
+    this->order_star(vf[i]);
+  this->order_star(v);
+  for (int i = 0; i < 3; i++)
+    this->mark_face_dirty(fid[i]);
+  
+  return true;
 }
 
 /*! Implements the equiangulation of the mesh. This is a procedure where 
  *  all edges that have the sum of their opposing angles larger than pi 
  *  flipped. This procedure is guaranteed to converge and at the end one 
  *  recovers a Delaunday triangulation. 
+ *  Instead of sweeping over all edges until no more flips occur, we keep a worklist
+ *  of edges that may violate the Delaunay condition. It is seeded with the edges of all faces 
+ *  around vertices that moved since the last call (or with all edges if the mesh has been rebuilt). 
+ *  After each flip, the four edges surrounding the flipped edge are added to the worklist. 
+ *  Therefore, the work is proportional to the number of moved vertices and flips and 
+ *  not to the mesh size.
 */
 bool Mesh::equiangulate()
 {
-  //cout << "Entered equiangulate" << endl;
   if (!m_is_triangulation)
     return true;   // We cannot equiangulate a non-triangular mesh
-  //cout << "Still in equiangulate" << endl;
   this->m_has_dangling = false;
-  bool flips = true;
+  this->seed_flip_queue();
   bool no_flips = true;
-  while (flips)
+  while (!m_flip_queue.empty())
   {
-    flips = false;
-    for (int e = 0; e < m_nedge; e++)
+    int e = m_flip_queue.back();
+    m_flip_queue.pop_back();
+    Edge& E = m_edges[e];
+    Edge& Ep = m_edges[E.pair];
+    m_in_queue[E.id] = false;
+    m_in_queue[Ep.id] = false;
+    if (!(E.boundary || Ep.boundary))
     {
-      Edge& E = m_edges[e];
-      Edge& Ep = m_edges[E.pair];
-      if (!(E.boundary || Ep.boundary))
+      Vertex& V1 = m_vertices[this->opposite_vertex(E.id)];
+      Vertex& V2 = m_vertices[this->opposite_vertex(Ep.id)];
+      Face& F1 = m_faces[E.face];
+      Face& F2 = m_faces[Ep.face];
+      double angle_1 = F1.get_angle(V1.id);
+      double angle_2 = F2.get_angle(V2.id);
+      //if (angle_1 + angle_2 > M_PI)
+      if (angle_1 + angle_2 < 0.0)
       {
-        Vertex& V1 = m_vertices[this->opposite_vertex(E.id)];
-        Vertex& V2 = m_vertices[this->opposite_vertex(Ep.id)];
-        Face& F1 = m_faces[E.face];
-        Face& F2 = m_faces[Ep.face];
-        double angle_1 = F1.get_angle(V1.id);
-        double angle_2 = F2.get_angle(V2.id);
-        //if (angle_1 + angle_2 > M_PI)
-        if (angle_1 + angle_2 < 0.0)
+        // Four edges surrounding the flipped edge
+        int e1 = E.next, e2 = m_edges[e1].next;
+        int e3 = Ep.next, e4 = m_edges[e3].next;
+        m_flip_faces.clear();
+        if (this->edge_flip(E.id, m_flip_faces))
         {
-          this->edge_flip(E.id);
-          flips = true;
           no_flips = false;
+          this->queue_edge(e1);  this->queue_edge(e2);
+          this->queue_edge(e3);  this->queue_edge(e4);
         }
       }
     }
@@ -732,6 +1044,51 @@ bool Mesh::equiangulate()
   return no_flips;
 }
 
+/*! Add an edge to the equiangulation worklist (unless it or its pair are already there).
+ *  \param e edge index
+*/
+void Mesh::queue_edge(int e)
+{
+  Edge& E = m_edges[e];
+  if (m_in_queue[E.id] || m_in_queue[E.pair])
+    return;
+  m_in_queue[E.id] = true;
+  m_in_queue[E.pair] = true;
+  m_flip_queue.push_back(E.id);
+}
+
+/*! Seed the equiangulation worklist. Moving a vertex changes angles in all 
+ *  faces it belongs to (these faces are marked dirty), so all edges of dirty faces have to be checked. 
+ *  Angles of these faces are recomputed here, such that the flip criterion is 
+ *  evaluated for the current vertex positions.
+ *  If the mesh has been rebuilt or relabelled, all edges are checked. 
+*/
+void Mesh::seed_flip_queue()
+{
+  m_flip_queue.clear();
+  if (static_cast<int>(m_in_queue.size()) < m_nedge)   // All flags are cleared when edges leave the worklist
+    m_in_queue.resize(m_nedge, false);
+  if (m_check_all)
+  {
+    for (int f = 0; f < m_nface; f++)
+      if (!m_faces[f].is_hole)
+        this->compute_angles(f);
+    for (int e = 0; e < m_nedge; e++)
+      this->queue_edge(e);
+    m_check_all = false;
+  }
+  else
+  {
+    for (unsigned int i = 0; i < m_dirty_faces.size(); i++)
+    {
+      Face& face = m_faces[m_dirty_faces[i]];
+      this->compute_angles(face.id);
+      for (unsigned int e = 0; e < face.edges.size(); e++)
+        this->queue_edge(face.edges[e]);
+    }
+  }
+}
+
 /*! For a triangular mesh compute derivatives (gradients) of the
  *  position of the face centre with respect to the position of
  *  each individual triangle vertices. We assume that the face (triangle)
@@ -841,23 +1198,95 @@ void Mesh::fc_jacobian(int f)
 **/
 void Mesh::update_face_properties()
 {
-  m_obtuse_boundary.clear();
-  for (unsigned int e = 0; e < m_boundary_edges.size(); e++)
+  if (m_all_boundary_dirty)
   {
-    Edge& E = m_edges[m_boundary_edges[e]];
-    Edge& Ep = m_edges[E.pair];
-    if (m_vertices[E.from].n_faces < 3) m_vertices[E.from].attached = false;
-    else m_vertices[E.from].attached = true;
-    Face& face = m_faces[Ep.face];
-    face.boundary = true;
-    if (face.get_angle(this->opposite_vertex(Ep.id)) < 0)
+    m_obtuse_boundary.clear();
+    m_obtuse_pos.assign(m_nedge, -1);
+    for (unsigned int e = 0; e < m_boundary_edges.size(); e++)
     {
-      face.obtuse = true;
-      if (!E.attempted_removal)
-        m_obtuse_boundary.push_back(E.id);
+      Edge& E = m_edges[m_boundary_edges[e]];
+      Edge& Ep = m_edges[E.pair];
+      if (m_vertices[E.from].n_faces < 3) m_vertices[E.from].attached = false;
+      else m_vertices[E.from].attached = true;
+      Face& face = m_faces[Ep.face];
+      face.boundary = true;
+      if (face.get_angle(this->opposite_vertex(Ep.id)) < 0)
+      {
+        face.obtuse = true;
+        if (!E.attempted_removal)
+          this->set_obtuse_boundary(E.id, true);
+      }
     }
+    m_all_boundary_dirty = false;
+  }
+  else
+  {
+    for (unsigned int i = 0; i < m_dirty_boundary_faces.size(); i++)
+      this->update_boundary_face(m_dirty_boundary_faces[i]);
+  }
+  for (unsigned int i = 0; i < m_dirty_boundary_faces.size(); i++)
+    m_boundary_face_dirty[m_dirty_boundary_faces[i]] = false;
+  m_dirty_boundary_faces.clear();
+}
+
+/*! Update boundary information for a face that changed and has at least
+ *  one vertex on the boundary. Angles of the face only change if the face is dirty 
+ *  (and edge flips always mark both faces as dirty), so only boundary edges of such faces 
+ *  can change their obtuse status. The number of faces of boundary vertices can only change 
+ *  in an edge flip, which marks all faces that contain them.
+ *  \param f face index
+*/
+void Mesh::update_boundary_face(int f)
+{
+  Face& face = m_faces[f];
+  if (face.is_hole)
+    return;
+  for (int i = 0; i < face.n_sides; i++)
+  {
+    Vertex& V = m_vertices[face.vertices[i]];
+    if (V.boundary)
+      for (int e = 0; e < V.n_edges; e++)
+        if (m_edges[V.edges[e]].boundary)
+          V.attached = (V.n_faces >= 3);
+  }
+  for (unsigned int e = 0; e < face.edges.size(); e++)
+  {
+    Edge& Ep = m_edges[face.edges[e]];
+    Edge& E = m_edges[Ep.pair];
+    if (E.boundary)
+    {
+      face.boundary = true;
+      bool obtuse = (face.get_angle(this->opposite_vertex(Ep.id)) < 0);
+      if (obtuse)
+        face.obtuse = true;
+      this->set_obtuse_boundary(E.id, obtuse && !E.attempted_removal);
+    }
+  }
+}
+
+/*! Keep list of obtuse boundary edges. Each edge remembers its position
+ *  in the list, so both insertion and removal take constant time.
+ *  \param e boundary edge index
+ *  \param obtuse if true, edge is in the list
+*/
+void Mesh::set_obtuse_boundary(int e, bool obtuse)
+{
+  if (static_cast<int>(m_obtuse_pos.size()) < m_nedge)
+    m_obtuse_pos.resize(m_nedge, -1);
+  int pos = m_obtuse_pos[e];
+  if (obtuse && pos < 0)
+  {
+    m_obtuse_pos[e] = m_obtuse_boundary.size();
+    m_obtuse_boundary.push_back(e);
+  }
+  else if (!obtuse && pos >= 0)
+  {
+    int last = m_obtuse_boundary.back();
+    m_obtuse_boundary[pos] = last;
+    m_obtuse_pos[last] = pos;
+    m_obtuse_boundary.pop_back();
+    m_obtuse_pos[e] = -1;
   }
-  
 }
 
 /*! Loop over all boundary faces. If the face is obtuse,
@@ -869,6 +1298,7 @@ bool Mesh::remove_obtuse_boundary()
   bool no_removals = true;
   for (int e = 0; e < m_nedge; e++)
     m_edges[e].attempted_removal = false;
+  m_all_boundary_dirty = true;
   this->update_face_properties();
   while (m_obtuse_boundary.size() > 0)
   {
@@ -972,6 +1402,7 @@ vector<Vector3d> Mesh::fix_obtuse_boundary()
     this->compute_angles(face.id);
     this->compute_centre(face.id);  
     cout << "Adding vertex : " << V << endl;
+    this->mark_all_dirty();
   }
   this->update_face_properties();
   this->update_dual_mesh();
@@ -1094,8 +1525,8 @@ PlotArea& Mesh::plot_area(bool boundary)
         for (int f = 0; f < V.n_faces; f++)
           sides.push_back(face_idx[V.dual[f]]);
         m_plot_area.sides.push_back(sides);
-        m_plot_area.area.push_back(this->dual_area(V.id));
-        m_plot_area.perim.push_back(this->dual_perimeter(V.id));
+        m_plot_area.area.push_back(V.area);
+        m_plot_area.perim.push_back(V.perim);
         m_plot_area.type.push_back(V.type);
       }
       else
@@ -1113,8 +1544,8 @@ PlotArea& Mesh::plot_area(bool boundary)
         for (int f = 0; f < V.n_faces-1; f++)
           sides.push_back(face_idx[V.dual[f]]);
         m_plot_area.sides.push_back(sides);
-        m_plot_area.area.push_back(this->dual_area(V.id));
-        m_plot_area.perim.push_back(this->dual_perimeter(V.id));
+        m_plot_area.area.push_back(V.area);
+        m_plot_area.perim.push_back(V.perim);
         m_plot_area.type.push_back(V.type);
       }
     }
@@ -1234,6 +1665,9 @@ bool Mesh::remove_edge_pair(int e)
  
   E.attempted_removal = true;
   Ep.attempted_removal = true;
+  m_all_boundary_dirty = true;
+  m_boundary_vertices_dirty = true;
+  m_boundary_geometry.valid = false;
   // We can only remove boundary edge pairs
   if (!E.boundary)
     return false;
@@ -1267,13 +1701,8 @@ bool Mesh::remove_edge_pair(int e)
   V1.remove_face(face.id);
   V2.remove_face(face.id);
   
-  map<pair<int,int>, int>::iterator it = m_edge_map.find(make_pair(V1.id,V2.id));
-  if (it != m_edge_map.end())
-     m_edge_map.erase(it);
-     
-  it = m_edge_map.find(make_pair(V2.id,V1.id));
-  if (it != m_edge_map.end())
-     m_edge_map.erase(it);
+  m_edge_map.erase(V1.id,V2.id);
+  m_edge_map.erase(V2.id,V1.id);
   
   // Remove edge from the list of boundary edges
   m_boundary_edges.erase(find(m_boundary_edges.begin(),m_boundary_edges.end(),E.id));
@@ -1376,11 +1805,8 @@ bool Mesh::remove_edge_pair(int e)
   }
   
   // Relabel edge_map info
-  for (it = m_edge_map.begin(); it != m_edge_map.end(); it++)
-  {
-    if ((*it).second > e1 && (*it).second < e2) (*it).second -= 1;
-    else if ((*it).second > e2) (*it).second -= 2;
-  }
+  m_edge_map.remove_label(e2);
+  m_edge_map.remove_label(e1);
   
   // Relabel face edge info
   for (int ff = 0; ff < m_nface; ff++)
@@ -1396,6 +1822,9 @@ bool Mesh::remove_edge_pair(int e)
   // Order affected vertices
   for (unsigned int v = 0; v < affected_vertices.size(); v++)
     this->order_star(affected_vertices[v]);
+  
+  // Edges have been relabelled 
+  this->mark_all_dirty();
     
   return true;
   
@@ -1493,8 +1922,7 @@ void Mesh::remove_edge(int e)
   }
   
   // Relabel edge_map info
-  for (map<pair<int,int>, int>::iterator it = m_edge_map.begin(); it != m_edge_map.end(); it++)
-    if ((*it).second > e) (*it).second--;
+  m_edge_map.remove_label(e);
     
   // Relabel face edge info
   for (int ff = 0; ff < m_nface; ff++)
@@ -1605,12 +2033,8 @@ bool Mesh::remove_edge_face(int f)
     assert(m_vertices[V.neigh[v]].boundary);
     m_vertices[V.neigh[v]].remove_neighbour(V.id);
     m_vertices[V.neigh[v]].remove_face(f);
-    map<pair<int,int>, int>::iterator it = m_edge_map.find(make_pair(V.id,m_vertices[V.neigh[v]].id));
-    if (it != m_edge_map.end())
-      m_edge_map.erase(it);
-    it = m_edge_map.find(make_pair(m_vertices[V.neigh[v]].id,V.id));
-    if (it != m_edge_map.end())
-      m_edge_map.erase(it);
+    m_edge_map.erase(V.id,m_vertices[V.neigh[v]].id);
+    m_edge_map.erase(m_vertices[V.neigh[v]].id,V.id);
     affected_vertices.push_back(V.neigh[v]);
   }
   V.neigh.clear();
@@ -1646,6 +2070,9 @@ bool Mesh::remove_edge_face(int f)
   // Order affected vertices
   for (unsigned int v = 0; v < affected_vertices.size(); v++)
     this->order_star(affected_vertices[v]);
+  
+  // Edges have been relabelled 
+  this->mark_all_dirty();
     
   return true;
   
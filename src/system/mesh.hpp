@@ -33,6 +33,7 @@
 #include "vertex.hpp"
 #include "edge.hpp"
 #include "face.hpp"
+#include "edge_map.hpp"
 
 #include <vector>
 #include <map>
@@ -78,6 +79,18 @@ typedef struct
   vector<int> boundary_faces;
 } PlotArea;
 
+//! Geometry of the mesh boundary shared by all potentials that act on it 
+//! (recomputed once per force evaluation, see System::get_boundary_geometry)
+typedef struct
+{
+  vector<Vector3d> edge_vec;    //!< Vectors along boundary edges (to - from), in the order of the boundary edge list
+  vector<double> edge_len;      //!< Lengths of boundary edges
+  vector<int> star_start;       //!< Position of the star of each boundary vertex in star_vec and star_len
+  vector<Vector3d> star_vec;    //!< Vectors from boundary vertices to their neighbours, in the order of Vertex::neigh
+  vector<double> star_len;      //!< Lengths of vectors in star_vec
+  bool valid;                   //!< If false, the geometry has to be recomputed
+} BoundaryGeometry;
+
 /*! Mesh class handles basic manipulations with meshes.
  *
  */
@@ -91,8 +104,16 @@ public:
            m_is_triangulation(true), 
            m_max_face_perim(20.0),
            m_circumcenter(true),
-           m_has_dangling(false)
-  {   }
+           m_has_dangling(false),
+           m_check_all(true),
+           m_all_faces_dirty(true),
+           m_all_vertices_dirty(true),
+           m_all_boundary_dirty(true),
+           m_dual_generation(0),
+           m_boundary_vertices_dirty(true)
+  { 
+    m_boundary_geometry.valid = false;
+  }
   
   //! Get mesh size
   int size() { return m_size; }
@@ -112,12 +133,21 @@ public:
   //! Get list of faces
   vector<Face>& get_faces() { return m_faces; }
   
-  //! Get edge-face data structure
-  map<pair<int,int>, int>& get_edge_face() { return m_edge_face; }
+  //! Get list of all boundary edges
+  vector<int>& get_boundary_edges() { return m_boundary_edges; }
+  
+  //! Get list of all boundary vertices
+  vector<int>& get_boundary_vertices();
   
   //! Get the information about boundary vertex pairs
   vector<pair<int,int> >& get_boundary() { return m_boundary; }
   
+  //! Get cached geometry of the boundary (it is filled by System::get_boundary_geometry)
+  BoundaryGeometry& get_boundary_geometry() { return m_boundary_geometry; }
+  
+  //! Mark cached boundary geometry as stale (e.g., particles have moved)
+  void invalidate_boundary_geometry() { m_boundary_geometry.valid = false; }
+  
   //! Get maximum face perimeter
   double get_max_face_perim() {  return m_max_face_perim; }
   
@@ -163,12 +193,22 @@ public:
   //! Update dual mesh
   void update_dual_mesh();
   
+  //! Update order, area and perimeter of duals affected by changes of the mesh
+  void update_dual_cells();
+  
   //! Updates vertex positions 
   //! \param p particle
+  //! \note Faces around vertices that moved are marked dirty, so that only they (and their duals) are updated
   void update(Particle& p)
   {
-    m_vertices[p.get_id()].r = Vector3d(p.x, p.y, p.z);
-    m_vertices[p.get_id()].type = p.get_type();
+    Vertex& V = m_vertices[p.get_id()];
+    if (V.r.x != p.x || V.r.y != p.y || V.r.z != p.z)
+    {
+      V.r = Vector3d(p.x, p.y, p.z);
+      for (unsigned int f = 0; f < V.faces.size(); f++)
+        this->mark_face_dirty(V.faces[f]);
+    }
+    V.type = p.get_type();
   }
   
   //! Post-processes the mesh
@@ -196,7 +236,16 @@ public:
   int opposite_vertex(int);
   
   //! Flip edge
-  void edge_flip(int);
+  bool edge_flip(int, vector<int>&);
+  
+  //! Find face in the vertex star that contains a point
+  int find_face(int, const Vector3d&);
+  
+  //! Check if moving a vertex keeps orientation of all faces in its star
+  bool keeps_orientation(int, const Vector3d&);
+  
+  //! Insert new vertex into a face
+  bool insert_vertex(Particle&, int);
   
   //! Mesh equiangulation
   bool equiangulate();
@@ -246,6 +295,9 @@ public:
     */
     return m_has_dangling;
   }
+  
+  //! Return dual generation counter (changes every time dual areas and perimeters are updated)
+  unsigned long get_dual_generation() { return m_dual_generation; }
 
   //! Dump mesh into off file for debugging purposes
   void debug_dump(const string&);
@@ -263,13 +315,31 @@ private:
   vector<Vertex> m_vertices;           //!< Contains all vertices
   vector<Edge> m_edges;                //!< Contains all edge
   vector<Face> m_faces;                //!< Contains all faces
-  map<pair<int,int>, int> m_edge_map;  //!< Relates vertex indices to edge ids
-  map<pair<int,int>, int> m_edge_face; //!< Relates pairs of faces to edges
+  EdgeMap m_edge_map;                  //!< Relates vertex indices to edge ids
   vector<pair<int,int> > m_boundary;   //!< List of vertex pair that are on the boundary
   vector<int> m_boundary_edges;        //!< List of all edges that are at the boundary
   vector<int> m_obtuse_boundary;       //!< List of all boundary edges that have obtuse angle opposite to them  
   PlotArea m_plot_area;                //!< Used to preapre polygonal data for plotting
   
+  bool m_check_all;                    //!< If true, equiangulation has to check all edges (e.g., after the mesh has been rebuilt)
+  bool m_all_faces_dirty;              //!< If true, properties of all faces have to be recomputed
+  bool m_all_vertices_dirty;           //!< If true, duals of all vertices have to be recomputed
+  vector<int> m_dirty_faces;           //!< Faces whose vertices moved or changed since the last update of the dual mesh
+  vector<bool> m_face_dirty;           //!< Flags faces that are in m_dirty_faces
+  vector<int> m_dirty_vertices;        //!< Vertices whose duals have to be recomputed
+  vector<bool> m_vertex_dirty;         //!< Flags vertices that are in m_dirty_vertices
+  bool m_all_boundary_dirty;           //!< If true, properties of all boundary edges have to be recomputed
+  vector<int> m_dirty_boundary_faces;  //!< Dirty faces with at least one boundary vertex
+  vector<bool> m_boundary_face_dirty;  //!< Flags faces that are in m_dirty_boundary_faces
+  vector<int> m_obtuse_pos;            //!< Position of each edge in m_obtuse_boundary (-1 if not there)
+  unsigned long m_dual_generation;     //!< Incremented every time cached dual areas and perimeters (Vertex::area and Vertex::perim) change
+  vector<int> m_boundary_vertices;     //!< List of all boundary vertices (built on demand)
+  bool m_boundary_vertices_dirty;      //!< If true, m_boundary_vertices has to be rebuilt
+  BoundaryGeometry m_boundary_geometry;  //!< Boundary edge vectors and lengths shared by boundary potentials
+  vector<int> m_flip_queue;            //!< Worklist of edges that have to be checked by the equiangulation
+  vector<bool> m_in_queue;             //!< Flags edges that are in the worklist
+  vector<int> m_flip_faces;            //!< Faces touched by the last edge flip
+  
   //! Compute face circumcentre
   void compute_circumcentre(int);
   
@@ -293,6 +363,24 @@ private:
   
   //! Remove edge face
   bool remove_edge_face(int);
+  
+  //! Add edge (and its pair) to the equiangulation worklist
+  void queue_edge(int);
+  
+  //! Fill equiangulation worklist with edges of dirty faces
+  void seed_flip_queue();
+  
+  //! Mark face (and its vertices) as dirty
+  void mark_face_dirty(int);
+  
+  //! Mark all faces and vertices as dirty (after mesh has been rebuilt or relabelled)
+  void mark_all_dirty();
+  
+  //! Update boundary properties of a face next to the boundary
+  void update_boundary_face(int);
+  
+  //! Add or remove boundary edge from the list of obtuse boundary edges
+  void set_obtuse_boundary(int, bool);
 
   //! Returns coordinates of the mirror image of a vertex opposite to a boundary edge
   Vector3d mirror_vertex(int);
@@ -116,18 +116,58 @@ void mark_domains(Delaunay& cdt)
 */
 void NeighbourList::build()
 {
- m_list.clear();
+ std::chrono::steady_clock::time_point build_start = std::chrono::steady_clock::now();
+ m_skin = m_pad;
  
  if (m_remove_detached)
-   this->remove_detached();
+ {
+   // With incremental meshing contacts of the last full triangulation are out of date and are taken 
+   // from the current mesh. If the mesh does not match the particles, removal is skipped in this build.
+   if (!m_incremental_mesh || this->contacts_from_mesh())
+     this->remove_detached();
+ }
   
- for (int i = 0; i < m_system->size(); i++)
-   m_list.push_back(vector<int>());
+ // Reuse the storage of the previous build so that rebuilds do not allocate
+ m_list.resize(m_system->size());
+ for (unsigned int i = 0; i < m_list.size(); i++)
+   m_list[i].clear();
+ 
+ if (m_use_type_cut)
+   this->update_type_cutoffs();
+ 
+ bool use_levels = false;
+ if (m_radius_cut > 0.0 && m_system->size() > 0)
+ {
+   double reach_min = this->reach(m_system->get_particle(0));
+   m_reach_max = reach_min;
+   for (int i = 1; i < m_system->size(); i++)
+   {
+     double a = this->reach(m_system->get_particle(i));
+     reach_min = std::min(reach_min, a);
+     m_reach_max = std::max(m_reach_max, a);
+   }
+   use_levels = (m_reach_max > 0.0 && m_reach_max > m_poly_ratio*reach_min);
+ }
  
  if (!m_disable_nlist)
  {
-  if (m_use_cell_list) 
-    this->build_cell();
+  if (m_parent)
+    this->build_parent();
+  else if (m_use_cell_list) 
+  {
+    if (use_levels != m_use_levels)
+    {
+      if (use_levels)
+        m_msg->msg(Messenger::INFO,"Neighbour list. Particle sizes are widely distributed. Switching to hierarchical cell lists.");
+      else
+        m_msg->msg(Messenger::INFO,"Neighbour list. Particle sizes are no longer widely distributed. Switching to single cell list.");
+      m_use_levels = use_levels;
+    }
+    if (m_use_levels)
+      this->build_levels();
+    else
+      this->build_cell();
+  }
   else
   {
     m_old_state.clear();
@@ -145,7 +185,14 @@ void NeighbourList::build()
     }
  }
   
- this->build_mesh();
+ if (m_auto_pad)
+ {
+   m_tune_build_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - build_start).count();
+   m_tune_builds++;
+ }
+  
+ this->refresh_mesh();
+ m_build_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - build_start).count();
 }
 
 /*! Build faces of the mesh from the particle locations */
@@ -154,6 +201,7 @@ void NeighbourList::build_mesh()
 #ifdef HAS_CGAL
   if (m_triangulation)
   {
+    m_system->set_force_mesh_rebuild(false);
     if (!m_system->has_boundary_neighbours())
     {
       m_msg->msg(Messenger::INFO,"Boundary neighbours have to be defined in a tissue simulations. Please use command \"read_cell_boundary\" in the config file.");
@@ -169,6 +217,18 @@ void NeighbourList::build_mesh()
 }
 
 
+/*! Retriangulate only if necessary. Between rebuilds, System::update_mesh keeps 
+ *  the mesh Delaunay by local edge flips after every time step, so the full CGAL triangulation 
+ *  is only needed if particles were added or removed, or if the mesh reported
+ *  obtuse boundary or dangling vertices. Without incremental_mesh flag the mesh is 
+ *  always rebuilt.
+*/
+void NeighbourList::refresh_mesh()
+{
+  if (!m_incremental_mesh || m_system->get_force_mesh_rebuild() || m_system->get_mesh().size() != m_system->size())
+    this->build_mesh();
+}
+
 // Private methods below
 
 /* Do actual building. */
@@ -192,6 +252,7 @@ void NeighbourList::build_nsq(int i)
     double dz = pi.z - pj.z;
     m_system->apply_periodic(dx,dy,dz);
     d2 = dx*dx + dy*dy + dz*dz;
+    cut2 = this->pair_cut_sq(pi, pj);
     if (m_system->has_exclusions())
       if (m_system->in_exclusion(pi.get_id(), pj.get_id()))
         exclude = true;
@@ -235,9 +296,24 @@ void NeighbourList::build_cell()
   {
     Particle& pi = m_system->get_particle(i);
     int cell_idx = m_cell_list->get_cell_idx(pi);
-    vector<int>& neigh_cells = m_cell_list->get_cell(cell_idx).get_neighbours();  // per design includes this cell as well
+    // With per type cutoffs, neighbouring cells that are further than the largest cutoff for this particle type can be skipped
+    double max_cut2 = cut*cut;
+    if (m_use_type_cut && static_cast<unsigned int>(pi.get_type() - 1) < m_type_max_cut_sq.size())
+      max_cut2 = m_type_max_cut_sq[pi.get_type() - 1];
+    if (m_radius_cut > 0.0)
+    {
+      double rc = m_radius_cut*(this->reach(pi) + m_reach_max) + m_pad;
+      max_cut2 = std::min(max_cut2, rc*rc);
+    }
+    bool skip_cells = (max_cut2 < cut*cut) && (m_cell_sub == 1);
+    // With subdivided cells, stencil extends over several cells in each direction
+    if (m_cell_sub > 1)
+      m_cell_list->get_cells_within(pi, std::sqrt(max_cut2), m_stencil);
+    vector<int>& neigh_cells = (m_cell_sub > 1) ? m_stencil : m_cell_list->get_cell(cell_idx).get_neighbours();  // per design includes this cell as well
     for (vector<int>::iterator it = neigh_cells.begin(); it != neigh_cells.end(); it++)
     {
+      if (skip_cells && m_cell_list->min_distance_sq(pi, cell_idx, *it) >= max_cut2)
+        continue;
       Cell& c = m_cell_list->get_cell(*it);
       vector<int>& p_idx_vec = c.get_particles(); 
       for (unsigned int j = 0; j < p_idx_vec.size(); j++)
@@ -251,6 +327,7 @@ void NeighbourList::build_cell()
           double dz = pi.z - pj.z;
           m_system->apply_periodic(dx,dy,dz);
           d2 = dx*dx + dy*dy + dz*dz;
+          cut2 = this->pair_cut_sq(pi, pj);
           if (m_system->has_exclusions())
             if (m_system->in_exclusion(pi.get_id(), pj.get_id()))
               exclude = true;
@@ -272,6 +349,405 @@ void NeighbourList::build_cell()
   }
 }
 
+/*! Build neighbour list using a hierarchy of cell lists. Particles are binned into 
+ *  size levels, level k containing particles with sizes between top/2^(k+1) and top/2^k, 
+ *  where top is the smallest power of two not smaller than the largest particle size 
+ *  (so that level boundaries do not move as particles grow). Each level has its own cell list with 
+ *  cell width matched to the largest cutoff between two particles of that level. For each 
+ *  particle, we only scan cells of each level that are within the largest possible cutoff 
+ *  between that particle and a particle of that level.
+*/
+void NeighbourList::build_levels()
+{
+  const int max_levels = 8;   // All particles smaller than top/2^max_levels are in the last level
+  int N = m_system->size();
+  BoxPtr box = m_system->get_box();
+  double cut = m_cut+m_pad;
+  double cut2;
+  double d2;
+  
+  m_old_state.clear();
+  
+  double top = std::pow(2.0, std::ceil(std::log2(m_reach_max)));
+  m_level_particles.resize(max_levels);
+  for (int l = 0; l < max_levels; l++)
+    m_level_particles[l].clear();
+  for (int i = 0; i < N; i++)
+  {
+    Particle& pi = m_system->get_particle(i);
+    pi.coordination = 0;
+    double a = this->reach(pi);
+    int k = (a > 0.0) ? static_cast<int>(std::floor(std::log2(top/a))) : max_levels - 1;
+    k = std::max(0, std::min(k, max_levels - 1));
+    m_level_particles[k].push_back(i);
+  }
+  
+  // Set up cell list for each level; to avoid too many cells for levels with small particles, cells are never smaller than needed for about 8 cells per particle
+  double volume = box->planar ? box->Lx*box->Ly : box->Lx*box->Ly*box->Lz;
+  double w_min = box->planar ? std::sqrt(volume/(8.0*N)) : std::cbrt(volume/(8.0*N));
+  vector<double> level_reach(max_levels);
+  m_level_cells.resize(max_levels);
+  m_level_width.resize(max_levels, 0.0);
+  for (int k = 0; k < max_levels; k++)
+  {
+    level_reach[k] = top/std::pow(2.0, k);
+    if (m_level_particles[k].size() == 0)
+      continue;
+    double w = std::max(w_min, std::min(cut, 2.0*m_radius_cut*level_reach[k] + m_pad));
+    // Cell lists are recreated only if cell width changed significantly (the build is correct for any cell width)
+    if (!m_level_cells[k] || std::fabs(m_level_width[k] - w) > 0.1*w)
+    {
+      m_level_cells[k] = shared_ptr<CellList>(new CellList(m_system,m_msg,w));
+      m_level_width[k] = w;
+    }
+    m_level_cells[k]->populate(m_level_particles[k]);
+  }
+  
+  vector<int> cells;
+  for (int i = 0; i < N; i++)
+  {
+    Particle& pi = m_system->get_particle(i);
+    double a = this->reach(pi);
+    double max_cut = cut;
+    if (m_use_type_cut && static_cast<unsigned int>(pi.get_type() - 1) < m_type_max_cut_sq.size())
+      max_cut = std::sqrt(m_type_max_cut_sq[pi.get_type() - 1]);
+    for (int k = 0; k < max_levels; k++)
+    {
+      if (m_level_particles[k].size() == 0)
+        continue;
+      double range = std::min(max_cut, m_radius_cut*(a + level_reach[k]) + m_pad);
+      m_level_cells[k]->get_cells_within(pi, range, cells);
+      for (vector<int>::iterator it = cells.begin(); it != cells.end(); it++)
+      {
+        vector<int>& p_idx_vec = m_level_cells[k]->get_cell(*it).get_particles(); 
+        for (unsigned int j = 0; j < p_idx_vec.size(); j++)
+        {
+          Particle& pj = m_system->get_particle(p_idx_vec[j]);
+          bool exclude = false;
+          if (pj.get_id() > pi.get_id())
+          {
+            double dx = pi.x - pj.x;
+            double dy = pi.y - pj.y;
+            double dz = pi.z - pj.z;
+            m_system->apply_periodic(dx,dy,dz);
+            d2 = dx*dx + dy*dy + dz*dz;
+            cut2 = this->pair_cut_sq(pi, pj);
+            if (m_system->has_exclusions())
+              if (m_system->in_exclusion(pi.get_id(), pj.get_id()))
+                exclude = true;
+            if (d2 < cut2 && (!exclude))
+              m_list[i].push_back(pj.get_id());
+            if (d2 < cut2)
+            {
+              double r = pi.get_radius() + pj.get_radius();
+              if (d2 < r*r)
+              {
+                pi.coordination++;
+                pj.coordination++;
+              }
+            }
+          }
+        }
+      }
+    }
+    m_old_state.push_back(PartPos(pi.x,pi.y,pi.z));
+  }
+}
+
+/*! Build list by filtering pairs in the parent list. Parent list contains all pairs 
+ *  that were closer than its cutoff plus padding when it was built. Since then, distance between 
+ *  any two particles could have decreased by at most twice the largest displacement. If that is larger 
+ *  than the difference between the parent's and this list's build cutoffs, parent is rebuilt first.
+ *  \note If cutoffs have been rescaled such that this list's cutoff exceeds the parent's, list is built using N^2 algorithm.
+*/
+void NeighbourList::build_parent()
+{
+  int N = m_system->size();
+  double cut = m_cut+m_pad;
+  double cut2 = cut*cut;
+  double parent_cut = m_parent->get_cutoff() + m_parent->get_skin();
+  
+  m_old_state.clear();
+  if (cut > parent_cut)
+  {
+    for (int i = 0; i < N; i++)
+      this->build_nsq(i);
+    return;
+  }
+  
+  double slack = 0.5*(parent_cut - cut);
+  if (m_parent->max_displacement_sq() > slack*slack || m_parent->m_list.size() != static_cast<unsigned int>(N))
+    m_parent->build();
+  
+  for (int i = 0; i < N; i++)
+  {
+    Particle& pi = m_system->get_particle(i);
+    vector<int>& parent_neigh = m_parent->get_neighbours(i);
+    for (unsigned int j = 0; j < parent_neigh.size(); j++)
+    {
+      Particle& pj = m_system->get_particle(parent_neigh[j]);
+      double dx = pi.x - pj.x;
+      double dy = pi.y - pj.y;
+      double dz = pi.z - pj.z;
+      m_system->apply_periodic(dx,dy,dz);
+      double d2 = dx*dx + dy*dy + dz*dz;
+      cut2 = this->pair_cut_sq(pi, pj);
+      // Exclusions have already been handled by the parent
+      if (d2 < cut2)
+        m_list[i].push_back(parent_neigh[j]);
+    }
+    m_old_state.push_back(PartPos(pi.x,pi.y,pi.z));
+  }
+}
+
+//! Largest squared displacement of any particle since the last build
+//! \return squared displacement (infinity if the number of particles has changed)
+double NeighbourList::max_displacement_sq()
+{
+  int N = m_system->size();
+  if (static_cast<int>(m_old_state.size()) != N)
+    return std::numeric_limits<double>::max();
+  bool periodic = m_system->get_periodic();
+  BoxPtr box = m_system->get_box();
+  double max_d2 = 0.0;
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = m_system->get_particle(i);
+    double dx = m_old_state[i].x - p.x;
+    double dy = m_old_state[i].y - p.y;
+    double dz = m_old_state[i].z - p.z;
+    if (periodic)
+    {
+      if (dx > box->xhi) dx -= box->Lx;
+      else if (dx < box->xlo) dx += box->Lx;
+      if (dy > box->yhi) dy -= box->Ly;
+      else if (dy < box->ylo) dy += box->Ly;
+      if (dz > box->zhi) dz -= box->Lz;
+      else if (dz < box->zlo) dz += box->Lz;
+    }
+    max_d2 = std::max(max_d2, dx*dx + dy*dy + dz*dz);
+  }
+  return max_d2;
+}
+
+/*! Recompute build cutoffs for each pair of particle types. Cutoff for a given pair is 
+ *  the largest of the cutoffs reported by all interactions that use this list, plus padding. 
+ *  If any of the interactions does not report its cutoff for the pair (or no interaction
+ *  has been registered), the global cutoff is used.
+*/
+void NeighbourList::update_type_cutoffs()
+{
+  int ntypes = m_system->get_ntypes();
+  double cut = m_cut + m_pad;
+  m_type_cut_sq.assign(ntypes, vector<double>(ntypes, cut*cut));
+  m_type_max_cut_sq.assign(ntypes, 0.0);
+  for (int i = 0; i < ntypes; i++)
+    for (int j = 0; j < ntypes; j++)
+    {
+      bool known = !m_cutoff_providers.empty();
+      double rcut = 0.0;
+      for (map<string, CutoffFunction>::iterator it = m_cutoff_providers.begin(); it != m_cutoff_providers.end() && known; it++)
+      {
+        double c = (it->second)(i+1, j+1);
+        if (c <= 0.0)
+          known = false;
+        else
+          rcut = std::max(rcut, c);
+      }
+      if (known && rcut < m_cut)
+        m_type_cut_sq[i][j] = (rcut + m_pad)*(rcut + m_pad);
+      m_type_max_cut_sq[i] = std::max(m_type_max_cut_sq[i], m_type_cut_sq[i][j]);
+    }
+}
+
+/*! Auto-tune padding distance and cell subdivision. Cost of a setting is the average 
+ *  wall-clock time per step measured over a window of steps. It includes force evaluation, 
+ *  which becomes more expensive with larger padding, and list builds, which become less 
+ *  frequent with larger padding. Padding distance is optimised by a multiplicative hill climb 
+ *  whose step is reduced every time moves in both directions fail. Once it converges, the other 
+ *  cell subdivision (1 or 2) is tried. Best setting is then kept for m_tune_hold windows 
+ *  before tuning starts again, since the optimum changes as the system evolves (e.g., due to growth).
+ *  All changes are recorded in the configuration file so that the run can be reproduced.
+ *  \param step_time wall-clock duration of the last time step (in seconds)
+*/
+void NeighbourList::tune(double step_time)
+{
+  if (!m_auto_pad)
+    return;
+  m_tune_time += step_time;
+  m_tune_steps++;
+  if (m_tune_steps < m_tune_window)
+    return;
+  
+  double cost = m_tune_time/m_tune_steps;
+  string build_info = (m_tune_builds > 0) ? lexical_cast<string>(m_tune_builds)+" builds (average build time "+lexical_cast<string>(m_tune_build_time/m_tune_builds)+" s)" : "no builds";
+  m_msg->msg(Messenger::INFO,"Neighbour list tuning at step "+lexical_cast<string>(m_system->get_step())+". Padding distance "+lexical_cast<string>(m_pad)+", cell subdivision "+lexical_cast<string>(m_cell_sub)+" : "+lexical_cast<string>(cost)+" s per step, "+build_info+".");
+  m_tune_steps = 0;
+  m_tune_time = 0.0;
+  m_tune_build_time = 0.0;
+  m_tune_builds = 0;
+  
+  switch (m_tune_state)
+  {
+    case TUNE_START:
+      m_best_cost = cost;
+      m_best_pad = m_pad;
+      m_best_cell_sub = m_cell_sub;
+      m_pad_factor = 1.25;
+      m_pad_dir = 1;
+      m_tune_state = TUNE_PAD;
+      break;
+    case TUNE_PAD:
+      if (cost < m_best_cost)
+      {
+        m_best_cost = cost;
+        m_best_pad = m_pad;
+      }
+      else if (m_pad_dir == 1)
+        m_pad_dir = -1;
+      else
+      {
+        m_pad_dir = 1;
+        m_pad_factor = std::sqrt(m_pad_factor);
+      }
+      break;
+    case TUNE_CELL:
+      if (cost < m_best_cost)
+      {
+        m_best_cost = cost;
+        m_best_cell_sub = m_cell_sub;
+      }
+      m_hold = m_tune_hold;
+      m_tune_state = TUNE_HOLD;
+      m_msg->msg(Messenger::INFO,"Neighbour list tuning converged. Padding distance "+lexical_cast<string>(m_best_pad)+", cell subdivision "+lexical_cast<string>(m_best_cell_sub)+".");
+      break;
+    case TUNE_HOLD:
+      if (--m_hold <= 0)
+        m_tune_state = TUNE_START;
+      break;
+  }
+  
+  double pad = m_best_pad;
+  int cell_sub = m_best_cell_sub;
+  if (m_tune_state == TUNE_PAD)
+  {
+    // Padding distance cannot be so large that cell lists no longer fit into the box
+    double max_pad = m_pad_max;
+    if (m_use_cell_list)
+    {
+      BoxPtr box = m_system->get_box();
+      double L = box->planar ? std::min(box->Lx,box->Ly) : std::min(box->Lx,std::min(box->Ly,box->Lz));
+      max_pad = std::min(max_pad, 0.499*L - m_cut);
+    }
+    while (m_pad_factor > 1.02)
+    {
+      double trial = std::min(std::max(m_best_pad*std::pow(m_pad_factor,m_pad_dir), m_pad_min), max_pad);
+      if (std::fabs(trial - m_best_pad) > 1e-3*m_best_pad)
+      {
+        pad = trial;
+        break;
+      }
+      // Trial hit the bound; try the other direction or a smaller step
+      if (m_pad_dir == 1)
+        m_pad_dir = -1;
+      else
+      {
+        m_pad_dir = 1;
+        m_pad_factor = std::sqrt(m_pad_factor);
+      }
+    }
+    if (m_pad_factor <= 1.02)
+    {
+      if (m_use_cell_list && !m_parent)
+      {
+        cell_sub = (m_best_cell_sub == 1) ? 2 : 1;
+        m_tune_state = TUNE_CELL;
+      }
+      else
+      {
+        m_hold = m_tune_hold;
+        m_tune_state = TUNE_HOLD;
+        m_msg->msg(Messenger::INFO,"Neighbour list tuning converged. Padding distance "+lexical_cast<string>(m_best_pad)+".");
+      }
+    }
+  }
+  if (pad != m_pad || cell_sub != m_cell_sub)
+    this->apply_tuning(pad, cell_sub);
+}
+
+//! Change padding distance and cell subdivision and rebuild the list
+//! \param pad new padding distance
+//! \param cell_sub new cell subdivision
+void NeighbourList::apply_tuning(double pad, int cell_sub)
+{
+  m_pad = pad;
+  m_cell_sub = cell_sub;
+  m_msg->add_config("nlist.auto_pad.history","step "+lexical_cast<string>(m_system->get_step())+" pad "+lexical_cast<string>(m_pad)+" cell_subdivision "+lexical_cast<string>(m_cell_sub));
+  this->reset_cell_list();
+  this->build();
+}
+
+/*! Update the list after positions of all particles (and possibly the box) have been 
+ *  uniformly scaled by a given factor (e.g., when the constraint is rescaled). Scaling maps the list 
+ *  onto a list built with all distances scaled by the same factor. Since interaction cutoffs 
+ *  do not change, scaling down eats into the skin, while scaling up only adds pairs that are 
+ *  not needed. Therefore, reference positions are scaled and the list is kept as long as 
+ *  there is skin left. Otherwise, list is rebuilt.
+ *  \param scale scale factor
+ *  \return true if list had to be rebuilt
+*/
+bool NeighbourList::affine_rescale(double scale)
+{
+  // Worst case is the pair with the largest cutoff when shrinking and the pair with zero cutoff when expanding
+  double skin = (scale < 1.0) ? scale*m_skin - (1.0 - scale)*m_cut : scale*m_skin;
+  // Box may have been rescaled, too
+  if (m_use_cell_list && this->cell_list_fits(m_cut+m_pad))
+    m_cell_list->resize((m_cut+m_pad)/m_cell_sub);
+  else if (m_use_cell_list)
+    this->reset_cell_list();
+  m_level_cells.clear();
+  if (skin <= 0.0 || !this->can_keep_list())
+  {
+    this->build();
+    return true;
+  }
+  m_skin = skin;
+  for (unsigned int i = 0; i < m_old_state.size(); i++)
+  {
+    m_old_state[i].x *= scale;
+    m_old_state[i].y *= scale;
+    m_old_state[i].z *= scale;
+  }
+  this->update_coordination();
+  return false;
+}
+
+//! Recount coordination of each particle (number of particles it overlaps with) using pairs in the list
+void NeighbourList::update_coordination()
+{
+  int N = m_system->size();
+  for (int i = 0; i < N; i++)
+    m_system->get_particle(i).coordination = 0;
+  for (int i = 0; i < N; i++)
+  {
+    Particle& pi = m_system->get_particle(i);
+    for (unsigned int j = 0; j < m_list[i].size(); j++)
+    {
+      Particle& pj = m_system->get_particle(m_list[i][j]);
+      double dx = pi.x - pj.x;
+      double dy = pi.y - pj.y;
+      double dz = pi.z - pj.z;
+      m_system->apply_periodic(dx,dy,dz);
+      double r = pi.get_radius() + pj.get_radius();
+      if (dx*dx + dy*dy + dz*dz < r*r)
+      {
+        pi.coordination++;
+        pj.coordination++;
+      }
+    }
+  }
+}
+
 //! Check is neighbour list of the given particle needs update
 //! \param p particle to check 
 //! \return true if the list needs update
@@ -295,7 +771,7 @@ bool NeighbourList::need_update(Particle& p)
     else if (dz < box->zlo) dz += box->Lz;
   }
   
-  if (dx*dx + dy*dy + dz*dz < 0.25*m_pad*m_pad)
+  if (dx*dx + dy*dy + dz*dz < 0.25*m_skin*m_skin)
     return false;
   else
     return true;
@@ -562,35 +1038,51 @@ void NeighbourList::remove_dangling()
    
 
    vector<int> to_remove;
-   int offset = 0;  // We need to shift vertex ids to match them in the removal
    for (unsigned int i = 0; i < m_contact_list.size(); i++)
    {
      Particle& pi = m_system->get_particle(i);
      if (pi.in_tissue && m_contact_list[i].size() == 0)
-     {
-       to_remove.push_back(i-offset);
-       offset++;       
-     }
+       to_remove.push_back(i);
    }
+   if (to_remove.size() == 0) return;
 
-   for (unsigned int i = 0; i < to_remove.size(); i++)
+   // Remove all detached particles at once and compact contacts using the map between old and new ids
+   vector<int> new_id = m_system->remove_particles(to_remove);
+   int n = 0;
+   for (unsigned int i = 0; i < m_contact_list.size(); i++)
    {
-     m_system->remove_particle(to_remove[i]);
-     if (m_contact_list[to_remove[i]].size() != 0)
-       throw runtime_error("Trying to remove connected particle.");
-     else
+     if (new_id[i] < 0) continue;
+     vector<int>& contacts = m_contact_list[i];
+     for (unsigned int k = 0; k < contacts.size(); k++)
      {
-       m_contact_list.erase(m_contact_list.begin() + to_remove[i]);
-       for (unsigned int j = 0; j < m_contact_list.size(); j++)
-       {
-         for (unsigned int k = 0; k < m_contact_list[j].size(); k++)
-           if (m_contact_list[j][k] > to_remove[i]) m_contact_list[j][k]--;
-       }
+       if (new_id[contacts[k]] < 0)
+         throw runtime_error("Trying to remove connected particle.");
+       contacts[k] = new_id[contacts[k]];
      }
+     if (n != static_cast<int>(i)) m_contact_list[n].swap(contacts);
+     n++;
    }
+   m_contact_list.resize(n);
  } 
 
 
+/*! Between full triangulations the mesh is kept Delaunay by edge flips, which are 
+ *  not recorded in the contact list. Replace contacts with the current neighbours of 
+ *  each mesh vertex, so that vertices that became detached after the last triangulation are found.
+ *  \return false if the mesh does not match the current particles (contacts are then left untouched)
+ */
+bool NeighbourList::contacts_from_mesh()
+{
+  Mesh& mesh = m_system->get_mesh();
+  if (mesh.size() == 0 || mesh.size() != m_system->size()) 
+    return false;
+  vector<Vertex>& vertices = mesh.get_vertices();
+  m_contact_list.resize(mesh.size());
+  for (int i = 0; i < mesh.size(); i++)
+    m_contact_list[i].assign(vertices[i].neigh.begin(), vertices[i].neigh.end());
+  return true;
+}
+
 /*! Auxiliary function for computing dot product between two vectors defined by three points.
  *  This is used to to determine if a particle needs to be mirrored when building the intial triangulation.
  *  \param p1 particle 1
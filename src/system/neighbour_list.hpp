@@ -36,7 +36,12 @@
 #include <string>
 #include <fstream>
 #include <list>
+#include <map>
 #include <memory>
+#include <functional>
+#include <chrono>
+#include <limits>
+#include <algorithm>
 
 
 #ifdef HAS_CGAL
@@ -57,7 +62,9 @@ using std::pair;
 using std::string;
 using std::ofstream;
 using std::list;
+using std::map;
 using std::shared_ptr;
+using std::function;
 
 #ifdef HAS_CGAL
 
@@ -106,11 +113,34 @@ struct PartPos
 };
 
 
+//! Function that returns cutoff distance for a pair of particle types (0 if not known)
+typedef function<double(int,int)> CutoffFunction;
+
 /*! This class handles neighbour lists for fast potential and force 
  *  calculations. It is implemented as a vector of vectors (for performance). 
  *  Since the system is on a curved surface
  *  it would be hard to make a general cell list. Therefore, we relay on
  *  the slower but generic N^2 list generation 
+ *  
+ *  If type_cutoff parameter is set, each pair of particle types gets its own 
+ *  build cutoff equal to the largest cutoff requested for that pair by pair potentials 
+ *  and pair aligners (plus padding). Interactions that do not report per type cutoffs 
+ *  force the global cutoff for all pairs. 
+ *  \note Other users of the neighbour list (e.g., populations and dumps) are not 
+ *  consulted, so this option should only be used if list is needed only for pair interactions.
+ *  
+ *  If radius_cutoff parameter is set to a value f, the build cutoff of a pair of 
+ *  particles with radii a_i and a_j is f*(a_i + a_j) plus padding (but never more than the 
+ *  global cutoff plus padding). This is useful for potentials that use particle radii (e.g., soft).
+ *  If, in addition, the ratio between the largest and the smallest radius exceeds poly_ratio, 
+ *  the list is built using a hierarchy of cell grids. Particles are binned into size levels, 
+ *  each with its own cell width, so that small particles only scan cells that are close enough.
+ *  With use_length flag, half of the rod length is added to the radius.
+ *  
+ *  A list can be derived from a parent list with a larger cutoff. Such list is 
+ *  built by filtering the pairs of the parent list, which is much cheaper than 
+ *  a full build. If particles moved too much since the parent was built for it 
+ *  to still contain all required pairs, parent is rebuilt first.
 */
 class NeighbourList
 {
@@ -121,32 +151,71 @@ public:
   //! \param msg Constant reference to the Messenger object
   //! \param cutoff Cutoff distance (should be set to potential cutoff distance + padding distance)
   //! \param pad Padding distance
-  NeighbourList(SystemPtr sys, MessengerPtr msg, double cutoff, double pad, pairs_type& param) : m_system(sys), 
+  //! \param param Contains information about all parameters
+  //! \param parent Parent neighbour list (if set, this list is built by filtering the parent list)
+  //! \param name Name of the list (empty for the global list), used as a part of keys in the configuration file
+  NeighbourList(SystemPtr sys, MessengerPtr msg, double cutoff, double pad, pairs_type& param, shared_ptr<NeighbourList> parent = shared_ptr<NeighbourList>(), const string& name = "") : m_system(sys), 
                                                                                                  m_msg(msg),
                                                                                                  m_cut(cutoff), 
                                                                                                  m_pad(pad), 
+                                                                                                 m_skin(pad),
                                                                                                  m_triangulation(false),
+                                                                                                 m_incremental_mesh(false),
                                                                                                  m_max_perim(20.0),
                                                                                                  m_circumcenter(true),
                                                                                                  m_disable_nlist(false),
                                                                                                  m_remove_detached(true),
-                                                                                                 m_static_boundary(false)
+                                                                                                 m_static_boundary(false),
+                                                                                                 m_use_type_cut(false),
+                                                                                                 m_parent(parent),
+                                                                                                 m_radius_cut(0.0),
+                                                                                                 m_use_length(false),
+                                                                                                 m_poly_ratio(4.0),
+                                                                                                 m_use_levels(false),
+                                                                                                 m_reach_max(0.0),
+                                                                                                 m_cell_sub(1),
+                                                                                                 m_auto_pad(false),
+                                                                                                 m_build_time(0.0)
   {
-    m_msg->write_config("nlist.cut",lexical_cast<string>(m_cut));
-    m_msg->write_config("nlist.pad",lexical_cast<string>(m_pad));
+    // Named lists write their configuration under their own key, so that they do not overwrite that of the global list
+    string cfg = (name == "") ? "nlist" : "nlist."+name;
+    m_msg->write_config(cfg+".cut",lexical_cast<string>(m_cut));
+    m_msg->write_config(cfg+".pad",lexical_cast<string>(m_pad));
+    if (param.find("cell_subdivision") != param.end())
+    {
+      m_cell_sub = lexical_cast<int>(param["cell_subdivision"]);
+      if (m_cell_sub < 1)
+      {
+        m_msg->msg(Messenger::ERROR,"Neighbour list. Cell subdivision has to be a positive integer.");
+        throw runtime_error("Non-positive cell subdivision.");
+      }
+      m_msg->msg(Messenger::INFO,"Neighbour list. Each cell will be "+param["cell_subdivision"]+" times smaller than the cutoff distance.");
+      m_msg->write_config(cfg+".cell_subdivision",param["cell_subdivision"]);
+    }
+    if (m_parent)
+    {
+      if (cutoff + pad > m_parent->get_cutoff() + m_parent->get_pad())
+      {
+        m_msg->msg(Messenger::ERROR,"Neighbour list. Cutoff plus padding distance ("+lexical_cast<string>(cutoff+pad)+") has to be smaller than that of the parent list ("+lexical_cast<string>(m_parent->get_cutoff() + m_parent->get_pad())+").");
+        throw runtime_error("Neighbour list cutoff larger than the cutoff of its parent.");
+      }
+      m_use_cell_list = false;
+      m_msg->msg(Messenger::INFO,"Neighbour list will be built by filtering its parent list.");
+      m_msg->write_config(cfg+".build_type","parent");
+    }
     // Check if box is large enough for cell list
-    if (m_system->get_box()->Lx > 2.0*(cutoff+pad) && m_system->get_box()->Ly > 2.0*(cutoff+pad) && m_system->get_box()->Lz > 2.0*(cutoff+pad))
+    else if (this->cell_list_fits(cutoff+pad))
     {
       m_use_cell_list = true;
-      m_cell_list = shared_ptr<CellList>(new CellList(m_system,m_msg,cutoff+pad));
+      m_cell_list = shared_ptr<CellList>(new CellList(m_system,m_msg,(cutoff+pad)/m_cell_sub));
       m_msg->msg(Messenger::INFO,"Using cell lists for neighbour list builds.");
-      m_msg->write_config("nlist.build_type","cell");
+      m_msg->write_config(cfg+".build_type","cell");
     }
     else
     {
       m_use_cell_list = false;
       m_msg->msg(Messenger::INFO,"Box dimensions are too small to be able to use cell lists. Neighbour list will be built using N^2 algorithm.");
-      m_msg->write_config("nlist.build_type","n_square");
+      m_msg->write_config(cfg+".build_type","n_square");
     }
     if (param.find("triangulation") != param.end())
     {
@@ -157,62 +226,125 @@ public:
       }
       m_triangulation = true;
       m_msg->msg(Messenger::INFO,"Faces will be build using Delaunay triangulation.");
-      m_msg->write_config("nlist.triangulation","true"); 
+      m_msg->write_config(cfg+".triangulation","true"); 
+      if (param.find("incremental_mesh") != param.end())
+      {
+        m_incremental_mesh = true;
+        m_msg->msg(Messenger::INFO,"Neighbour list. Mesh will be maintained by edge flips between rebuilds. It will be retriangulated only if particles are added or removed or if the boundary needs fixing.");
+        m_msg->write_config(cfg+".incremental_mesh","true");
+      }
     }
     if (param.find("max_perimeter") == param.end())
     {
       m_msg->msg(Messenger::WARNING,"Neighbour list. No maximum face perimeter set. Assuming default value of 20.");
-      m_msg->write_config("nlist.max_perimeter","20.0");
+      m_msg->write_config(cfg+".max_perimeter","20.0");
       m_max_perim = 20.0;
     }
     else    
     {
       m_msg->msg(Messenger::INFO,"Neighbour list.  Setting maximum face perimeter to "+param["max_perimeter"]+".");
-      m_msg->write_config("nlist.max_perimeter",param["max_perimeter"]);
+      m_msg->write_config(cfg+".max_perimeter",param["max_perimeter"]);
       m_max_perim =  lexical_cast<double>(param["max_perimeter"]);
     }
     if (param.find("circumcenter") != param.end())
     {
       m_msg->msg(Messenger::WARNING,"Neighbour list. Using circumcenters for mesh dual.");
-      m_msg->write_config("nlist.circumcenter","true");
+      m_msg->write_config(cfg+".circumcenter","true");
       m_circumcenter = true;
     }
     else    
     {
       m_msg->msg(Messenger::INFO,"Neighbour list. Using geometric centers for mesh dual.");
-      m_msg->write_config("nlist.circumcenter","false");
+      m_msg->write_config(cfg+".circumcenter","false");
       m_circumcenter = false;
     }
     if (param.find("disable_nlist") != param.end())
     {
       m_msg->msg(Messenger::WARNING,"Neighbour list will not be built. This should be used in pair with triangulations when particle connections are build based on tringulations.");
-      m_msg->write_config("nlist.disable_nlist","true");
+      m_msg->write_config(cfg+".disable_nlist","true");
       m_disable_nlist = true;
     }
     if (param.find("keep_detached") != param.end())
     {
       m_msg->msg(Messenger::WARNING,"Neighbour list. Particles detached from the mesh (tissue) will be kept.");
-      m_msg->write_config("nlist.remove_detached","false");
+      m_msg->write_config(cfg+".remove_detached","false");
       m_remove_detached = false;
     }
     if (param.find("max_iter") != param.end())
     {
       m_msg->msg(Messenger::INFO,"Neighbour list. Setting maximum number of iterations for boundary builds in tissue simulations to "+param["max_iter"]+".");
-      m_msg->write_config("nlist.max_iter",param["max_iter"]);
+      m_msg->write_config(cfg+".max_iter",param["max_iter"]);
       m_system->set_max_mesh_iterations(lexical_cast<int>(param["max_iter"]));
     }
     if (param.find("boundary_type") != param.end())
     {
       m_msg->msg(Messenger::INFO,"Neighbour list. Setting type of boundary particles in tissue simulations to "+param["boundary_type"]+".");
-      m_msg->write_config("nlist.boundary_type",param["boundary_type"]);
+      m_msg->write_config(cfg+".boundary_type",param["boundary_type"]);
       m_system->set_boundary_type(lexical_cast<int>(param["boundary_type"]));
     }
     if (param.find("static_boundary") != param.end())
     {
       m_msg->msg(Messenger::INFO,"Neighbour list. Using static boundaries in the tissue simulation.");
-      m_msg->write_config("nlist.static_boundary","true");
+      m_msg->write_config(cfg+".static_boundary","true");
       m_static_boundary = true;
     }
+    if (param.find("type_cutoff") != param.end())
+    {
+      m_msg->msg(Messenger::INFO,"Neighbour list. Using separate cutoff distance for each pair of particle types.");
+      m_msg->write_config(cfg+".type_cutoff","true");
+      m_use_type_cut = true;
+    }
+    if (param.find("radius_cutoff") != param.end())
+    {
+      m_msg->msg(Messenger::INFO,"Neighbour list. Build cutoff for each pair of particles will be set to "+param["radius_cutoff"]+" times the sum of their radii.");
+      m_msg->write_config(cfg+".radius_cutoff",param["radius_cutoff"]);
+      m_radius_cut = lexical_cast<double>(param["radius_cutoff"]);
+      if (m_radius_cut <= 0.0)
+      {
+        m_msg->msg(Messenger::ERROR,"Neighbour list. Radius cutoff has to be positive.");
+        throw runtime_error("Non-positive radius cutoff.");
+      }
+      if (param.find("use_length") != param.end())
+      {
+        m_msg->msg(Messenger::INFO,"Neighbour list. Half of the rod length will be added to particle radius.");
+        m_msg->write_config(cfg+".use_length","true");
+        m_use_length = true;
+      }
+      if (param.find("poly_ratio") != param.end())
+        m_poly_ratio = lexical_cast<double>(param["poly_ratio"]);
+      m_msg->msg(Messenger::INFO,"Neighbour list. Hierarchical cell lists will be used if the ratio of the largest and the smallest particle radius exceeds "+lexical_cast<string>(m_poly_ratio)+".");
+      m_msg->write_config(cfg+".poly_ratio",lexical_cast<string>(m_poly_ratio));
+    }
+    if (param.find("auto_pad") != param.end())
+    {
+      m_auto_pad = true;
+      m_pad_min = (param.find("pad_min") == param.end()) ? 0.25*m_pad : lexical_cast<double>(param["pad_min"]);
+      m_pad_max = (param.find("pad_max") == param.end()) ? 4.0*m_pad : lexical_cast<double>(param["pad_max"]);
+      m_tune_window = (param.find("tune_window") == param.end()) ? 500 : lexical_cast<int>(param["tune_window"]);
+      m_tune_hold = (param.find("tune_hold") == param.end()) ? 20 : lexical_cast<int>(param["tune_hold"]);
+      if (m_pad_min <= 0.0 || m_pad_max < m_pad_min || m_tune_window < 1)
+      {
+        m_msg->msg(Messenger::ERROR,"Neighbour list. Auto-tuning requires 0 < pad_min <= pad_max and positive tune_window.");
+        throw runtime_error("Wrong neighbour list auto-tuning parameters.");
+      }
+      m_pad = std::min(std::max(m_pad, m_pad_min), m_pad_max);
+      m_msg->msg(Messenger::INFO,"Neighbour list. Padding distance and cell size will be tuned every "+lexical_cast<string>(m_tune_window)+" steps. Padding distance will be kept between "+lexical_cast<string>(m_pad_min)+" and "+lexical_cast<string>(m_pad_max)+".");
+      m_msg->write_config(cfg+".auto_pad.pad_min",lexical_cast<string>(m_pad_min));
+      m_msg->write_config(cfg+".auto_pad.pad_max",lexical_cast<string>(m_pad_max));
+      m_msg->write_config(cfg+".auto_pad.tune_window",lexical_cast<string>(m_tune_window));
+      m_msg->write_config(cfg+".auto_pad.tune_hold",lexical_cast<string>(m_tune_hold));
+      m_tune_steps = 0;
+      m_tune_time = 0.0;
+      m_tune_build_time = 0.0;
+      m_tune_builds = 0;
+      m_tune_state = TUNE_START;
+      m_pad_factor = 1.25;
+      m_pad_dir = 1;
+      m_best_pad = m_pad;
+      m_best_cell_sub = m_cell_sub;
+      m_best_cost = 0.0;
+      m_hold = 0;
+    }
     this->build();
   }
   
@@ -231,6 +363,9 @@ public:
   //! Returns true is faces list exists
   bool has_faces() { return m_triangulation; }
   
+  //! Returns true if mesh is retriangulated only when its topology is no longer valid
+  bool has_incremental_mesh() { return m_incremental_mesh; }
+  
   //! Get neighbour list for a give particle
   //! \param id Particle id
   //! \return Reference to the particle's neighbour list
@@ -247,32 +382,63 @@ public:
   //! Get neighbour list cutoff distance
   double get_cutoff() { return m_cut;  }  //!< \return neighbour list cutoff distance
   
+  //! Get neighbour list padding distance
+  double get_pad() { return m_pad;  }  //!< \return neighbour list padding distance
+  
+  //! Largest squared displacement of any particle since the last build
+  double max_displacement_sq();
+  
+  //! Register a function that reports cutoff distances of an interaction that uses this list
+  //! \param name unique name of the interaction (replaces function previously registered under the same name)
+  //! \param f function that returns cutoff distance for a pair of types (0 if not known)
+  void add_cutoff_provider(const string& name, CutoffFunction f) { m_cutoff_providers[name] = f; }
+  
+  //! Remove cutoff function of an interaction (e.g., when the interaction is replaced or destroyed)
+  //! \param name unique name of the interaction
+  void remove_cutoff_provider(const string& name) { m_cutoff_providers.erase(name); }
+  
+  //! Get current skin, i.e. how much padding is left after affine updates since the last build
+  double get_skin() { return m_skin;  }  //!< \return current skin
+  
+  //! Get wall clock time (in seconds) spent in list and mesh builds since the last reset
+  double get_build_time() { return m_build_time; }
+  
+  //! Reset build timer (called at the beginning of each run)
+  void reset_build_time() { m_build_time = 0.0; }
+  
   //! Rescales neigbour list cutoff
   //! \param scale scale factor
+  //! \note If the increase of the cutoff fits within the skin, list is kept and only the skin is reduced
   void rescale_cutoff(double scale)
   {
+    double skin = m_skin - (scale - 1.0)*m_cut;
     m_cut *= scale;
-    if (m_use_cell_list && m_system->get_box()->Lx > 2.0*(m_cut+m_pad) && m_system->get_box()->Ly > 2.0*(m_cut+m_pad) && m_system->get_box()->Lz > 2.0*(m_cut+m_pad))
+    m_msg->msg(Messenger::INFO,"Rescaling neighbour list cutoff.");
+    this->reset_cell_list();
+    if (skin > 0.0 && this->can_keep_list())
     {
-      m_cell_list = shared_ptr<CellList>(new CellList(m_system,m_msg,m_cut+m_pad));
-      m_msg->msg(Messenger::INFO,"Rescaling neighbour list cutoff.");
-      m_msg->msg(Messenger::INFO,"Still using cell lists for neighbour list builds.");
+      m_skin = skin;
+      this->update_coordination();
     }
     else
-    {
-      m_use_cell_list = false;
-      m_msg->msg(Messenger::INFO,"Rescaling neighbour list cutoff.");
-      m_msg->msg(Messenger::INFO,"No longer possible to use cell lists for neighbour list builds.");
-    }
-    this->build();
+      this->build();
   }
   
+  //! Update list after all particle positions have been uniformly scaled
+  bool affine_rescale(double);
+  
+  //! Record duration of a time step (used for auto-tuning of padding distance and cell size)
+  void tune(double);
+  
   
   //! Build neighbour list
   void build();
   
   // Does actual contact and face building 
   void build_mesh();
+  
+  //! Rebuild mesh only if it cannot be maintained incrementally 
+  void refresh_mesh();
     
   
 private:
@@ -284,18 +450,136 @@ private:
   vector<PartPos> m_old_state;     //!< Coordinates of particles right after the build
   double m_cut;                    //!< List build cutoff distance 
   double m_pad;                    //!< Padding distance (m_cut should be set to potential cutoff + m_pad)
+  double m_skin;                   //!< Padding left after affine updates since the last build (equal to m_pad right after the build)
   bool m_use_cell_list;            //!< If true, use cell list to speed up neighbour list builds
   bool m_triangulation;            //!< If true, build Delaunay triangulation for faces
+  bool m_incremental_mesh;         //!< If true, retriangulate only when mesh topology is no longer valid (otherwise on every build)
   double m_max_perim;              //!< Maximum value of the perimeter beyond which face becomes a hole.
   bool m_circumcenter;             //!< If true, use cell circumcenters when computing duals. 
   bool m_disable_nlist;            //!< If true, neigbour list is not built (only used for cell simulations)
   bool m_remove_detached;          //!< If true, remove detached particles (vertices) before rebuilding neighbour list (for cell simulations)
   bool m_static_boundary;          //!< If true, treat tissue boundary as static, i.e., do not add new boundary particles 
   vector<vector<int> >  m_contact_list;    //!< Holds the contact list for each particle
+  bool m_use_type_cut;                       //!< If true, use separate build cutoff for each pair of particle types
+  map<string, CutoffFunction> m_cutoff_providers; //!< Functions that report cutoff distances of all interactions using the list
+  vector<vector<double> > m_type_cut_sq;     //!< Squared build cutoff (including padding) for each pair of types
+  vector<double> m_type_max_cut_sq;          //!< Largest squared build cutoff for each type
+  shared_ptr<NeighbourList> m_parent;        //!< Parent list (if set, this list is built by filtering the parent)
+  double m_radius_cut;                       //!< If positive, pair build cutoff is m_radius_cut times the sum of particle radii (plus padding)
+  bool m_use_length;                         //!< If true, half of the rod length is added to the particle radius
+  double m_poly_ratio;                       //!< Use hierarchical cell lists if ratio of largest and smallest radius exceeds this value
+  bool m_use_levels;                         //!< If true, last build used hierarchical cell lists
+  double m_reach_max;                        //!< Largest particle radius (including half length if m_use_length) at the last build
+  vector<CellListPtr> m_level_cells;         //!< Cell list for each size level (hierarchical builds)
+  vector<double> m_level_width;              //!< Requested cell width for each size level (hierarchical builds)
+  vector<int> m_stencil;                     //!< Cells to scan for a particle (if cells are subdivided)
+  int m_cell_sub;                            //!< Cell subdivision factor (cell width is cutoff divided by this number)
+  
+  //! States of the padding distance and cell size auto-tuner
+  enum TUNE_STATE { TUNE_START, TUNE_PAD, TUNE_CELL, TUNE_HOLD };
+  
+  bool m_auto_pad;                           //!< If true, tune padding distance and cell subdivision at runtime
+  double m_pad_min;                          //!< Smallest padding distance allowed during tuning
+  double m_pad_max;                          //!< Largest padding distance allowed during tuning
+  int m_tune_window;                         //!< Number of steps over which cost of each setting is measured
+  int m_tune_hold;                           //!< Number of windows to keep tuned values before tuning again
+  int m_tune_steps;                          //!< Number of steps measured in the current window
+  double m_tune_time;                        //!< Total time of all steps in the current window
+  double m_tune_build_time;                  //!< Total time spent in list builds in the current window
+  int m_tune_builds;                         //!< Number of list builds in the current window
+  TUNE_STATE m_tune_state;                   //!< Current state of the auto-tuner
+  double m_pad_factor;                       //!< Multiplicative step for padding distance trials
+  int m_pad_dir;                             //!< Direction of the padding distance trial (+1 larger, -1 smaller)
+  double m_best_pad;                         //!< Padding distance with the lowest measured cost
+  int m_best_cell_sub;                       //!< Cell subdivision with the lowest measured cost
+  double m_best_cost;                        //!< Lowest measured time per step
+  int m_hold;                                //!< Number of windows left before tuning again
+  
+  double m_build_time;                       //!< Total time spent in list builds (used for benchmarking)
+  
+  //! Change padding distance and cell subdivision (used by the auto-tuner)
+  void apply_tuning(double, int);
+  vector<vector<int> > m_level_particles;    //!< Particles in each size level (hierarchical builds)
+  
+  //! Recompute build cutoffs for all pairs of types
+  void update_type_cutoffs();
+  
+  //! Check if list topology can be kept when cutoff or positions change (otherwise, the list is rebuilt)
+  //! \note Coordination of excluded pairs can only be obtained in a full build
+  bool can_keep_list()
+  {
+    return (!m_disable_nlist && !m_triangulation && !m_system->has_exclusions() && m_old_state.size() == static_cast<unsigned int>(m_system->size()));
+  }
+  
+  //! Recount particle coordination using pairs in the list
+  void update_coordination();
+  
+  //! Adjust cell list after a change of cutoff, padding distance, cell subdivision or box size
+  void reset_cell_list()
+  {
+    if (m_parent)
+      return;
+    if (m_use_cell_list && this->cell_list_fits(m_cut+m_pad))
+    {
+      m_cell_list->resize((m_cut+m_pad)/m_cell_sub);
+      m_msg->msg(Messenger::INFO,"Still using cell lists for neighbour list builds.");
+    }
+    else
+    {
+      m_use_cell_list = false;
+      m_msg->msg(Messenger::INFO,"No longer possible to use cell lists for neighbour list builds.");
+    }
+    m_level_cells.clear();
+  }
+  
+  //! Squared build cutoff for a pair of particle types
+  //! \param type_1 type of the first particle
+  //! \param type_2 type of the second particle
+  //! \param cut_sq global squared build cutoff (returned for types not covered by the table)
+  double type_cut_sq(int type_1, int type_2, double cut_sq)
+  {
+    unsigned int t1 = type_1 - 1, t2 = type_2 - 1;
+    if (t1 < m_type_cut_sq.size() && t2 < m_type_cut_sq.size())
+      return m_type_cut_sq[t1][t2];
+    return cut_sq;
+  }
+  
+  //! Particle size used for radius based cutoffs
+  //! \param p particle
+  double reach(const Particle& p)
+  {
+    return m_use_length ? p.get_radius() + 0.5*p.get_length() : p.get_radius();
+  }
+  
+  //! Squared build cutoff for a pair of particles (including padding)
+  //! \param pi first particle
+  //! \param pj second particle
+  double pair_cut_sq(const Particle& pi, const Particle& pj)
+  {
+    double cut = m_cut + m_pad;
+    double cut_sq = m_use_type_cut ? this->type_cut_sq(pi.get_type(), pj.get_type(), cut*cut) : cut*cut;
+    if (m_radius_cut > 0.0)
+    {
+      double rc = m_radius_cut*(this->reach(pi) + this->reach(pj)) + m_pad;
+      cut_sq = std::min(cut_sq, rc*rc);
+    }
+    return cut_sq;
+  }
     
+  //! Check if the box is large enough to use cell lists with a given cell size
+  //! \param cut cell size (cutoff + padding)
+  //! \note In planar systems box size in the z direction is irrelevant
+  bool cell_list_fits(double cut)
+  {
+    BoxPtr box = m_system->get_box();
+    return (box->Lx > 2.0*cut && box->Ly > 2.0*cut && (box->planar || box->Lz > 2.0*cut));
+  }
+  
   // Actual neighbour list builds
   void build_nsq(int);    //!< Build with N^2 algorithm
   void build_cell();      //!< Build using cells list
+  void build_parent();    //!< Build by filtering the parent list
+  void build_levels();    //!< Build using hierarchical (size binned) cell lists
   
    //! Build faces
   void build_faces(bool);
@@ -305,6 +589,9 @@ private:
   
   // Remove detached particles
   void remove_detached();
+  
+  // Copy contacts from the mesh (which changes by edge flips between full triangulations)
+  bool contacts_from_mesh();
  
   
 #ifdef HAS_CGAL
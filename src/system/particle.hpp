@@ -74,6 +74,8 @@ public:
     fx = 0.0; fy = 0.0; fz = 0.0; 
     tau_x = 0.0; tau_y = 0.0; tau_z = 0.0;
     Nx = 0.0; Ny = 0.0; Nz = 0.0;
+    N_rx = 0.0; N_ry = 0.0; N_rz = 0.0;
+    m_normal_valid = false;  // normal has not been computed yet
     s_xx = 0.0; s_xy = 0.0; s_xz = 0.0;
     s_yx = 0.0; s_yy = 0.0; s_yz = 0.0;
     s_zx = 0.0; s_zy = 0.0; s_zz = 0.0;
@@ -253,6 +255,26 @@ public:
   //! Get the entire force type data structure
   map<string,ForceType>& get_force_type() { return m_force_type; }
   
+  //! Store normal to the constraint and remember the position at which it was computed
+  //! \param nx x component of the normal
+  //! \param ny y component of the normal
+  //! \param nz z component of the normal
+  void set_normal(double nx, double ny, double nz)
+  {
+    Nx = nx;  Ny = ny;  Nz = nz;
+    N_rx = x; N_ry = y; N_rz = z;
+    m_normal_valid = true;
+  }
+  
+  //! Mark the stored normal as stale (e.g., when the constraint surface itself changes)
+  void invalidate_normal() { m_normal_valid = false; }
+  
+  //! Returns true if the stored normal has been set and computed at the current particle position
+  //! \note Positions are public and assigned directly, so a move is detected by comparing
+  //! against the position stored in set_normal(). Validity of the normal is tracked by an 
+  //! explicit flag and not by a NaN position, since NaN comparisons are not reliable with -ffast-math.
+  bool normal_valid() const { return (m_normal_valid && x == N_rx && y == N_ry && z == N_rz); }
+  
   ///@{
   double x, y, z;              //!< Position in the embedding 3d flat space
   //@}
@@ -275,6 +297,9 @@ public:
   double Nx, Ny, Nz;           //!< Normal to the contraint, used for mesh orientation in tissues.
   //@}
   ///@{
+  double N_rx, N_ry, N_rz;     //!< Position at which the normal (Nx,Ny,Nz) was computed
+  //@}
+  ///@{
   double s_xx, s_xy, s_xz, s_yx, s_yy, s_yz, s_zx, s_zy, s_zz;   //!< Components of the stress tensor
   //@}
   double omega;                //!< Magnitude of the angular velocity (in the direction of the normal to the surface)
@@ -299,6 +324,7 @@ private:  // Make these attributes immutable
   int m_parent;            //!< Flag of the parent who gave birth to this particle; -1 if particle was 1st generation 
   int m_type;              //!< Particle type
   double m_r;              //!< Particle radius 
+  bool m_normal_valid;     //!< True if the normal (Nx,Ny,Nz) has been set by set_normal() and not invalidated since
   double m_l;              //!< Length (if particle is actually a rod)
   double m_A0;             //!< Default native area. This one is set for the cell type and does not grow. 
   map<string,double> m_pot_eng;   //!< Holds current value of the potential energy of a given type 
@@ -66,6 +66,10 @@ System::System(const string& input_filename, MessengerPtr msg, BoxPtr box) : m_m
                                                                              m_mesh(Mesh()),
                                                                              m_periodic(false),
                                                                              m_force_nlist_rebuild(false),
+                                                                             m_force_mesh_rebuild(true),
+                                                                             m_cell_stats_generation(0),
+                                                                             m_avg_area(0.0),
+                                                                             m_avg_perim(0.0),
                                                                              m_nlist_rescale(1.0),
                                                                              m_current_particle_flag(0),
                                                                              m_dt(0.0),
@@ -588,6 +592,7 @@ void System::add_particle(Particle& p)
     m_molecules.push_back(vector<int>(1,p.get_id()));
   // We need to force neighbour list rebuild
   m_force_nlist_rebuild = true;
+  m_force_mesh_rebuild = true;
   m_current_particle_flag++;
 }
 
@@ -596,72 +601,150 @@ void System::add_particle(Particle& p)
  */ 
 void System::remove_particle(int id)
 {
-  Mesh& mesh = this->get_mesh();
-  Particle& pi = m_particles[id];
-  int mol_id = pi.molecule;
-  if (pi.boundary)
+  this->remove_particles(vector<int>(1,id));
+}
+
+/*! Remove a set of particles from the system. All removed particles are 
+ *  marked first and the particles, molecules, groups, bonds, angles, exclusions and boundary 
+ *  information are compacted in a single pass, i.e. the cost is linear in the system size 
+ *  regardless of the number of removed particles.
+ *  \param ids Ids of particles to remove (in any order)
+ *  \return map between old and new particle ids (-1 for removed particles)
+ */ 
+vector<int> System::remove_particles(const vector<int>& ids)
+{
+  int N = m_particles.size();
+  vector<int> new_id(N, 0);
+  for (unsigned int r = 0; r < ids.size(); r++)
   {
-    Particle& pj = m_particles[pi.boundary_neigh[0]];
-    Particle& pk = m_particles[pi.boundary_neigh[1]];
-    pj.boundary_neigh[(pj.boundary_neigh[0] == id) ? 0 : 1] = pk.get_id();
-    pk.boundary_neigh[(pk.boundary_neigh[0] == id) ? 0 : 1] = pj.get_id();  
-    // Vertex vi = mesh.get_vertices()[id];
-    // if (vi.neigh.size() > 0)
-    // {
-    //   //if (!(vi.neigh[0] == pj.get_id() || vi.neigh[0] == pk.get_id()))
-    //   //  throw runtime_error("Particle removal. Something is wrong with the ordering of one of the boundary vertices.");
-    //   int first_neigh = vi.neigh[0] == pj.get_id() ? pj.get_id() : pk.get_id();
-    //   int last_neigh  = vi.neigh[0] == pj.get_id() ? pk.get_id() : pj.get_id();
-    //   m_particles[first_neigh].boundary_neigh[m_particles[first_neigh].boundary_neigh[0] == id ? 0 : 1] = vi.neigh[1];
-    //   for (int i = 1; i < vi.neigh.size() - 1; i++)
-    //   {
-    //     m_particles[vi.neigh[i]].boundary = true;
-    //     m_particles[vi.neigh[i]].boundary_neigh[0] = vi.neigh[i - 1];
-    //     m_particles[vi.neigh[i]].boundary_neigh[1] = vi.neigh[i + 1];
-    //   }
-    //   m_particles[last_neigh].boundary_neigh[m_particles[last_neigh].boundary_neigh[0] == id ? 0 : 1] = vi.neigh[vi.neigh.size()-1];
-    // }
-    // else
-    // {
-    //   pj.boundary_neigh[(pj.boundary_neigh[0] == id) ? 0 : 1] = pk.get_id();
-    //   pk.boundary_neigh[(pk.boundary_neigh[0] == id) ? 0 : 1] = pj.get_id();  
-    // }
+    int id = ids[r];
+    if (new_id[id] < 0) continue;
+    new_id[id] = -1;
+    Particle& pi = m_particles[id];
+    // Close the boundary around removed particle
+    if (pi.boundary)
+    {
+      Particle& pj = m_particles[pi.boundary_neigh[0]];
+      Particle& pk = m_particles[pi.boundary_neigh[1]];
+      pj.boundary_neigh[(pj.boundary_neigh[0] == id) ? 0 : 1] = pk.get_id();
+      pk.boundary_neigh[(pk.boundary_neigh[0] == id) ? 0 : 1] = pj.get_id();  
+    }
   }
-  vector<int>::iterator it_m = find(m_molecules[mol_id].begin(), m_molecules[mol_id].end(),id);
-  m_molecules[mol_id].erase(it_m);
-  if (m_molecules[mol_id].size() == 0)
-    m_molecules.erase(m_molecules.begin() + mol_id);
-  m_particles.erase(m_particles.begin() + id);
-  // Shift down all ids
-  for (unsigned int i = 0; i < m_particles.size(); i++)
+  int n = 0;
+  for (int i = 0; i < N; i++)
+    if (new_id[i] == 0)
+      new_id[i] = n++;
+  
+  // Remove particles from molecules and drop empty molecules
+  vector<int> new_mol(m_molecules.size(), -1);
+  int n_mol = 0;
+  for (unsigned int m = 0; m < m_molecules.size(); m++)
   {
-    Particle& p = m_particles[i];
-    if (p.get_id() > id)
-      p.set_id(p.get_id() - 1);
-    if (p.molecule > mol_id)
-      p.molecule--;
-    if (p.boundary)
+    vector<int>& mol = m_molecules[m];
+    unsigned int k = 0;
+    for (unsigned int j = 0; j < mol.size(); j++)
+      if (new_id[mol[j]] >= 0)
+        mol[k++] = new_id[mol[j]];
+    mol.resize(k);
+    if (k > 0)
     {
-      if (p.boundary_neigh[0] > id) p.boundary_neigh[0]--;
-      if (p.boundary_neigh[1] > id) p.boundary_neigh[1]--;
+      if (n_mol != static_cast<int>(m)) m_molecules[n_mol].swap(mol);
+      new_mol[m] = n_mol++;
     }
   }
-  for (unsigned int i = 0; i < m_molecules.size(); i++)
+  m_molecules.resize(n_mol);
+  
+  // Compact particles
+  for (int i = 0; i < N; i++)
   {
-    for (unsigned int j = 0; j < m_molecules[i].size(); j++)
-      if (m_molecules[i][j] > mol_id) 
-       m_molecules[i][j]--; 
+    if (new_id[i] < 0) continue;
+    if (new_id[i] != i) m_particles[new_id[i]] = m_particles[i];
+    Particle& p = m_particles[new_id[i]];
+    p.set_id(new_id[i]);
+    p.molecule = new_mol[p.molecule];
+    if (p.boundary)
+    {
+      p.boundary_neigh[0] = new_id[p.boundary_neigh[0]];
+      p.boundary_neigh[1] = new_id[p.boundary_neigh[1]];
+    }
   }
+  m_particles.erase(m_particles.begin() + n, m_particles.end());
+  
   // Update all groups
   for(map<string, GroupPtr>::iterator it_g = m_group.begin(); it_g != m_group.end(); it_g++)
-    (*it_g).second->shift(id);
+    (*it_g).second->remap(new_id);
   
-  vector<int>::iterator it = find(m_boundary.begin(), m_boundary.end(),id);
-  if (it != m_boundary.end()) m_boundary.erase(it);
+  unsigned int k = 0;
   for (unsigned int i = 0; i < m_boundary.size(); i++)  
-    if (m_boundary[i] > id) m_boundary[i]--;
+    if (new_id[m_boundary[i]] >= 0)
+      m_boundary[k++] = new_id[m_boundary[i]];
+  m_boundary.resize(k);
+  
+  // Bonds and angles that contain removed particles are removed as well
+  vector<int> new_bond(m_bonds.size(), -1);
+  k = 0;
+  for (unsigned int b = 0; b < m_bonds.size(); b++)
+  {
+    Bond& bond = m_bonds[b];
+    if (new_id[bond.i] >= 0 && new_id[bond.j] >= 0)
+    {
+      new_bond[b] = k;
+      Bond& nb = m_bonds[k];
+      nb = bond;
+      nb.id = k++;
+      nb.i = new_id[nb.i];  nb.j = new_id[nb.j];
+    }
+  }
+  m_bonds.resize(k, Bond(0,0,0,0));
+  vector<int> new_angle(m_angles.size(), -1);
+  k = 0;
+  for (unsigned int a = 0; a < m_angles.size(); a++)
+  {
+    Angle& angle = m_angles[a];
+    if (new_id[angle.i] >= 0 && new_id[angle.j] >= 0 && new_id[angle.k] >= 0)
+    {
+      new_angle[a] = k;
+      Angle& na = m_angles[k];
+      na = angle;
+      na.id = k++;
+      na.i = new_id[na.i];  na.j = new_id[na.j];  na.k = new_id[na.k];
+    }
+  }
+  m_angles.resize(k, Angle(0,0,0,0,0));
+  // Particles keep lists of bond and angle ids, which have to follow the compaction above
+  for (int i = 0; i < n; i++)
+  {
+    Particle& p = m_particles[i];
+    unsigned int l = 0;
+    for (unsigned int j = 0; j < p.bonds.size(); j++)
+      if (new_bond[p.bonds[j]] >= 0)
+        p.bonds[l++] = new_bond[p.bonds[j]];
+    p.bonds.resize(l);
+    l = 0;
+    for (unsigned int j = 0; j < p.angles.size(); j++)
+      if (new_angle[p.angles[j]] >= 0)
+        p.angles[l++] = new_angle[p.angles[j]];
+    p.angles.resize(l);
+  }
+  if (static_cast<int>(m_exclusions.size()) == N)
+  {
+    for (int i = 0; i < N; i++)
+    {
+      if (new_id[i] < 0) continue;
+      vector<int>& excl = m_exclusions[i];
+      unsigned int l = 0;
+      for (unsigned int j = 0; j < excl.size(); j++)
+        if (new_id[excl[j]] >= 0)
+          excl[l++] = new_id[excl[j]];
+      excl.resize(l);
+      if (new_id[i] != i) m_exclusions[new_id[i]].swap(excl);
+    }
+    m_exclusions.resize(n);
+  }
   
   m_force_nlist_rebuild = true;
+  m_force_mesh_rebuild = true;
+  return new_id;
 }
 
 /*! Change group of the particle
@@ -709,7 +792,7 @@ void System::zero_cm_momentum(const string& group)
   }
   
   int N = m_group[group]->get_size();
-  vector<int> particles = m_group[group]->get_particles();
+  vector<int>& particles = m_group[group]->get_particles();
   double vcm_x = 0.0, vcm_y = 0.0, vcm_z = 0.0;
   double tau_cm_x = 0.0, tau_cm_y = 0.0, tau_cm_z = 0.0;
   N = this->size();
@@ -1036,44 +1119,41 @@ void System::compute_tangent(int i, double& tx, double& ty, double& tz)
 //! Compute system area by adding up areas of all cells (makes sense only for cell systems)
 double System::compute_area()
 {
-  Mesh& mesh = this->get_mesh();
-  double area = 0.0;
-  int num = 0;
-  for (int i = 0; i < mesh.size(); i++)
-  {
-    Vertex& V = mesh.get_vertices()[i];
-    if (!V.boundary && V.attached)
-    {
-      area += V.area;
-      num++;
-    }
-  }
-  if (num > 0)
-    return area/num;
-  else
-    return 0.0;
+  this->update_cell_stats();
+  return m_avg_area;
 }
 
 //! Compute average perimeter of cells in a cell system
 double System::compute_average_perimeter()
+{
+  this->update_cell_stats();
+  return m_avg_perim;
+}
+
+/*! Average area and perimeter of all internal cells are computed in a single 
+ *  pass over the cached dual areas and perimeters and are recomputed only 
+ *  if the mesh dual generation changed since the last call.
+*/
+void System::update_cell_stats()
 {
   Mesh& mesh = this->get_mesh();
-  double  perim = 0.0;
-  int N = mesh.size();
+  if (m_cell_stats_generation == mesh.get_dual_generation())
+    return;
+  double area = 0.0, perim = 0.0;
   int num = 0;
-  for (int i = 0; i < N; i++)
+  for (int i = 0; i < mesh.size(); i++)
   {
     Vertex& V = mesh.get_vertices()[i];
     if (!V.boundary && V.attached)
     {
+      area += V.area;
       perim += V.perim;
       num++;
     }
   }
-  if (N > 0)
-    return perim/num;
-  else
-    return 0.0;
+  m_avg_area = (num > 0) ? area/num : 0.0;
+  m_avg_perim = (num > 0) ? perim/num : 0.0;
+  m_cell_stats_generation = mesh.get_dual_generation();
 }
  
 //! Apply period boundary conditions on three coordinate
@@ -1098,7 +1178,7 @@ void System::apply_periodic(double& dx, double& dy, double& dz)
 bool System::group_ok(const string& group)
 {
   int N = m_group[group]->get_size();
-  vector<int> particles = m_group[group]->get_particles();
+  vector<int>& particles = m_group[group]->get_particles();
   for (int i = 0; i < N; i++)
   {
     int pi = particles[i];
@@ -1202,13 +1282,60 @@ void System::update_mesh()
       cout << "Exceeded maximum number of iterations in boundary build. Most likely something is wrong with input paramters. Results will not be reliable." << endl;
       throw runtime_error("Exceeded maximum number of iterations in boundary build.");
     }
-    for (int i = 0; i < m_mesh.size(); i++)
+    m_mesh.update_dual_cells();
+    m_mesh.invalidate_boundary_geometry();
+  }
+}
+
+/*! Compute vectors and distances along boundary edges and from boundary 
+ *  vertices to all their neighbours. This is done only once per force evaluation 
+ *  and shared by all potentials that act on the mesh boundary (line tension, 
+ *  boundary bending and boundary attraction). 
+ *  \note Cached geometry is invalidated by Potential::compute_nonbonded and whenever the mesh changes.
+*/
+BoundaryGeometry& System::get_boundary_geometry()
+{
+  BoundaryGeometry& geom = m_mesh.get_boundary_geometry();
+  if (geom.valid)
+    return geom;
+  vector<Edge>& edges = m_mesh.get_edges();
+  vector<Vertex>& vertices = m_mesh.get_vertices();
+  vector<int>& boundary_edges = m_mesh.get_boundary_edges();
+  vector<int>& boundary_vertices = m_mesh.get_boundary_vertices();
+  int n_edges = boundary_edges.size();
+  geom.edge_vec.resize(n_edges);
+  geom.edge_len.resize(n_edges);
+  for (int e = 0; e < n_edges; e++)
+  {
+    Edge& E = edges[boundary_edges[e]];
+    Particle& pi = m_particles[E.from];
+    Particle& pj = m_particles[E.to];
+    double dx = pj.x - pi.x, dy = pj.y - pi.y, dz = pj.z - pi.z;
+    this->apply_periodic(dx,dy,dz);
+    geom.edge_vec[e] = Vector3d(dx,dy,dz);
+    geom.edge_len[e] = sqrt(dx*dx + dy*dy + dz*dz);
+  }
+  int n_vert = boundary_vertices.size();
+  geom.star_start.resize(n_vert+1);
+  geom.star_vec.clear();    // keeps capacity, so no allocation once the boundary stops growing
+  geom.star_len.clear();
+  for (int v = 0; v < n_vert; v++)
+  {
+    Vertex& V = vertices[boundary_vertices[v]];
+    Particle& pi = m_particles[V.id];
+    geom.star_start[v] = geom.star_vec.size();
+    for (unsigned int j = 0; j < V.neigh.size(); j++)
     {
-      m_mesh.order_dual(i);
-      m_mesh.dual_perimeter(i);
-      m_mesh.dual_area(i); 
+      Particle& pj = m_particles[V.neigh[j]];
+      double dx = pj.x - pi.x, dy = pj.y - pi.y, dz = pj.z - pi.z;
+      this->apply_periodic(dx,dy,dz);
+      geom.star_vec.push_back(Vector3d(dx,dy,dz));
+      geom.star_len.push_back(sqrt(dx*dx + dy*dy + dz*dz));
     }
   }
+  geom.star_start[n_vert] = geom.star_vec.size();
+  geom.valid = true;
+  return geom;
 }
 
 //! Compute centre of mass for a molecule
@@ -185,7 +185,19 @@ public:
   
   //! Set the force_nlist_rebuild flag
   //! \param val new value of the flag
-  void set_force_nlist_rebuild(bool val) { m_force_nlist_rebuild = val; }
+  //! \note Forcing neighbour list rebuild also forces rebuild of the mesh
+  void set_force_nlist_rebuild(bool val) 
+  { 
+    m_force_nlist_rebuild = val; 
+    if (val) m_force_mesh_rebuild = true;
+  }
+  
+  //! Check if mesh has to be rebuilt from scratch (e.g., after particles were added or removed)
+  bool get_force_mesh_rebuild() { return m_force_mesh_rebuild; }
+  
+  //! Set the force_mesh_rebuild flag
+  //! \param val new value of the flag
+  void set_force_mesh_rebuild(bool val) { m_force_mesh_rebuild = val; }
   
   //! Generate a group of particles
   void make_group(const string, pairs_type&);
@@ -214,6 +226,9 @@ public:
   //! Remove particle from the system
   void remove_particle(int);
   
+  //! Remove a set of particles from the system in a single pass
+  vector<int> remove_particles(const vector<int>&);
+  
   //! Move particle from one group to the other
   void change_group(int, const string&, const string&);
     
@@ -264,6 +279,9 @@ public:
   //! Computes average perimeter of all cells
   double compute_average_perimeter();
   
+  //! Update cached average cell area and perimeter if the mesh duals changed
+  void update_cell_stats();
+  
   //! Apply period boundary conditions on a quantity 
   void apply_periodic(double&, double&, double&);
   
@@ -283,6 +301,9 @@ public:
   //! Update mesh information for tissue simulations
   void update_mesh();
   
+  //! Get geometry of the mesh boundary for the current particle positions
+  BoundaryGeometry& get_boundary_geometry();
+  
   //! Set the value of the integrator time step
   //! \param dt step size
   void set_integrator_step(double dt)  { m_dt = dt; }
@@ -340,6 +361,10 @@ private:
   bool m_compute_per_particle_eng;      //!< If true, compute per particle potential and alignment energy (we need to be able to turn it on and off since it is slow - STL map in the inner loop!)
   int m_num_groups;                     //!< Total number of groups in the system
   bool m_force_nlist_rebuild;           //!< Forced rebuilding of neighbour list
+  bool m_force_mesh_rebuild;            //!< Mesh topology is no longer valid and has to be rebuilt from scratch
+  unsigned long m_cell_stats_generation; //!< Mesh dual generation for which m_avg_area and m_avg_perim were computed
+  double m_avg_area;                    //!< Cached average cell area
+  double m_avg_perim;                   //!< Cached average cell perimeter
   double m_nlist_rescale;               //!< Rescale neighbour list cutoff by this much
   int m_n_types;                        //!< Number of different particle types (used to set pair parameters) 
   int m_n_bond_types;                   //!< Number of different bond types
@@ -0,0 +1,44 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+/*!
+ * \file alloc_counter.hpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Counting of heap allocations (used to check that the time step loop does not allocate memory)
+ */ 
+
+#ifndef __ALLOC_COUNTER_HPP__
+#define __ALLOC_COUNTER_HPP__
+
+/*! If the code is compiled with ALLOC_COUNT defined (CMake option ENABLE_ALLOC_COUNT), 
+ *  global operator new is replaced by a version that counts all heap allocations. 
+ *  Otherwise, no allocations are counted and alloc_count_enabled() returns false.
+*/
+
+//! Returns true if heap allocations are being counted
+bool alloc_count_enabled();
+
+//! Returns total number of heap allocations since the start of the program
+unsigned long heap_allocations();
+
+#endif
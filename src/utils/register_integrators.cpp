@@ -39,6 +39,8 @@ void register_integrators(IntegratorMap& integrators)
   integrators["vicsek"] = factory<IntegratorVicsekPtr>();
   // Register NVE integrator with the integrators class factory
   integrators["nve"] = factory<IntegratorNVEPtr>();
+  // Register multiple time step (RESPA) NVE integrator with the integrators class factory
+  integrators["respa"] = factory<IntegratorRESPAPtr>();
   // Register nematic integrator with the integrators class factory
   integrators["nematic"] = factory<IntegratorNematicPtr>();
   // Register actomyo integrator with the integrators class factory
@@ -53,6 +55,10 @@ void register_integrators(IntegratorMap& integrators)
   integrators["langevin"] = factory<IntegratorLangevinPtr>();
   // Register FIRE minimisaton integrator with the integrators class factory
   integrators["fire"] = factory<IntegratorFIREPtr>();
+  // Register conjugate gradient minimisaton integrator with the integrators class factory
+  integrators["cg"] = factory<IntegratorCGPtr>();
+  // Register L-BFGS minimisaton integrator with the integrators class factory
+  integrators["lbfgs"] = factory<IntegratorLBFGSPtr>();
   // Register Sepulveda minimisaton integrator with the integrators class factory
   integrators["sepulveda"] = factory<IntegratorSepulvedaPtr>();
 }
@@ -35,6 +35,12 @@ void register_pair_potentials(PairPotentialMap& pair_potentials)
   pair_potentials["lj"] = factory<PairLJPotentialPtr>();
   // Register Coulomb pair potential with the pair potentials class factory
   pair_potentials["coulomb"] = factory<PairCoulombPotentialPtr>();
+  // Register particle-mesh Ewald pair potential with the pair potentials class factory
+  pair_potentials["ewald"] = factory<PairEwaldPotentialPtr>();
+  // Register tree code (Coulomb/Yukawa) pair potential with the pair potentials class factory
+  pair_potentials["tree"] = factory<PairTreePotentialPtr>();
+  // Register tabulated pair potential with the pair potentials class factory
+  pair_potentials["table"] = factory<PairTablePotentialPtr>();
   // Register soft pair potential with the pair potentials class factory
   pair_potentials["soft"] = factory<PairSoftPotentialPtr>();
   // Register Gaussian pair potential with the pair potentials class factory
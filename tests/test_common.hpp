@@ -0,0 +1,164 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+
+/*!
+ * \file test_common.hpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Helpers shared by the unit tests
+ */ 
+
+#ifndef __TEST_COMMON_HPP__
+#define __TEST_COMMON_HPP__
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <memory>
+#include <random>
+
+#include "messenger.hpp"
+#include "box.hpp"
+#include "system.hpp"
+
+using std::string;
+using std::vector;
+using std::ofstream;
+using std::endl;
+
+static int test_failures = 0;   //!< Number of failed checks in the current test program
+
+//! Report a failed check and carry on with the test
+#define TEST_CHECK(cond) \
+  do { if (!(cond)) { std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " << #cond << std::endl; test_failures++; } } while (0)
+
+//! Check that two numbers agree within a relative (or, for small numbers, absolute) tolerance 
+#define TEST_CLOSE(a, b, tol) \
+  do { double _a = (a), _b = (b); if (std::fabs(_a - _b) > (tol)*std::max(1.0, std::fabs(_b))) \
+    { std::cerr << __FILE__ << ":" << __LINE__ << ": " << #a << " = " << _a << " differs from " << #b << " = " << _b << std::endl; test_failures++; } } while (0)
+
+//! Particle data used to write test configurations
+struct TestParticle
+{
+  int type;         //!< particle type
+  double x, y, z;   //!< position
+};
+
+/*! Write particles into a file in the format read by System
+ *  \param name file name
+ *  \param particles list of particles
+**/
+inline void write_particles(const string& name, const vector<TestParticle>& particles)
+{
+  ofstream out(name.c_str());
+  out << "keys: id type radius x y z" << endl;
+  for (unsigned int i = 0; i < particles.size(); i++)
+    out << i << " " << particles[i].type << " 1.0 " << particles[i].x << " " << particles[i].y << " " << particles[i].z << endl;
+}
+
+/*! Create a system in a cubic box from a list of particles. Messages go to name.log.
+ *  \param name base name of the test (used for file names)
+ *  \param particles list of particles
+ *  \param L box size
+ *  \param msg created Messenger object
+**/
+inline SystemPtr make_system(const string& name, const vector<TestParticle>& particles, double L, MessengerPtr& msg)
+{
+  msg = std::make_shared<Messenger>(name+".log");
+  write_particles(name+".dat", particles);
+  BoxPtr box = std::make_shared<Box>(Box(L,L,L));
+  return std::make_shared<System>(name+".dat", msg, box);
+}
+
+/*! Create a tissue of particles on a hexagonal patch of the triangular lattice with unit spacing and 
+ *  build its mesh from the lattice bonds (this does not require CGAL). Particles are randomly displaced 
+ *  and the mesh is then equiangulated, i.e. it is a Delaunay triangulation of the displaced particles.
+ *  \param name base name of the test (used for file names)
+ *  \param n number of lattice rings around the central particle (system has 3n(n+1)+1 particles)
+ *  \param jitter maximum displacement of each particle in each direction
+ *  \param ntypes particle types are assigned as 1, 2, ..., ntypes, 1, 2, ...
+ *  \param msg created Messenger object
+**/
+inline SystemPtr make_lattice_tissue(const string& name, int n, double jitter, int ntypes, MessengerPtr& msg)
+{
+  std::mt19937 rng(12345);
+  vector<TestParticle> particles;
+  vector<vector<int> > index(2*n+1, vector<int>(2*n+1, -1));
+  for (int a = -n; a <= n; a++)
+    for (int b = -n; b <= n; b++)
+      if (std::abs(a + b) <= n)
+      {
+        double dx = jitter*(2.0*rng()/rng.max() - 1.0);
+        double dy = jitter*(2.0*rng()/rng.max() - 1.0);
+        TestParticle p = {1 + static_cast<int>(particles.size()) % ntypes, a + 0.5*b + dx, 0.5*sqrt(3.0)*b + dy, 0.0};
+        index[a+n][b+n] = particles.size();
+        particles.push_back(p);
+      }
+  SystemPtr sys = make_system(name, particles, 4.0*n + 10.0, msg);
+  for (int i = 0; i < sys->size(); i++)
+  {
+    Particle& p = sys->get_particle(i);
+    p.Nx = 0.0;  p.Ny = 0.0;  p.Nz = 1.0;
+    p.in_tissue = true;
+    p.boundary = false;
+  }
+  
+  Mesh& mesh = sys->get_mesh();
+  mesh.reset();
+  for (int i = 0; i < sys->size(); i++)
+    mesh.add_vertex(sys->get_particle(i));
+  const int da[6] = {1, 0, -1, -1, 0, 1}, db[6] = {0, 1, 1, 0, -1, -1};
+  for (int a = -n; a <= n; a++)
+    for (int b = -n; b <= n; b++)
+      if (index[a+n][b+n] >= 0)
+        for (int d = 0; d < 6; d++)
+        {
+          int an = a + da[d], bn = b + db[d];
+          if (std::abs(an) <= n && std::abs(bn) <= n && index[an+n][bn+n] >= 0)
+            mesh.add_edge(index[a+n][b+n], index[an+n][bn+n]);
+        }
+  mesh.generate_faces();
+  mesh.generate_dual_mesh();
+  mesh.postprocess(true);
+  sys->update_mesh();
+  for (int i = 0; i < sys->size(); i++)
+    sys->get_particle(i).boundary = mesh.get_vertices()[i].boundary;
+  return sys;
+}
+
+//! Print summary and return exit code of the test program
+inline int test_result(const string& name)
+{
+  if (test_failures > 0)
+  {
+    std::cerr << name << ": " << test_failures << " check(s) failed." << std::endl;
+    return 1;
+  }
+  std::cout << name << ": all checks passed." << std::endl;
+  return 0;
+}
+
+#endif
@@ -0,0 +1,172 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+
+/*!
+ * \file test_ewald.cpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Checks PME forces against finite differences of the energy and the PME energy against a direct Ewald sum
+ */ 
+
+#include "test_common.hpp"
+#include "neighbour_list.hpp"
+#include "value.hpp"
+#include "pair_ewald_potential.hpp"
+
+//! Total energy for the current particle positions
+static double total_energy(SystemPtr sys, PairPotentialPtr pot)
+{
+  sys->reset_forces();
+  pot->compute(1.0);
+  return pot->get_potential_energy();
+}
+
+/*! Direct Ewald sum (tin-foil boundary conditions) with its own splitting parameter, converged 
+ *  in both the real and reciprocal space, plus the repulsive core between minimum image pairs within rcut.
+ *  \param sys system
+ *  \param q charge of each particle 
+ *  \param alpha potential strength
+ *  \param sigma core diameter
+ *  \param rcut real space cutoff of the PME potential (applies to the core only)
+**/
+static double direct_ewald(SystemPtr sys, const vector<double>& q, double alpha, double sigma, double rcut)
+{
+  const double beta = 1.0;
+  const int n_img = 1, k_max = 14;
+  BoxPtr box = sys->get_box();
+  double L = box->Lx, V = L*L*L;
+  int N = sys->size();
+  double e_real = 0.0, e_rec = 0.0, e_self = 0.0, e_core = 0.0;
+  for (int i = 0; i < N; i++)
+  {
+    Particle& pi = sys->get_particle(i);
+    e_self -= beta/sqrt(M_PI)*q[i]*q[i];
+    for (int j = 0; j < N; j++)
+    {
+      Particle& pj = sys->get_particle(j);
+      for (int nx = -n_img; nx <= n_img; nx++)
+        for (int ny = -n_img; ny <= n_img; ny++)
+          for (int nz = -n_img; nz <= n_img; nz++)
+          {
+            if (i == j && nx == 0 && ny == 0 && nz == 0) continue;
+            double dx = pi.x - pj.x + nx*L, dy = pi.y - pj.y + ny*L, dz = pi.z - pj.z + nz*L;
+            double r = sqrt(dx*dx + dy*dy + dz*dz);
+            e_real += 0.5*q[i]*q[j]*erfc(beta*r)/r;
+          }
+      if (j > i)
+      {
+        double dx = pi.x - pj.x, dy = pi.y - pj.y, dz = pi.z - pj.z;
+        sys->apply_periodic(dx,dy,dz);
+        double r = sqrt(dx*dx + dy*dy + dz*dz);
+        if (r <= rcut)
+          e_core += 4.0*fabs(alpha*q[i]*q[j])*pow(sigma/r,12);
+      }
+    }
+  }
+  for (int kx = -k_max; kx <= k_max; kx++)
+    for (int ky = -k_max; ky <= k_max; ky++)
+      for (int kz = -k_max; kz <= k_max; kz++)
+      {
+        if (kx == 0 && ky == 0 && kz == 0) continue;
+        double mx = kx/L, my = ky/L, mz = kz/L;
+        double m_sq = mx*mx + my*my + mz*mz;
+        double s_re = 0.0, s_im = 0.0;
+        for (int i = 0; i < N; i++)
+        {
+          Particle& p = sys->get_particle(i);
+          double arg = 2.0*M_PI*(mx*p.x + my*p.y + mz*p.z);
+          s_re += q[i]*cos(arg);
+          s_im += q[i]*sin(arg);
+        }
+        e_rec += exp(-M_PI*M_PI*m_sq/(beta*beta))/m_sq*(s_re*s_re + s_im*s_im);
+      }
+  e_rec /= 2.0*M_PI*V;
+  return alpha*(e_real + e_rec + e_self) + e_core;
+}
+
+int main()
+{
+  const double L = 10.0, alpha = 1.5, sigma = 0.8, rcut = 4.0;
+  vector<TestParticle> particles;
+  // Neutral system of four cations (type 1) and four anions (type 2); the first two are close enough to feel the core 
+  TestParticle pos[8] = {{1,  0.3,  0.2, -0.1}, {2,  1.2,  0.4,  0.2}, 
+                         {1, -3.1,  2.2,  1.7}, {2,  2.8, -3.3,  0.9},
+                         {1,  4.1,  3.6, -2.4}, {2, -1.7, -2.9, -3.8},
+                         {1, -4.4,  0.7,  3.9}, {2,  1.9,  4.5, -4.6}};
+  for (int i = 0; i < 8; i++)
+    particles.push_back(pos[i]);
+  MessengerPtr msg;
+  SystemPtr sys = make_system("test_ewald", particles, L, msg);
+  sys->set_periodic(true);
+  pairs_type nlist_param;
+  NeighbourListPtr nlist = std::make_shared<NeighbourList>(NeighbourList(sys, msg, rcut + 0.3, 0.3, nlist_param));
+  pairs_type val_param;
+  ValuePtr val = std::make_shared<ValueConstant>(msg, val_param);
+  
+  pairs_type param;
+  param["alpha"] = lexical_cast<string>(alpha);
+  param["sigma"] = lexical_cast<string>(sigma);
+  param["rcut"] = lexical_cast<string>(rcut);
+  param["tolerance"] = "1e-6";
+  param["order"] = "6";
+  PairEwaldPotentialPtr ewald = std::make_shared<PairEwaldPotential>(sys, msg, nlist, val, param);
+  pairs_type type_param;
+  type_param["type"] = "2";
+  type_param["q"] = "-1.0";
+  ewald->set_type_parameters(type_param);
+  vector<double> q;
+  for (int i = 0; i < sys->size(); i++)
+    q.push_back((sys->get_particle(i).get_type() == 1) ? 1.0 : -1.0);
+  
+  // Total energy agrees with the direct Ewald sum
+  double energy = total_energy(sys, ewald);
+  double energy_direct = direct_ewald(sys, q, alpha, sigma, rcut);
+  TEST_CLOSE(energy, energy_direct, 1e-4);
+  
+  // Forces are minus the gradient of the energy 
+  vector<double> fx(sys->size()), fy(sys->size()), fz(sys->size());
+  for (int i = 0; i < sys->size(); i++)
+  {
+    Particle& p = sys->get_particle(i);
+    fx[i] = p.fx;  fy[i] = p.fy;  fz[i] = p.fz;
+  }
+  const double h = 1e-5;
+  for (int i = 0; i < sys->size(); i++)
+  {
+    Particle& p = sys->get_particle(i);
+    double* coord[3] = {&p.x, &p.y, &p.z};
+    double f[3] = {fx[i], fy[i], fz[i]};
+    for (int d = 0; d < 3; d++)
+    {
+      double c = *coord[d];
+      *coord[d] = c + h;
+      double e_p = total_energy(sys, ewald);
+      *coord[d] = c - h;
+      double e_m = total_energy(sys, ewald);
+      *coord[d] = c;
+      TEST_CLOSE(f[d], -(e_p - e_m)/(2.0*h), 1e-5);
+    }
+  }
+  
+  return test_result("test_ewald");
+}
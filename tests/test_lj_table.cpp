@@ -0,0 +1,104 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+
+/*!
+ * \file test_lj_table.cpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Checks that direct and tabulated Lennard-Jones forces agree and are consistent with their energies for sigma != 1
+ */ 
+
+#include "test_common.hpp"
+#include "neighbour_list.hpp"
+#include "value.hpp"
+#include "pair_lj_potential.hpp"
+#include "pair_table_potential.hpp"
+
+//! Total energy and x component of the force on the first particle for two particles at distance r along x
+static void pair_energy_force(SystemPtr sys, PairPotentialPtr pot, double r, double& energy, double& fx)
+{
+  sys->get_particle(0).x = 0.0;
+  sys->get_particle(1).x = r;
+  sys->reset_forces();
+  pot->compute(1.0);
+  energy = pot->get_potential_energy();
+  fx = sys->get_particle(0).fx;
+}
+
+int main()
+{
+  const double eps = 1.3, sigma = 1.7, rcut = 2.5*sigma;
+  vector<TestParticle> particles;
+  TestParticle p0 = {1, 0.0, 0.0, 0.0}, p1 = {1, 1.2*sigma, 0.0, 0.0};
+  particles.push_back(p0);
+  particles.push_back(p1);
+  MessengerPtr msg;
+  SystemPtr sys = make_system("test_lj_table", particles, 30.0, msg);
+  pairs_type nlist_param;
+  NeighbourListPtr nlist = std::make_shared<NeighbourList>(NeighbourList(sys, msg, rcut + 0.2, 0.5, nlist_param));
+  pairs_type val_param;
+  ValuePtr val = std::make_shared<ValueConstant>(msg, val_param);
+  
+  pairs_type lj_param;
+  lj_param["epsilon"] = lexical_cast<string>(eps);
+  lj_param["sigma"] = lexical_cast<string>(sigma);
+  lj_param["rcut"] = lexical_cast<string>(rcut);
+  PairLJPotentialPtr lj = std::make_shared<PairLJPotential>(sys, msg, nlist, val, lj_param);
+  
+  pairs_type table_param = lj_param;
+  table_param["source"] = "lj";
+  table_param["points"] = "4000";
+  table_param["rmin"] = lexical_cast<string>(0.8*sigma);
+  PairPotentialPtr table = std::make_shared<PairTablePotential>(sys, msg, nlist, val, table_param);
+  
+  const double h = 1e-6;
+  for (double r = 0.9*sigma; r < 0.99*rcut; r += 0.05*sigma)
+  {
+    // evaluate_pair returns -dU/dr/r, which is what the table is built from
+    double u, ff, u_p, ff_p, u_m, ff_m;
+    TEST_CHECK(lj->evaluate_pair(1, 1, r, u, ff));
+    lj->evaluate_pair(1, 1, r + h, u_p, ff_p);
+    lj->evaluate_pair(1, 1, r - h, u_m, ff_m);
+    TEST_CLOSE(ff*r, -(u_p - u_m)/(2.0*h), 1e-6);
+    
+    // Tabulated force on the first particle is -dE/dx_0 = dE/dr
+    double e, fx, e_p, fx_p, e_m, fx_m;
+    pair_energy_force(sys, table, r, e, fx);
+    pair_energy_force(sys, table, r + h, e_p, fx_p);
+    pair_energy_force(sys, table, r - h, e_m, fx_m);
+    TEST_CLOSE(fx, (e_p - e_m)/(2.0*h), 1e-5);
+    // and it agrees with the analytic potential and force
+    TEST_CLOSE(e, u, 1e-6);
+    TEST_CLOSE(fx, -ff*r, 1e-5);
+    
+    // Direct LJ compute gives the same energy and force as evaluate_pair (and therefore the table)
+    pair_energy_force(sys, lj, r, e, fx);
+    pair_energy_force(sys, lj, r + h, e_p, fx_p);
+    pair_energy_force(sys, lj, r - h, e_m, fx_m);
+    TEST_CLOSE(fx, (e_p - e_m)/(2.0*h), 1e-5);
+    TEST_CLOSE(e, u, 1e-12);
+    TEST_CLOSE(fx, -ff*r, 1e-12);
+  }
+  
+  return test_result("test_lj_table");
+}
@@ -0,0 +1,251 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved.
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+
+/*!
+ * \file test_mesh_insert.cpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Checks local insertion of vertices into the mesh (as done after cell division)
+ */
+
+#include "test_common.hpp"
+
+//! Signed area of a triangular face with respect to the vertex normal (positive if counterclockwise)
+static double signed_area(Mesh& mesh, Face& face)
+{
+  vector<Vertex>& V = mesh.get_vertices();
+  Vector3d& r0 = V[face.vertices[0]].r;
+  Vector3d& r1 = V[face.vertices[1]].r;
+  Vector3d& r2 = V[face.vertices[2]].r;
+  return 0.5*dot(cross(r1-r0,r2-r0),V[face.vertices[0]].N);
+}
+
+//! Angle at vertex v in a triangular face
+static double face_angle(Mesh& mesh, Face& face, int v)
+{
+  vector<Vertex>& V = mesh.get_vertices();
+  int i = (face.vertices[0] == v) ? 0 : ((face.vertices[1] == v) ? 1 : 2);
+  Vector3d& r = V[face.vertices[i]].r;
+  Vector3d e1 = (V[face.vertices[(i+1)%3]].r - r).unit();
+  Vector3d e2 = (V[face.vertices[(i+2)%3]].r - r).unit();
+  return acos(std::max(-1.0, std::min(1.0, dot(e1,e2))));
+}
+
+/*! Check that the mesh is a consistent Delaunay triangulation with a single boundary.
+ *  \param mesh mesh to check
+ *  \param area expected total area of all triangles
+**/
+static void check_mesh(Mesh& mesh, double area)
+{
+  vector<Face>& faces = mesh.get_faces();
+  vector<Edge>& edges = mesh.get_edges();
+  // Euler characteristic of a disk: outer boundary counts as a face and each edge is stored as two half-edges
+  int n_holes = 0;
+  for (int f = 0; f < mesh.nfaces(); f++)
+    if (faces[f].is_hole) n_holes++;
+  TEST_CHECK(n_holes == 1);
+  TEST_CHECK(mesh.size() - mesh.nedges()/2 + mesh.nfaces() == 2);
+  // No triangle is inverted and triangles cover the same area
+  double total = 0.0;
+  int n_inverted = 0;
+  for (int f = 0; f < mesh.nfaces(); f++)
+  {
+    if (faces[f].is_hole) continue;
+    TEST_CHECK(faces[f].n_sides == 3);
+    double a = signed_area(mesh, faces[f]);
+    if (a <= 0.0) n_inverted++;
+    total += a;
+  }
+  TEST_CHECK(n_inverted == 0);
+  TEST_CLOSE(total, area, 1e-10);
+  // Sum of the angles opposite to each internal edge does not exceed pi
+  int n_violations = 0;
+  for (int e = 0; e < mesh.nedges(); e++)
+  {
+    Edge& E = edges[e];
+    Edge& Ep = edges[E.pair];
+    TEST_CHECK(Ep.pair == e && Ep.from == E.to && Ep.to == E.from);
+    if (E.boundary || Ep.boundary || e > E.pair) continue;
+    double angle_sum = face_angle(mesh, faces[E.face], mesh.opposite_vertex(E.id)) + face_angle(mesh, faces[Ep.face], mesh.opposite_vertex(Ep.id));
+    if (angle_sum > M_PI + 1e-10) n_violations++;
+  }
+  TEST_CHECK(n_violations == 0);
+}
+
+/*! Rebuild mesh from scratch using the same edges and check that dual cells
+ *  (areas, perimeters and face centres around each vertex) match the incrementally updated ones.
+**/
+static void check_duals(SystemPtr sys)
+{
+  Mesh& mesh = sys->get_mesh();
+  Mesh fresh;
+  for (int i = 0; i < sys->size(); i++)
+    fresh.add_vertex(sys->get_particle(i));
+  vector<Edge>& edges = mesh.get_edges();
+  for (int e = 0; e < mesh.nedges(); e++)
+    fresh.add_edge(edges[e].from, edges[e].to);
+  fresh.generate_faces();
+  fresh.generate_dual_mesh();
+  fresh.postprocess(true);
+  fresh.update_dual_mesh();
+  fresh.update_dual_cells();
+
+  TEST_CHECK(fresh.size() == mesh.size());
+  TEST_CHECK(fresh.nfaces() == mesh.nfaces());
+  for (int v = 0; v < mesh.size(); v++)
+  {
+    Vertex& V = mesh.get_vertices()[v];
+    Vertex& Vf = fresh.get_vertices()[v];
+    TEST_CHECK(V.boundary == Vf.boundary);
+    TEST_CHECK(V.n_faces == Vf.n_faces);
+    if (V.boundary || V.n_faces != Vf.n_faces) continue;
+    TEST_CLOSE(V.area, Vf.area, 1e-10);
+    TEST_CLOSE(V.perim, Vf.perim, 1e-10);
+    vector<pair<double,double> > rc, rc_fresh;
+    for (unsigned int f = 0; f < V.dual.size(); f++)
+    {
+      Vector3d& r = mesh.get_faces()[V.dual[f]].rc;
+      rc.push_back(make_pair(r.x, r.y));
+    }
+    for (unsigned int f = 0; f < Vf.dual.size(); f++)
+    {
+      Vector3d& r = fresh.get_faces()[Vf.dual[f]].rc;
+      rc_fresh.push_back(make_pair(r.x, r.y));
+    }
+    std::sort(rc.begin(), rc.end());
+    std::sort(rc_fresh.begin(), rc_fresh.end());
+    TEST_CHECK(rc.size() == rc_fresh.size());
+    for (unsigned int f = 0; f < std::min(rc.size(), rc_fresh.size()); f++)
+    {
+      TEST_CLOSE(rc[f].first, rc_fresh[f].first, 1e-10);
+      TEST_CLOSE(rc[f].second, rc_fresh[f].second, 1e-10);
+    }
+  }
+}
+
+//! Returns true if the vertex and all its neighbours are internal
+static bool deep_inside(Mesh& mesh, int v)
+{
+  Vertex& V = mesh.get_vertices()[v];
+  if (V.boundary) return false;
+  for (int j = 0; j < V.n_edges; j++)
+    if (mesh.get_vertices()[V.neigh[j]].boundary) return false;
+  return true;
+}
+
+//! Create daughter particle at a given position (same as in PopulationCell::divide)
+static Particle make_daughter(SystemPtr sys, Particle& p, const Vector3d& r)
+{
+  Particle p_new(sys->size(), p.get_type(), p.get_radius());
+  p_new.x = r.x;  p_new.y = r.y;  p_new.z = r.z;
+  p_new.Nx = p.Nx;  p_new.Ny = p.Ny;  p_new.Nz = p.Nz;
+  p_new.in_tissue = true;
+  p_new.boundary = false;
+  for (list<string>::iterator it_g = p.groups.begin(); it_g != p.groups.end(); it_g++)
+    p_new.add_group(*it_g);
+  return p_new;
+}
+
+int main()
+{
+  MessengerPtr msg;
+  SystemPtr sys = make_lattice_tissue("test_mesh_insert", 13, 0.1, 1, msg);
+  Mesh& mesh = sys->get_mesh();
+  double area = 0.0;
+  for (int f = 0; f < mesh.nfaces(); f++)
+    if (!mesh.get_faces()[f].is_hole)
+      area += signed_area(mesh, mesh.get_faces()[f]);
+  check_mesh(mesh, area);
+
+  // Divide randomly chosen internal cells in batches; Delaunay property is restored after each batch
+  std::mt19937 rng(2016);
+  const int n_batch = 13, n_div = 20;
+  for (int batch = 0; batch < n_batch; batch++)
+  {
+    for (int k = 0; k < n_div; k++)
+    {
+      int v;
+      do
+        v = rng() % mesh.size();
+      while (!deep_inside(mesh, v));
+      Vertex& V = mesh.get_vertices()[v];
+      double min_len = 1e10;
+      for (int j = 0; j < V.n_edges; j++)
+        min_len = std::min(min_len, (mesh.get_vertices()[V.neigh[j]].r - V.r).len());
+      double phi = 2.0*M_PI*rng()/rng.max();
+      Vector3d n(cos(phi), sin(phi), 0.0);
+      Vector3d r_daughter = V.r + 0.1*min_len*n;
+      Vector3d r_mother = V.r - 0.1*min_len*n;
+
+      int f = mesh.find_face(v, r_daughter);
+      TEST_CHECK(f >= 0);
+      if (f < 0) continue;
+      TEST_CHECK(mesh.get_faces()[f].has_vertex(v));
+      Particle p_new = make_daughter(sys, sys->get_particle(v), r_daughter);
+      sys->add_particle(p_new);
+      TEST_CHECK(sys->get_force_mesh_rebuild());
+      TEST_CHECK(mesh.insert_vertex(sys->get_particle(p_new.get_id()), f));
+      TEST_CHECK(mesh.size() == sys->size());
+      TEST_CHECK(mesh.keeps_orientation(v, r_mother));
+      Particle& pm = sys->get_particle(v);
+      pm.x = r_mother.x;  pm.y = r_mother.y;  pm.z = r_mother.z;
+      mesh.update(pm);
+    }
+    sys->set_force_mesh_rebuild(false);
+    sys->update_mesh();
+    check_mesh(mesh, area);
+  }
+  TEST_CHECK(sys->size() == 547 + n_batch*n_div);
+  check_duals(sys);
+
+  // Fallback: daughter outside of the mother's star cannot be inserted and mesh is left unchanged;
+  // adding the particle flags the mesh for the full rebuild
+  int v = 0;
+  while (!deep_inside(mesh, v)) v++;
+  Vertex& V = mesh.get_vertices()[v];
+  double max_len = 0.0;
+  for (int j = 0; j < V.n_edges; j++)
+    max_len = std::max(max_len, (mesh.get_vertices()[V.neigh[j]].r - V.r).len());
+  Vector3d r_out = V.r + Vector3d(2.0*max_len, 0.0, 0.0);
+  int f_out = mesh.find_face(v, r_out);
+  TEST_CHECK(f_out == -1);
+  int n_vert = mesh.size(), n_face = mesh.nfaces(), n_edge = mesh.nedges();
+  Particle p_out = make_daughter(sys, sys->get_particle(v), r_out);
+  sys->add_particle(p_out);
+  TEST_CHECK(sys->get_force_mesh_rebuild());
+  TEST_CHECK(!mesh.insert_vertex(sys->get_particle(p_out.get_id()), f_out));
+  TEST_CHECK(mesh.size() == n_vert && mesh.nfaces() == n_face && mesh.nedges() == n_edge);
+  TEST_CHECK(mesh.size() != sys->size());
+
+  // Holes cannot be split, and particle id has to match the next vertex
+  int hole = 0;
+  while (!mesh.get_faces()[hole].is_hole) hole++;
+  TEST_CHECK(!mesh.insert_vertex(sys->get_particle(p_out.get_id()), hole));
+
+  // Mother cannot be moved across its star
+  Vector3d r_nb = mesh.get_vertices()[V.neigh[0]].r;
+  TEST_CHECK(!mesh.keeps_orientation(v, V.r + 1.5*(r_nb - V.r)));
+  TEST_CHECK(mesh.keeps_orientation(v, V.r + 0.1*(r_nb - V.r)));
+
+  return test_result("test_mesh_insert");
+}
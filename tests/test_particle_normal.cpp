@@ -0,0 +1,94 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+
+/*!
+ * \file test_particle_normal.cpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Checks validity tracking of the constraint normal stored with each particle
+ * \note This test is compiled with the Release flags (including -ffast-math), see CMakeLists.txt
+ */ 
+
+#include "test_common.hpp"
+#include "constraint_sphere.hpp"
+
+int main()
+{
+  // A particle that has never had its normal computed must not report a valid normal,
+  // not even at the origin where the stored position coincides with the current one
+  Particle q(0, 1, 1.0);
+  q.x = 0.0;  q.y = 0.0;  q.z = 0.0;
+  TEST_CHECK(!q.normal_valid());
+  q.set_normal(0.0, 0.0, 1.0);
+  TEST_CHECK(q.normal_valid());
+  q.z = 1e-12;
+  TEST_CHECK(!q.normal_valid());
+  q.z = 0.0;
+  TEST_CHECK(q.normal_valid());
+  q.invalidate_normal();
+  TEST_CHECK(!q.normal_valid());
+  
+  const double R = 2.0;
+  vector<TestParticle> particles;
+  TestParticle p0 = {1, R, 0.0, 0.0}, p1 = {1, 0.0, 0.0, R};
+  particles.push_back(p0);
+  particles.push_back(p1);
+  MessengerPtr msg;
+  SystemPtr sys = make_system("test_particle_normal", particles, 30.0, msg);
+  pairs_type param;
+  param["r"] = lexical_cast<string>(R);
+  ConstraintSphere sphere(sys, msg, param);
+  
+  double Nx, Ny, Nz;
+  Particle& p = sys->get_particle(0);
+  TEST_CHECK(!p.normal_valid());
+  sphere.get_normal(p, Nx, Ny, Nz);
+  TEST_CHECK(p.normal_valid());
+  TEST_CLOSE(Nx, 1.0, 1e-12);
+  TEST_CLOSE(Ny, 0.0, 1e-12);
+  TEST_CLOSE(Nz, 0.0, 1e-12);
+  
+  // Moving the particle must lead to a recomputed normal
+  p.x = 0.0;  p.y = R;
+  TEST_CHECK(!p.normal_valid());
+  sphere.get_normal(p, Nx, Ny, Nz);
+  TEST_CLOSE(Nx, 0.0, 1e-12);
+  TEST_CLOSE(Ny, 1.0, 1e-12);
+  TEST_CLOSE(p.Ny, 1.0, 1e-12);
+  
+  // Stale stored normal is not used after explicit invalidation
+  p.Nx = 5.0;  p.Ny = 5.0;  p.Nz = 5.0;
+  p.invalidate_normal();
+  sphere.get_normal(p, Nx, Ny, Nz);
+  TEST_CLOSE(Ny, 1.0, 1e-12);
+  
+  // Enforcing the constraint stores a normal that is valid at the projected position
+  Particle& s = sys->get_particle(1);
+  s.x = 0.1;  s.y = 0.0;  s.z = 1.5*R;
+  sphere.enforce(s);
+  TEST_CLOSE(sqrt(s.x*s.x + s.y*s.y + s.z*s.z), R, 1e-8);
+  TEST_CHECK(s.normal_valid());
+  TEST_CLOSE(s.Nz, s.z/R, 1e-8);
+  
+  return test_result("test_particle_normal");
+}
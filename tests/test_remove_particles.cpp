@@ -0,0 +1,134 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+
+/*!
+ * \file test_remove_particles.cpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Checks that bonds and angles stay consistent after particles are removed from a bonded system
+ */ 
+
+#include "test_common.hpp"
+
+//! Check that every bond and angle is listed by all of its particles and that particles list only existing bonds and angles
+static void check_topology(SystemPtr sys)
+{
+  for (int b = 0; b < sys->num_bonds(); b++)
+  {
+    Bond& bond = sys->get_bond(b);
+    TEST_CHECK(bond.id == b);
+    TEST_CHECK(bond.i >= 0 && bond.i < sys->size() && bond.j >= 0 && bond.j < sys->size());
+    vector<int>& bi = sys->get_particle(bond.i).bonds;
+    vector<int>& bj = sys->get_particle(bond.j).bonds;
+    TEST_CHECK(std::count(bi.begin(), bi.end(), b) == 1);
+    TEST_CHECK(std::count(bj.begin(), bj.end(), b) == 1);
+  }
+  for (int a = 0; a < sys->num_angles(); a++)
+  {
+    Angle& angle = sys->get_angle(a);
+    TEST_CHECK(angle.id == a);
+    int ids[3] = {angle.i, angle.j, angle.k};
+    for (int l = 0; l < 3; l++)
+    {
+      TEST_CHECK(ids[l] >= 0 && ids[l] < sys->size());
+      vector<int>& al = sys->get_particle(ids[l]).angles;
+      TEST_CHECK(std::count(al.begin(), al.end(), a) == 1);
+    }
+  }
+  for (int i = 0; i < sys->size(); i++)
+  {
+    Particle& p = sys->get_particle(i);
+    TEST_CHECK(p.get_id() == i);
+    for (unsigned int l = 0; l < p.bonds.size(); l++)
+    {
+      TEST_CHECK(p.bonds[l] >= 0 && p.bonds[l] < sys->num_bonds());
+      if (p.bonds[l] < 0 || p.bonds[l] >= sys->num_bonds()) continue;
+      Bond& bond = sys->get_bond(p.bonds[l]);
+      TEST_CHECK(bond.i == i || bond.j == i);
+    }
+    for (unsigned int l = 0; l < p.angles.size(); l++)
+    {
+      TEST_CHECK(p.angles[l] >= 0 && p.angles[l] < sys->num_angles());
+      if (p.angles[l] < 0 || p.angles[l] >= sys->num_angles()) continue;
+      Angle& angle = sys->get_angle(p.angles[l]);
+      TEST_CHECK(angle.i == i || angle.j == i || angle.k == i);
+    }
+  }
+}
+
+int main()
+{
+  // Two straight filaments of 6 particles each along the x axis
+  const int n_fil = 2, n_mon = 6;
+  vector<TestParticle> particles;
+  for (int f = 0; f < n_fil; f++)
+    for (int m = 0; m < n_mon; m++)
+    {
+      TestParticle p = {1, -3.0 + m, -2.0 + 4.0*f, 0.0};
+      particles.push_back(p);
+    }
+  MessengerPtr msg;
+  SystemPtr sys = make_system("test_remove_particles", particles, 20.0, msg);
+  
+  ofstream bonds("test_remove_particles.bonds");
+  ofstream angles("test_remove_particles.angles");
+  int nb = 0, na = 0;
+  for (int f = 0; f < n_fil; f++)
+  {
+    for (int m = 0; m < n_mon - 1; m++)
+      bonds << nb++ << " 1 " << f*n_mon + m << " " << f*n_mon + m + 1 << endl;
+    for (int m = 0; m < n_mon - 2; m++)
+      angles << na++ << " 1 " << f*n_mon + m << " " << f*n_mon + m + 1 << " " << f*n_mon + m + 2 << endl;
+  }
+  bonds.close();
+  angles.close();
+  sys->read_bonds("test_remove_particles.bonds");
+  sys->read_angles("test_remove_particles.angles");
+  check_topology(sys);
+  
+  // Remove an inner monomer of the first filament and the last monomer of the second one
+  vector<int> to_remove;
+  to_remove.push_back(2*n_mon - 1);
+  to_remove.push_back(2);
+  vector<int> new_id = sys->remove_particles(to_remove);
+  TEST_CHECK(new_id[2] == -1 && new_id[2*n_mon-1] == -1);
+  TEST_CHECK(sys->size() == n_fil*n_mon - 2);
+  // First filament loses two bonds and three angles, the second one a single bond and a single angle
+  TEST_CHECK(sys->num_bonds() == n_fil*(n_mon - 1) - 3);
+  TEST_CHECK(sys->num_angles() == n_fil*(n_mon - 2) - 4);
+  check_topology(sys);
+  
+  // Tangents are computed from per particle bond lists and have to point along the filament
+  for (int i = 0; i < sys->size(); i++)
+  {
+    Particle& p = sys->get_particle(i);
+    if (p.bonds.size() == 0) continue;
+    double tx, ty, tz;
+    sys->compute_tangent(i, tx, ty, tz);
+    TEST_CLOSE(fabs(tx), 1.0, 1e-12);
+    TEST_CLOSE(ty, 0.0, 1e-12);
+    TEST_CLOSE(tz, 0.0, 1e-12);
+  }
+  
+  return test_result("test_remove_particles");
+}
@@ -0,0 +1,141 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved. 
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+
+/*!
+ * \file test_tree_code.cpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Checks tree code Coulomb forces against finite differences of the energy and against the exact direct sum
+ */ 
+
+#include <random>
+
+#include "test_common.hpp"
+#include "neighbour_list.hpp"
+#include "value.hpp"
+#include "pair_tree_potential.hpp"
+
+//! Create tree code potential with given opening angle and leaf size (charges +1 for type 1 and -1 for type 2)
+static PairPotentialPtr make_tree(SystemPtr sys, MessengerPtr msg, NeighbourListPtr nlist, ValuePtr val, double theta, int leaf_size)
+{
+  pairs_type param;
+  param["alpha"] = "1.0";
+  param["kappa"] = "0.3";
+  param["sigma"] = "1.0";
+  param["theta"] = lexical_cast<string>(theta);
+  param["leaf_size"] = lexical_cast<string>(leaf_size);
+  PairPotentialPtr tree = std::make_shared<PairTreePotential>(sys, msg, nlist, val, param);
+  pairs_type type_param;
+  type_param["type"] = "1";  type_param["q"] = "1.0";
+  tree->set_type_parameters(type_param);
+  type_param["type"] = "2";  type_param["q"] = "-1.0";
+  tree->set_type_parameters(type_param);
+  return tree;
+}
+
+//! Compute forces and return the total potential energy
+static double compute(SystemPtr sys, PairPotentialPtr pot, vector<double>& f)
+{
+  sys->reset_forces();
+  pot->compute(1.0);
+  f.resize(3*sys->size());
+  for (int i = 0; i < sys->size(); i++)
+  {
+    Particle& p = sys->get_particle(i);
+    f[3*i] = p.fx;  f[3*i+1] = p.fy;  f[3*i+2] = p.fz;
+  }
+  return pot->get_potential_energy();
+}
+
+int main()
+{
+  // Random non-overlapping configuration of positive and negative charges, including some close pairs
+  const int N = 60;
+  const double L = 8.0, d_min = 0.95;
+  std::mt19937 gen(2016);
+  std::uniform_real_distribution<double> uni(-0.5*L, 0.5*L);
+  vector<TestParticle> particles;
+  while (static_cast<int>(particles.size()) < N)
+  {
+    TestParticle p = {1 + static_cast<int>(particles.size()) % 2, uni(gen), uni(gen), uni(gen)};
+    bool overlap = false;
+    for (unsigned int j = 0; j < particles.size() && !overlap; j++)
+    {
+      double dx = p.x - particles[j].x, dy = p.y - particles[j].y, dz = p.z - particles[j].z;
+      overlap = (dx*dx + dy*dy + dz*dz < d_min*d_min);
+    }
+    if (!overlap) particles.push_back(p);
+  }
+  MessengerPtr msg;
+  SystemPtr sys = make_system("test_tree_code", particles, 4.0*L, msg);
+  pairs_type nlist_param;
+  NeighbourListPtr nlist = std::make_shared<NeighbourList>(NeighbourList(sys, msg, 1.5, 0.5, nlist_param));
+  pairs_type val_param;
+  ValuePtr val = std::make_shared<ValueConstant>(msg, val_param);
+  
+  // With theta = 0 all interactions are summed directly and forces are exact derivatives of the energy
+  PairPotentialPtr exact = make_tree(sys, msg, nlist, val, 0.0, 4);
+  vector<double> f_exact;
+  compute(sys, exact, f_exact);
+  const double h = 1e-6;
+  for (int i = 0; i < N; i += 7)
+  {
+    Particle& p = sys->get_particle(i);
+    double* coord[3] = {&p.x, &p.y, &p.z};
+    for (int a = 0; a < 3; a++)
+    {
+      vector<double> f_tmp;
+      double x0 = *coord[a];
+      *coord[a] = x0 + h;
+      double e_p = compute(sys, exact, f_tmp);
+      *coord[a] = x0 - h;
+      double e_m = compute(sys, exact, f_tmp);
+      *coord[a] = x0;
+      TEST_CLOSE(f_exact[3*i+a], -(e_p - e_m)/(2.0*h), 1e-5);
+    }
+  }
+  compute(sys, exact, f_exact);
+  
+  // Exact forces do not depend on the way particles are partitioned into leaves
+  vector<double> f_part;
+  compute(sys, make_tree(sys, msg, nlist, val, 0.0, 1), f_part);
+  for (int k = 0; k < 3*N; k++)
+    TEST_CLOSE(f_part[k], f_exact[k], 1e-10);
+  
+  // Multipole approximation gives a small relative error for any leaf size; in particular 
+  // the repulsive core of close pairs is always included
+  for (int leaf_size = 1; leaf_size <= 16; leaf_size *= 4)
+  {
+    vector<double> f_tree;
+    compute(sys, make_tree(sys, msg, nlist, val, 0.5, leaf_size), f_tree);
+    double err_sq = 0.0, f_sq = 0.0;
+    for (int k = 0; k < 3*N; k++)
+    {
+      err_sq += (f_tree[k] - f_exact[k])*(f_tree[k] - f_exact[k]);
+      f_sq += f_exact[k]*f_exact[k];
+    }
+    TEST_CHECK(sqrt(err_sq/f_sq) < 1e-2);
+  }
+  
+  return test_result("test_tree_code");
+}
@@ -0,0 +1,227 @@
+/* ***************************************************************************
+ *
+ *  Copyright (C) 2013-2016 University of Dundee
+ *  All rights reserved.
+ *
+ *  This file is part of SAMoS (Soft Active Matter on Surfaces) program.
+ *
+ *  SAMoS is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  SAMoS is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ****************************************************************************/
+
+
+/*!
+ * \file test_vertex_particle.cpp
+ * \author Rastko Sknepnek, sknepnek@gmail.com
+ * \date 18-Oct-2026
+ * \brief Checks forces, energy and stress of the vertex-particle potential against a reference per-vertex loop
+ */
+
+#include "test_common.hpp"
+#include "neighbour_list.hpp"
+#include "value.hpp"
+#include "pair_vertex_particle_potential.hpp"
+
+//! Parameters of the reference implementation (indexed by type-1)
+struct RefParameters
+{
+  vector<double> K, gamma, lambda;   //!< per type parameters
+  vector<vector<double> > lambda_pair;   //!< per pair contractility
+  bool has_pair_params;               //!< if true, use lambda_pair
+};
+
+/*! Contribution of cell k to the force on particle i and energy of cell k.
+ *  This is the loop over the dual of each vertex used before the gather kernel.
+ *  Energy of the cell (returned only for k == i) uses contractility of the dual edge
+ *  that follows the current one, as in the original code.
+**/
+static double cell_term(Mesh& mesh, SystemPtr sys, const RefParameters& par, int i, int k, Vector3d& force)
+{
+  vector<Vertex>& vertices = mesh.get_vertices();
+  vector<Face>& faces = mesh.get_faces();
+  Particle& pk = sys->get_particle(k);
+  Vertex& vk = vertices[k];
+  double K = par.K[vk.type-1], gamma = par.gamma[vk.type-1], lambda = par.lambda[vk.type-1];
+  double dA = vk.area - pk.A0;
+  double area_term = 0.5*K*dA;
+  double perim_term = gamma*vk.perim;
+  double eng = 0.5*(K*dA*dA + gamma*vk.perim*vk.perim);
+  Vector3d Nvec(pk.Nx, pk.Ny, pk.Nz);
+  Vector3d area_vec(0.0,0.0,0.0), perim_vec(0.0,0.0,0.0), con_vec(0.0,0.0,0.0);
+  int n = vk.n_faces;
+  for (int f = 0; f < n; f++)
+  {
+    int f_m = (f == 0) ? n-1 : f-1, f_p = (f == n-1) ? 0 : f+1;
+    Face& f_nu_m = faces[vk.dual[f_m]];
+    Face& f_nu   = faces[vk.dual[f]];
+    Face& f_nu_p = faces[vk.dual[f_p]];
+    Vector3d& r_nu_m = f_nu_m.rc;
+    Vector3d& r_nu   = f_nu.rc;
+    Vector3d& r_nu_p = f_nu_p.rc;
+    bool ok_m = !(f_nu_m.is_hole || f_nu.is_hole), ok_p = !(f_nu_p.is_hole || f_nu.is_hole);
+    if (par.has_pair_params)
+      lambda = par.lambda_pair[vk.type-1][vertices[vk.dual_neighbour_map[f]].type-1];
+    double lambda_f = lambda;
+    if (par.has_pair_params)
+      lambda = par.lambda_pair[vk.type-1][vertices[vk.dual_neighbour_map[f_p]].type-1];
+    if (f_nu.has_vertex(i))
+    {
+      Matrix3d& J = f_nu.get_jacobian(i);
+      if (ok_p) area_vec = area_vec + cross(r_nu_p, Nvec)*J;
+      if (ok_m) area_vec = area_vec - cross(r_nu_m, Nvec)*J;
+      if (ok_m) perim_vec = perim_vec + (r_nu - r_nu_m).unit()*J;
+      if (ok_p) perim_vec = perim_vec - (r_nu_p - r_nu).unit()*J;
+      if (ok_m) con_vec = con_vec + lambda_f*((r_nu - r_nu_m).unit()*J);
+      if (ok_p) con_vec = con_vec - lambda*((r_nu_p - r_nu).unit()*J);
+    }
+    eng += lambda*(r_nu - r_nu_m).len();
+  }
+  force = -area_term*area_vec - perim_term*perim_vec - con_vec;
+  return eng;
+}
+
+/*! Reference force and energy computation. Stress of each internal particle
+ *  is divided by its area once for every neighbour that is an internal tissue particle.
+**/
+static double reference(SystemPtr sys, const RefParameters& par)
+{
+  Mesh& mesh = sys->get_mesh();
+  vector<Vertex>& vertices = mesh.get_vertices();
+  double energy = 0.0;
+  for (int i = 0; i < sys->size(); i++)
+  {
+    Particle& pi = sys->get_particle(i);
+    Vertex& vi = vertices[i];
+    Vector3d force;
+    if (pi.in_tissue && !vi.boundary)
+    {
+      energy += cell_term(mesh, sys, par, i, i, force);
+      pi.fx += force.x;  pi.fy += force.y;  pi.fz += force.z;
+    }
+    for (int j = 0; j < vi.n_edges; j++)
+    {
+      int k = vi.neigh[j];
+      if (!(sys->get_particle(k).in_tissue && !vertices[k].boundary))
+        continue;
+      cell_term(mesh, sys, par, i, k, force);
+      pi.fx += force.x;  pi.fy += force.y;  pi.fz += force.z;
+      if (!vi.boundary && vi.area > 0)
+      {
+        double inv_area = 1.0/vi.area;
+        pi.s_xx *= inv_area;  pi.s_xy *= inv_area;  pi.s_xz *= inv_area;
+        pi.s_yx *= inv_area;  pi.s_yy *= inv_area;  pi.s_yz *= inv_area;
+        pi.s_zx *= inv_area;  pi.s_zy *= inv_area;  pi.s_zz *= inv_area;
+      }
+    }
+  }
+  return energy;
+}
+
+//! Reset forces and set stress of each particle to distinct non-zero values
+static void reset(SystemPtr sys)
+{
+  sys->reset_forces();
+  for (int i = 0; i < sys->size(); i++)
+  {
+    Particle& p = sys->get_particle(i);
+    double s = 1.0 + 0.01*i;
+    p.s_xx = s;      p.s_xy = 2.0*s;  p.s_xz = 3.0*s;
+    p.s_yx = 4.0*s;  p.s_yy = 5.0*s;  p.s_yz = 6.0*s;
+    p.s_zx = 7.0*s;  p.s_zy = 8.0*s;  p.s_zz = 9.0*s;
+  }
+}
+
+//! Compare forces, stresses and energy of the potential with the reference
+static void compare(SystemPtr sys, PairPotentialPtr pot, const RefParameters& par)
+{
+  int N = sys->size();
+  reset(sys);
+  pot->compute(0.01);
+  double energy = pot->get_potential_energy();
+  vector<double> f(3*N), s(9*N);
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = sys->get_particle(i);
+    f[3*i] = p.fx;  f[3*i+1] = p.fy;  f[3*i+2] = p.fz;
+    double si[9] = {p.s_xx, p.s_xy, p.s_xz, p.s_yx, p.s_yy, p.s_yz, p.s_zx, p.s_zy, p.s_zz};
+    for (int a = 0; a < 9; a++) s[9*i+a] = si[a];
+  }
+  reset(sys);
+  double energy_ref = reference(sys, par);
+  TEST_CLOSE(energy, energy_ref, 1e-12);
+  int n_nonzero = 0;
+  for (int i = 0; i < N; i++)
+  {
+    Particle& p = sys->get_particle(i);
+    TEST_CLOSE(f[3*i], p.fx, 1e-10);
+    TEST_CLOSE(f[3*i+1], p.fy, 1e-10);
+    TEST_CLOSE(f[3*i+2], p.fz, 1e-10);
+    if (p.fx != 0.0 || p.fy != 0.0) n_nonzero++;
+    double si[9] = {p.s_xx, p.s_xy, p.s_xz, p.s_yx, p.s_yy, p.s_yz, p.s_zx, p.s_zy, p.s_zz};
+    for (int a = 0; a < 9; a++)
+      TEST_CLOSE(s[9*i+a], si[a], 1e-10);
+  }
+  TEST_CHECK(n_nonzero > N/2);
+}
+
+int main()
+{
+  MessengerPtr msg;
+  SystemPtr sys = make_lattice_tissue("test_vertex_particle", 4, 0.15, 2, msg);
+  for (int i = 0; i < sys->size(); i++)
+    sys->get_particle(i).A0 = 0.7 + 0.01*(i % 7);
+  pairs_type nlist_param;
+  NeighbourListPtr nlist = std::make_shared<NeighbourList>(NeighbourList(sys, msg, 2.0, 0.3, nlist_param));
+  pairs_type val_param;
+  ValuePtr val = std::make_shared<ValueConstant>(msg, val_param);
+
+  pairs_type param;
+  param["K"] = "1.3";
+  param["gamma"] = "0.4";
+  param["lambda"] = "-0.2";
+  param["compute_stress"] = "true";
+  PairVertexParticlePotentialPtr vp = std::make_shared<PairVertexParticlePotential>(sys, msg, nlist, val, param);
+
+  RefParameters par;
+  par.K.assign(2, 1.3);  par.gamma.assign(2, 0.4);  par.lambda.assign(2, -0.2);
+  par.lambda_pair.assign(2, vector<double>(2, -0.2));
+  par.has_pair_params = false;
+  compare(sys, vp, par);
+
+  // Type specific parameters
+  pairs_type type_param;
+  type_param["type"] = "2";
+  type_param["K"] = "0.8";
+  type_param["gamma"] = "0.6";
+  type_param["lambda"] = "0.3";
+  vp->set_type_parameters(type_param);
+  par.K[1] = 0.8;  par.gamma[1] = 0.6;  par.lambda[1] = 0.3;
+  compare(sys, vp, par);
+
+  // Pair specific contractility
+  pairs_type pair_param;
+  pair_param["type_1"] = "1";
+  pair_param["type_2"] = "2";
+  pair_param["lambda"] = "0.5";
+  vp->set_pair_parameters(pair_param);
+  pair_param["type_1"] = "2";
+  pair_param["lambda"] = "-0.1";
+  vp->set_pair_parameters(pair_param);
+  par.lambda_pair[0][1] = par.lambda_pair[1][0] = 0.5;
+  par.lambda_pair[1][1] = -0.1;
+  par.has_pair_params = true;
+  compare(sys, vp, par);
+
+  return test_result("test_vertex_particle");
+}